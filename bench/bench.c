@@ -0,0 +1,179 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include "bench.h"
+
+double bench_now(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+const void* volatile bench_sink;
+
+void bench_consume(const void* p)
+{
+    bench_sink = p;
+}
+
+size_t bench_scaled(const struct bench_Context* ctx, size_t n)
+{
+    double scaled = n * ctx->scale;
+    return scaled < 1 ? 1 : (size_t)scaled;
+}
+
+bool bench_enabled(const struct bench_Context* ctx, const char* suite, const char* benchmark, const char* variant)
+{
+    if (!ctx->filter)
+        return true;
+    char name[256];
+    snprintf(name, sizeof name, "%s/%s/%s", suite, benchmark, variant);
+    return strstr(name, ctx->filter);
+}
+
+void bench_report(struct bench_Context* ctx, const char* suite, const char* benchmark, const char* variant,
+    size_t elemSize, size_t n, const char* metric, double value)
+{
+    if (ctx->format == BENCH_FORMAT_JSON)
+    {
+        fprintf(ctx->out, "%s\n  {\"suite\": \"%s\", \"benchmark\": \"%s\", \"variant\": \"%s\", \"elem_size\": %zu, "
+            "\"n\": %zu, \"metric\": \"%s\", \"value\": %.6g}", ctx->records ? "," : "", suite, benchmark, variant,
+            elemSize, n, metric, value);
+    }
+    else
+        fprintf(ctx->out, "%s,%s,%s,%zu,%zu,%s,%.6g\n", suite, benchmark, variant, elemSize, n, metric, value);
+    ++ctx->records;
+}
+
+static int compareDoubles(const void* a, const void* b)
+{
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+void bench_run(struct bench_Context* ctx, const char* suite, const char* benchmark, const char* variant,
+    size_t elemSize, size_t n, size_t ops, double (*fn)(void* arg), void* arg)
+{
+    if (!bench_enabled(ctx, suite, benchmark, variant))
+        return;
+    double* times = malloc(ctx->repetitions * sizeof(double));
+    if (!times)
+        return;
+    for (int i = 0; i < ctx->repetitions; ++i)
+        times[i] = fn(arg);
+    qsort(times, ctx->repetitions, sizeof(double), compareDoubles);
+    double best = times[0], median = times[ctx->repetitions / 2];
+    free(times);
+    bench_report(ctx, suite, benchmark, variant, elemSize, n, "ns_per_op_best", best * 1e9 / ops);
+    bench_report(ctx, suite, benchmark, variant, elemSize, n, "ns_per_op_median", median * 1e9 / ops);
+    bench_report(ctx, suite, benchmark, variant, elemSize, n, "ops_per_sec", median > 0 ? ops / median : 0);
+    fflush(ctx->out);
+}
+
+// Returns the index of the `perMille`th per mille of `count` sorted values, (count - 1) * perMille / 1000, without
+// overflowing.
+static size_t percentileIndex(size_t count, size_t perMille)
+{
+    size_t last = count - 1;
+    return last / 1000 * perMille + last % 1000 * perMille / 1000;
+}
+
+void bench_reportPercentiles(struct bench_Context* ctx, const char* suite, const char* benchmark, const char* variant,
+    size_t elemSize, size_t n, double* latencies, size_t count)
+{
+    if (!count)
+        return;
+    qsort(latencies, count, sizeof(double), compareDoubles);
+    bench_report(ctx, suite, benchmark, variant, elemSize, n, "ns_p50", latencies[count / 2] * 1e9);
+    bench_report(ctx, suite, benchmark, variant, elemSize, n, "ns_p99", latencies[percentileIndex(count, 990)] * 1e9);
+    bench_report(ctx, suite, benchmark, variant, elemSize, n, "ns_p999", latencies[percentileIndex(count, 999)] * 1e9);
+    bench_report(ctx, suite, benchmark, variant, elemSize, n, "ns_max", latencies[count - 1] * 1e9);
+    fflush(ctx->out);
+}
+
+static const struct
+{
+    const char* name;
+    void (*run)(struct bench_Context* ctx);
+} suites[] = {
+    {"dyn_array", bench_dynArray},
+    {"small_dyn_array", bench_smallDynArray},
+    {"kernels", bench_kernels},
+    {"conc_dyn_array", bench_concDynArray},
+    {"mapped_dyn_array", bench_mappedDynArray},
+    {"cyclic_buffer", bench_cyclicBuffer},
+    {"hash_map", bench_hashMap},
+    {"sort", bench_sort},
+    {"soa", bench_soa},
+    {"aligned", bench_aligned},
+    {"dyn_array_file", bench_dynArrayFile},
+    {"seg_array", bench_segArray},
+    {"cow_dyn_array", bench_cowDynArray},
+    {"bit_array", bench_bitArray},
+    {"heap", bench_heap},
+    {"stream_sink", bench_streamSink},
+};
+
+static void usage(const char* program)
+{
+    fprintf(stderr,
+        "usage: %s [options]\n"
+        "  --format csv|json    output format (default: csv)\n"
+        "  --output FILE        write results to FILE instead of standard output\n"
+        "  --filter STRING      only run benchmarks whose suite/benchmark/variant contains STRING\n"
+        "  --scale X            multiply every problem size by X (default: 1)\n"
+        "  --repetitions N      repeat each benchmark N times (default: 5)\n", program);
+}
+
+int main(int argc, char** argv)
+{
+    struct bench_Context ctx = {stdout, BENCH_FORMAT_CSV, NULL, 1.0, 5, 0};
+    const char* output = NULL;
+    for (int i = 1; i < argc; ++i)
+    {
+        const char* value = i + 1 < argc ? argv[i + 1] : NULL;
+        if (!strcmp(argv[i], "--format") && value)
+        {
+            if (!strcmp(value, "json"))
+                ctx.format = BENCH_FORMAT_JSON;
+            else if (strcmp(value, "csv"))
+                return usage(argv[0]), EXIT_FAILURE;
+        }
+        else if (!strcmp(argv[i], "--output") && value)
+            output = value;
+        else if (!strcmp(argv[i], "--filter") && value)
+            ctx.filter = value;
+        else if (!strcmp(argv[i], "--scale") && value && (ctx.scale = atof(value)) > 0)
+            ;
+        else if (!strcmp(argv[i], "--repetitions") && value && (ctx.repetitions = atoi(value)) > 0)
+            ;
+        else
+            return usage(argv[0]), EXIT_FAILURE;
+        ++i;
+    }
+    if (output && !(ctx.out = fopen(output, "w")))
+    {
+        perror(output);
+        return EXIT_FAILURE;
+    }
+
+    if (ctx.format == BENCH_FORMAT_JSON)
+        fputs("[", ctx.out);
+    else
+        fputs("suite,benchmark,variant,elem_size,n,metric,value\n", ctx.out);
+    for (size_t i = 0; i < sizeof suites / sizeof *suites; ++i)
+        suites[i].run(&ctx);
+    if (ctx.format == BENCH_FORMAT_JSON)
+        fputs("\n]\n", ctx.out);
+
+    if (output)
+        fclose(ctx.out);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,117 @@
+#ifndef CUTILS_BENCH_BENCH_H_10162026
+#define CUTILS_BENCH_BENCH_H_10162026
+
+/** @file
+ * @brief Contains the harness shared by the benchmark suites.
+ *
+ * Results are emitted in long form: one record per metric, each with the fields `suite`, `benchmark`, `variant`,
+ * `elem_size`, `n`, `metric`, and `value`. This keeps the CSV columns fixed as suites are added, and lets two runs be
+ * compared by joining on every field except `value`.
+ */
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdbool.h>
+
+/** @brief Output formats understood by the harness. */
+enum bench_Format
+{
+    BENCH_FORMAT_CSV,
+    BENCH_FORMAT_JSON
+};
+
+/** @brief Settings and output state shared by every benchmark in a run. */
+struct bench_Context
+{
+    /** @brief the stream results are written to */
+    FILE* out;
+    /** @brief the format results are written in */
+    enum bench_Format format;
+    /** @brief only benchmarks whose `suite/benchmark/variant` contains this string are run, unless it is `NULL` */
+    const char* filter;
+    /** @brief multiplier applied to every problem size via `bench_scaled()` */
+    double scale;
+    /** @brief number of times each benchmark is repeated */
+    int repetitions;
+    /** @brief number of records written so far */
+    size_t records;
+};
+
+/** @brief Returns a monotonic timestamp in seconds. */
+double bench_now(void);
+
+/** @brief Prevents the compiler from optimizing away the computation of whatever `p` points to. */
+void bench_consume(const void* p);
+
+/** @brief Returns `n` multiplied by `ctx->scale`, and at least 1. */
+size_t bench_scaled(const struct bench_Context* ctx, size_t n);
+
+/** @brief Returns `true` if the given benchmark passes `ctx->filter`. */
+bool bench_enabled(const struct bench_Context* ctx, const char* suite, const char* benchmark, const char* variant);
+
+/**
+ * @brief Writes a single result record.
+ * @param ctx the benchmark context
+ * @param suite name of the suite, such as `dyn_array`
+ * @param benchmark name of the benchmark, such as `append`
+ * @param variant name of the implementation being measured, such as `generic`
+ * @param elemSize size of the elements being operated on, or zero if not applicable
+ * @param n problem size
+ * @param metric name of the metric, such as `ns_per_op_median`
+ * @param value the measured value
+ */
+void bench_report(struct bench_Context* ctx, const char* suite, const char* benchmark, const char* variant,
+    size_t elemSize, size_t n, const char* metric, double value);
+
+/**
+ * @brief Runs and reports a benchmark, unless it is filtered out.
+ * @param ctx the benchmark context
+ * @param suite name of the suite
+ * @param benchmark name of the benchmark
+ * @param variant name of the implementation being measured
+ * @param elemSize size of the elements being operated on, or zero if not applicable
+ * @param n problem size
+ * @param ops number of operations performed by one call to `fn`
+ * @param fn performs the benchmark once and returns the number of seconds spent in its timed region
+ * @param arg passed to `fn`
+ *
+ * `fn` is called `ctx->repetitions` times. The fastest and median times per operation, and the number of operations
+ * per second at the median, are reported.
+ */
+void bench_run(struct bench_Context* ctx, const char* suite, const char* benchmark, const char* variant,
+    size_t elemSize, size_t n, size_t ops, double (*fn)(void* arg), void* arg);
+
+/**
+ * @brief Reports the median, 99th and 99.9th percentiles, and maximum of a set of latencies.
+ * @param ctx the benchmark context
+ * @param suite name of the suite
+ * @param benchmark name of the benchmark
+ * @param variant name of the implementation being measured
+ * @param elemSize size of the elements being operated on, or zero if not applicable
+ * @param n problem size
+ * @param latencies the latencies of individual operations, in seconds; sorted in place
+ * @param count number of latencies
+ *
+ * Unlike `bench_run()`, does not check `ctx->filter`, so that the caller can skip collecting the latencies altogether.
+ */
+void bench_reportPercentiles(struct bench_Context* ctx, const char* suite, const char* benchmark, const char* variant,
+    size_t elemSize, size_t n, double* latencies, size_t count);
+
+void bench_dynArray(struct bench_Context* ctx);
+void bench_smallDynArray(struct bench_Context* ctx);
+void bench_kernels(struct bench_Context* ctx);
+void bench_concDynArray(struct bench_Context* ctx);
+void bench_mappedDynArray(struct bench_Context* ctx);
+void bench_cyclicBuffer(struct bench_Context* ctx);
+void bench_hashMap(struct bench_Context* ctx);
+void bench_sort(struct bench_Context* ctx);
+void bench_soa(struct bench_Context* ctx);
+void bench_aligned(struct bench_Context* ctx);
+void bench_dynArrayFile(struct bench_Context* ctx);
+void bench_segArray(struct bench_Context* ctx);
+void bench_cowDynArray(struct bench_Context* ctx);
+void bench_bitArray(struct bench_Context* ctx);
+void bench_heap(struct bench_Context* ctx);
+void bench_streamSink(struct bench_Context* ctx);
+
+#endif
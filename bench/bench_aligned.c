@@ -0,0 +1,77 @@
+#include <stddef.h>
+#include <stdint.h>
+
+#include "cutils/data_structures/dyn_array_g.h"
+#include "cutils/memory/aligned.h"
+#include "bench.h"
+
+#define SUITE "aligned"
+// 256 MiB of elements, far more than any TLB covers with 4 KiB pages
+#define N ((size_t)1 << 25)
+#define READS ((size_t)1 << 22)
+
+CTLS_DYN_ARRAY(uint64_t, benchAligned)
+
+struct Args
+{
+    size_t n;
+    struct ctls_DynArray_benchAligned arr;
+};
+
+// Follows a chain of indices through a random cyclic permutation, so each read depends on the previous one and pays the
+// full cost of a TLB miss, if there is one.
+static double randomRead(void* arg)
+{
+    struct Args* args = arg;
+    const uint64_t* data = args->arr.data;
+    uint64_t index = 0;
+    double start = bench_now();
+    for (size_t i = 0; i < READS; ++i)
+        index = data[index];
+    double elapsed = bench_now() - start;
+    bench_consume(&index);
+    return elapsed;
+}
+
+static double sequentialSum(void* arg)
+{
+    struct Args* args = arg;
+    const uint64_t* data = args->arr.data;
+    uint64_t sum = 0;
+    double start = bench_now();
+    for (size_t i = 0; i < args->n; ++i)
+        sum += data[i];
+    double elapsed = bench_now() - start;
+    bench_consume(&sum);
+    return elapsed;
+}
+
+static void runVariant(struct bench_Context* ctx, const char* variant, const struct ctls_Allocator* allocator)
+{
+    struct Args args = {.n = bench_scaled(ctx, N)};
+    if (!ctls_dyn_initWithAllocator_benchAligned(&args.arr, args.n, allocator))
+        return;
+    for (size_t i = 0; i < args.n; ++i)
+        ctls_dyn_append_benchAligned(&args.arr, i);
+    // Sattolo's algorithm turns the identity into a permutation with a single cycle through every element.
+    uint64_t* data = args.arr.data;
+    uint64_t state = 0x2545F4914F6CDD1Du;
+    for (size_t i = args.n - 1; i > 0; --i)
+    {
+        state ^= state << 13, state ^= state >> 7, state ^= state << 17;
+        size_t j = state % i;
+        uint64_t tmp = data[i];
+        data[i] = data[j];
+        data[j] = tmp;
+    }
+    bench_run(ctx, SUITE, "random_read", variant, sizeof(uint64_t), args.n, READS, randomRead, &args);
+    bench_run(ctx, SUITE, "sequential_sum", variant, sizeof(uint64_t), args.n, args.n, sequentialSum, &args);
+    ctls_dyn_reset_benchAligned(&args.arr);
+}
+
+void bench_aligned(struct bench_Context* ctx)
+{
+    runVariant(ctx, "malloc", NULL);
+    runVariant(ctx, "aligned_64", ctls_alignedAllocator(64));
+    runVariant(ctx, "huge_pages", &ctls_hugePageAllocator);
+}
@@ -0,0 +1,191 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "cutils/data_structures/bit_array.h"
+#include "cutils/data_structures/dyn_array_g.h"
+#include "cutils/simd/kernels.h"
+#include "bench.h"
+
+#define SUITE "bit_array"
+// 64 MiB of flags as bools, 8 MiB as bits, so that neither fits in cache.
+#define N ((size_t)1 << 26)
+// One flag in this many is set in the sparse flags that `find_all` scans.
+#define SPARSITY 64
+
+CTLS_DYN_ARRAY(bool, benchBit)
+
+struct Args
+{
+    size_t n;
+    // The same flags, as bools and as bits. `a` is dense and `sparse` is sparse; `b` is combined into `a`.
+    struct ctls_DynArray_benchBit boolA, boolB, boolSparse;
+    struct ctls_BitArray bitA, bitB, bitSparse;
+};
+
+static const char* const levelNames[] = {"scalar", "sse2", "avx2"};
+
+static double popcountBool(void* arg)
+{
+    const struct Args* args = arg;
+    double start = bench_now();
+    size_t count = 0;
+    for (size_t i = 0; i < args->n; ++i)
+        count += args->boolA.data[i];
+    double elapsed = bench_now() - start;
+    bench_consume(&count);
+    return elapsed;
+}
+
+static double popcountBit(void* arg)
+{
+    const struct Args* args = arg;
+    double start = bench_now();
+    size_t count = ctls_bit_popcount(&args->bitA);
+    double elapsed = bench_now() - start;
+    bench_consume(&count);
+    return elapsed;
+}
+
+static double andBool(void* arg)
+{
+    struct Args* args = arg;
+    bool* a = args->boolA.data;
+    const bool* b = args->boolB.data;
+    double start = bench_now();
+    for (size_t i = 0; i < args->n; ++i)
+        a[i] = a[i] & b[i];
+    double elapsed = bench_now() - start;
+    bench_consume(a);
+    return elapsed;
+}
+
+static double andBit(void* arg)
+{
+    struct Args* args = arg;
+    double start = bench_now();
+    ctls_bit_and(&args->bitA, &args->bitB);
+    double elapsed = bench_now() - start;
+    bench_consume(args->bitA.words);
+    return elapsed;
+}
+
+static double findAllBool(void* arg)
+{
+    const struct Args* args = arg;
+    const bool* flags = args->boolSparse.data;
+    double start = bench_now();
+    size_t sum = 0;
+    for (size_t i = 0; i < args->n; ++i)
+    {
+        if (flags[i])
+            sum += i;
+    }
+    double elapsed = bench_now() - start;
+    bench_consume(&sum);
+    return elapsed;
+}
+
+static double findAllBit(void* arg)
+{
+    const struct Args* args = arg;
+    const struct ctls_BitArray* flags = &args->bitSparse;
+    double start = bench_now();
+    size_t sum = 0;
+    for (size_t i = ctls_bit_findFirstSet(flags, 0); i < flags->size; i = ctls_bit_findFirstSet(flags, i + 1))
+        sum += i;
+    double elapsed = bench_now() - start;
+    bench_consume(&sum);
+    return elapsed;
+}
+
+static double appendBool(void* arg)
+{
+    const struct Args* args = arg;
+    struct ctls_DynArray_benchBit arr = {0};
+    double start = bench_now();
+    ctls_dyn_defaultInit_benchBit(&arr);
+    for (size_t i = 0; i < args->n; ++i)
+        ctls_dyn_append_benchBit(&arr, i % 3 == 0);
+    double elapsed = bench_now() - start;
+    bench_consume(arr.data);
+    ctls_dyn_reset_benchBit(&arr);
+    return elapsed;
+}
+
+static double appendBit(void* arg)
+{
+    const struct Args* args = arg;
+    struct ctls_BitArray arr = {0};
+    double start = bench_now();
+    ctls_bit_defaultInit(&arr);
+    for (size_t i = 0; i < args->n; ++i)
+        ctls_bit_append(&arr, i % 3 == 0);
+    double elapsed = bench_now() - start;
+    bench_consume(arr.words);
+    ctls_bit_reset(&arr);
+    return elapsed;
+}
+
+static void resetArgs(struct Args* args)
+{
+    ctls_dyn_reset_benchBit(&args->boolA);
+    ctls_dyn_reset_benchBit(&args->boolB);
+    ctls_dyn_reset_benchBit(&args->boolSparse);
+    ctls_bit_reset(&args->bitA);
+    ctls_bit_reset(&args->bitB);
+    ctls_bit_reset(&args->bitSparse);
+}
+
+void bench_bitArray(struct bench_Context* ctx)
+{
+    struct Args args = {.n = bench_scaled(ctx, N)};
+    bool ok = ctls_dyn_init_benchBit(&args.boolA, args.n) && ctls_dyn_init_benchBit(&args.boolB, args.n)
+        && ctls_dyn_init_benchBit(&args.boolSparse, args.n) && ctls_bit_init(&args.bitA, args.n)
+        && ctls_bit_init(&args.bitB, args.n) && ctls_bit_init(&args.bitSparse, args.n);
+    uint64_t state = 0x9E3779B97F4A7C15u;
+    for (size_t i = 0; ok && i < args.n; ++i)
+    {
+        state ^= state << 13, state ^= state >> 7, state ^= state << 17;
+        bool a = state & 1, b = state >> 1 & 1, sparse = (state >> 2) % SPARSITY == 0;
+        ctls_dyn_append_benchBit(&args.boolA, a);
+        ctls_dyn_append_benchBit(&args.boolB, b);
+        ctls_dyn_append_benchBit(&args.boolSparse, sparse);
+        ctls_bit_append(&args.bitA, a);
+        ctls_bit_append(&args.bitB, b);
+        ctls_bit_append(&args.bitSparse, sparse);
+    }
+    if (!ok)
+    {
+        resetArgs(&args);
+        return;
+    }
+
+    static const struct
+    {
+        const char* name;
+        double (*boolVersion)(void* arg);
+        double (*bitVersion)(void* arg);
+    } benchmarks[] = {
+        {"popcount", popcountBool, popcountBit},
+        {"and", andBool, andBit},
+        {"find_all", findAllBool, findAllBit},
+    };
+    enum ctls_SimdLevel supported = ctls_simd_level();
+    for (size_t i = 0; i < sizeof benchmarks / sizeof *benchmarks; ++i)
+    {
+        bench_run(ctx, SUITE, benchmarks[i].name, "bool", sizeof(bool), args.n, args.n, benchmarks[i].boolVersion,
+            &args);
+        for (int level = CTLS_SIMD_SCALAR; level <= (int)supported; ++level)
+        {
+            ctls_simd_setLevel(level);
+            bench_run(ctx, SUITE, benchmarks[i].name, levelNames[level], sizeof(bool), args.n, args.n,
+                benchmarks[i].bitVersion, &args);
+        }
+        ctls_simd_setLevel(supported);
+    }
+    bench_run(ctx, SUITE, "append", "bool", sizeof(bool), args.n, args.n, appendBool, &args);
+    bench_run(ctx, SUITE, "append", "bit", sizeof(bool), args.n, args.n, appendBit, &args);
+
+    resetArgs(&args);
+}
@@ -0,0 +1,149 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stddef.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "cutils/data_structures/dyn_array.h"
+#include "cutils/data_structures/conc_dyn_array.h"
+#include "bench.h"
+
+#define SUITE "conc_dyn_array"
+#define N ((size_t)1 << 22)
+#define BLOCK 256
+#define MAX_THREADS 64
+
+struct Args
+{
+    size_t n;
+    size_t threads;
+};
+
+// Shared by the workers of one run. Every worker appends `n / threads` elements.
+struct Run
+{
+    pthread_barrier_t barrier;
+    pthread_mutex_t mutex;
+    struct ctls_DynArray dynArr;
+    struct ctls_ConcDynArray concArr;
+    size_t perThread;
+};
+
+struct Worker
+{
+    struct Run* run;
+    pthread_t thread;
+    size_t id;
+};
+
+static void* appendLocked(void* arg)
+{
+    struct Worker* worker = arg;
+    struct Run* run = worker->run;
+    pthread_barrier_wait(&run->barrier);
+    for (size_t i = 0; i < run->perThread; ++i)
+    {
+        int64_t elem = (int64_t)(worker->id * run->perThread + i);
+        pthread_mutex_lock(&run->mutex);
+        ctls_dyn_append(&run->dynArr, &elem, sizeof elem);
+        pthread_mutex_unlock(&run->mutex);
+    }
+    return NULL;
+}
+
+static void* appendConcurrent(void* arg)
+{
+    struct Worker* worker = arg;
+    struct Run* run = worker->run;
+    pthread_barrier_wait(&run->barrier);
+    for (size_t i = 0; i < run->perThread; ++i)
+    {
+        int64_t elem = (int64_t)(worker->id * run->perThread + i);
+        ctls_cdyn_append(&run->concArr, &elem, sizeof elem);
+    }
+    return NULL;
+}
+
+static void* reserveRange(void* arg)
+{
+    struct Worker* worker = arg;
+    struct Run* run = worker->run;
+    pthread_barrier_wait(&run->barrier);
+    for (size_t i = 0; i < run->perThread; i += BLOCK)
+    {
+        size_t count = run->perThread - i < BLOCK ? run->perThread - i : BLOCK, first;
+        if (!ctls_cdyn_reserveRange(&run->concArr, count, sizeof(int64_t), &first))
+            break;
+        for (size_t j = first, length, k = 0; j < first + count; j += length)
+        {
+            int64_t* span = ctls_cdyn_span(&run->concArr, j, sizeof(int64_t), &length);
+            if (length > first + count - j)
+                length = first + count - j;
+            for (size_t l = 0; l < length; ++l, ++k)
+                span[l] = (int64_t)(worker->id * run->perThread + i + k);
+        }
+    }
+    return NULL;
+}
+
+// Starts the workers, releases them at once, and times how long it takes until all of them are done.
+static double runWorkers(const struct Args* args, void* (*work)(void*))
+{
+    struct Run run;
+    struct Worker workers[MAX_THREADS];
+    pthread_barrier_init(&run.barrier, NULL, (unsigned)args->threads + 1);
+    pthread_mutex_init(&run.mutex, NULL);
+    ctls_dyn_defaultInit(&run.dynArr, sizeof(int64_t));
+    ctls_cdyn_defaultInit(&run.concArr, sizeof(int64_t));
+    run.perThread = args->n / args->threads;
+    for (size_t i = 0; i < args->threads; ++i)
+    {
+        workers[i] = (struct Worker){.run = &run, .id = i};
+        pthread_create(&workers[i].thread, NULL, work, &workers[i]);
+    }
+    pthread_barrier_wait(&run.barrier);
+    double start = bench_now();
+    for (size_t i = 0; i < args->threads; ++i)
+        pthread_join(workers[i].thread, NULL);
+    double elapsed = bench_now() - start;
+    bench_consume(run.dynArr.data);
+    bench_consume(ctls_cdyn_at(&run.concArr, 0, sizeof(int64_t)));
+    ctls_cdyn_reset(&run.concArr, sizeof(int64_t));
+    ctls_dyn_reset(&run.dynArr, sizeof(int64_t));
+    pthread_mutex_destroy(&run.mutex);
+    pthread_barrier_destroy(&run.barrier);
+    return elapsed;
+}
+
+static double mutexBench(void* arg)
+{
+    return runWorkers(arg, appendLocked);
+}
+
+static double appendBench(void* arg)
+{
+    return runWorkers(arg, appendConcurrent);
+}
+
+static double reserveRangeBench(void* arg)
+{
+    return runWorkers(arg, reserveRange);
+}
+
+void bench_concDynArray(struct bench_Context* ctx)
+{
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t maxThreads = cores < 1 ? 1 : cores > MAX_THREADS ? MAX_THREADS : (size_t)cores;
+    for (size_t threads = 1;; threads = threads * 2 < maxThreads ? threads * 2 : maxThreads)
+    {
+        struct Args args = {bench_scaled(ctx, N), threads};
+        char benchmark[32];
+        snprintf(benchmark, sizeof benchmark, "append_%zu_threads", threads);
+        bench_run(ctx, SUITE, benchmark, "mutex", sizeof(int64_t), args.n, args.n, mutexBench, &args);
+        bench_run(ctx, SUITE, benchmark, "append", sizeof(int64_t), args.n, args.n, appendBench, &args);
+        bench_run(ctx, SUITE, benchmark, "reserve_range", sizeof(int64_t), args.n, args.n, reserveRangeBench, &args);
+        if (threads == maxThreads)
+            break;
+    }
+}
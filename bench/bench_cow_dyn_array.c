@@ -0,0 +1,160 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#include "cutils/data_structures/cow_dyn_array.h"
+#include "cutils/data_structures/dyn_array.h"
+#include "bench.h"
+
+#define SUITE "cow_dyn_array"
+#define N ((size_t)1 << 20)
+#define COPIES 64
+#define ACQUISITIONS ((size_t)1 << 20)
+#define PUBLISHES ((size_t)1 << 18)
+#define READERS 3
+
+struct Args
+{
+    size_t n;
+    struct ctls_DynArray dyn;
+    struct ctls_CowDynArray cow;
+    struct ctls_CowSlot slot;
+};
+
+// Gives each of `COPIES` readers a private copy of the array, as a thread pool would.
+static double copyDyn(void* arg)
+{
+    struct Args* args = arg;
+    struct ctls_DynArray copies[COPIES] = {{0}};
+    double start = bench_now();
+    for (size_t i = 0; i < COPIES; ++i)
+        ctls_dyn_copy(&copies[i], &args->dyn, sizeof(int64_t));
+    double elapsed = bench_now() - start;
+    bench_consume(copies);
+    for (size_t i = 0; i < COPIES; ++i)
+    {
+        if (copies[i].data)
+            ctls_dyn_reset(&copies[i], sizeof(int64_t));
+    }
+    return elapsed;
+}
+
+static double copyCow(void* arg)
+{
+    struct Args* args = arg;
+    struct ctls_CowDynArray copies[COPIES];
+    double start = bench_now();
+    for (size_t i = 0; i < COPIES; ++i)
+        ctls_cow_copy(&copies[i], &args->cow);
+    double elapsed = bench_now() - start;
+    bench_consume(copies);
+    for (size_t i = 0; i < COPIES; ++i)
+        ctls_cow_reset(&copies[i], sizeof(int64_t));
+    return elapsed;
+}
+
+// The first mutation of a shared array pays for the copy that `copyCow` deferred.
+static double firstWriteCow(void* arg)
+{
+    struct Args* args = arg;
+    struct ctls_CowDynArray copy;
+    ctls_cow_copy(&copy, &args->cow);
+    int64_t elem = -1;
+    double start = bench_now();
+    ctls_cow_append(&copy, &elem, sizeof(int64_t));
+    double elapsed = bench_now() - start;
+    bench_consume(copy.block);
+    ctls_cow_reset(&copy, sizeof(int64_t));
+    return elapsed;
+}
+
+static double acquireRelease(void* arg)
+{
+    struct Args* args = arg;
+    double start = bench_now();
+    for (size_t i = 0; i < ACQUISITIONS; ++i)
+        ctls_cow_release(ctls_cow_acquire(&args->slot), sizeof(int64_t));
+    return bench_now() - start;
+}
+
+struct PublishRun
+{
+    struct ctls_CowSlot slot;
+    atomic_bool done;
+};
+
+static void* acquireUntilDone(void* arg)
+{
+    struct PublishRun* run = arg;
+    int64_t sum = 0;
+    while (!atomic_load_explicit(&run->done, memory_order_relaxed))
+    {
+        const struct ctls_CowBlock* snapshot = ctls_cow_acquire(&run->slot);
+        if (snapshot)
+        {
+            sum += *(const int64_t*)ctls_cow_data(snapshot);
+            ctls_cow_release(snapshot, sizeof(int64_t));
+        }
+    }
+    bench_consume(&sum);
+    return NULL;
+}
+
+// Publishes versions back to back while readers acquire them as fast as they can. Each version is modified before the
+// next is published, so publishing frees the previous version as soon as the last reader releases it, which is when a
+// reader still in the middle of acquiring it would touch freed memory.
+static double publishContended(void* arg)
+{
+    (void)arg;
+    struct PublishRun run = {.done = false};
+    struct ctls_CowDynArray arr;
+    if (!ctls_cow_init(&arr, 1, sizeof(int64_t)) || !ctls_cow_append(&arr, &(int64_t){0}, sizeof(int64_t)))
+        return 0;
+    pthread_t readers[READERS];
+    size_t started = 0;
+    while (started < READERS && !pthread_create(&readers[started], NULL, acquireUntilDone, &run))
+        ++started;
+    double start = bench_now();
+    for (size_t i = 0; i < PUBLISHES; ++i)
+    {
+        ctls_cow_publish(&run.slot, &arr, sizeof(int64_t));
+        *(int64_t*)ctls_cow_mutableData(&arr, sizeof(int64_t)) = (int64_t)i;
+    }
+    double elapsed = bench_now() - start;
+    atomic_store(&run.done, true);
+    for (size_t i = 0; i < started; ++i)
+        pthread_join(readers[i], NULL);
+    ctls_cow_resetSlot(&run.slot, sizeof(int64_t));
+    ctls_cow_reset(&arr, sizeof(int64_t));
+    return elapsed;
+}
+
+void bench_cowDynArray(struct bench_Context* ctx)
+{
+    struct Args args = {.n = bench_scaled(ctx, N)};
+    if (!ctls_dyn_init(&args.dyn, args.n, sizeof(int64_t)))
+        return;
+    if (!ctls_cow_init(&args.cow, args.n, sizeof(int64_t)))
+    {
+        ctls_dyn_reset(&args.dyn, sizeof(int64_t));
+        return;
+    }
+    for (size_t i = 0; i < args.n; ++i)
+    {
+        ctls_dyn_append(&args.dyn, &(int64_t){(int64_t)i}, sizeof(int64_t));
+        ctls_cow_append(&args.cow, &(int64_t){(int64_t)i}, sizeof(int64_t));
+    }
+    ctls_cow_publish(&args.slot, &args.cow, sizeof(int64_t));
+
+    bench_run(ctx, SUITE, "copy", "dyn", sizeof(int64_t), args.n, COPIES, copyDyn, &args);
+    bench_run(ctx, SUITE, "copy", "cow", sizeof(int64_t), args.n, COPIES, copyCow, &args);
+    bench_run(ctx, SUITE, "first_write", "cow", sizeof(int64_t), args.n, 1, firstWriteCow, &args);
+    bench_run(ctx, SUITE, "acquire_release", "cow", sizeof(int64_t), args.n, ACQUISITIONS, acquireRelease, &args);
+    bench_run(ctx, SUITE, "publish_contended", "cow", sizeof(int64_t), 1, PUBLISHES, publishContended, NULL);
+
+    ctls_cow_resetSlot(&args.slot, sizeof(int64_t));
+    ctls_cow_reset(&args.cow, sizeof(int64_t));
+    ctls_dyn_reset(&args.dyn, sizeof(int64_t));
+}
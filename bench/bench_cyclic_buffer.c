@@ -0,0 +1,161 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stddef.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include "cutils/data_structures/cyclic_buffer_g.h"
+#include "bench.h"
+
+#define SUITE "cyclic_buffer"
+#define N ((size_t)1 << 22)
+#define CAPACITY 1024
+#define BATCH 64
+
+CTLS_CYCLIC_BUFFER(int64_t, i64)
+
+struct Args
+{
+    size_t n;
+    struct ctls_CyclicBuffer_i64 buf;
+    int64_t sum;
+};
+
+// Single-threaded benchmarks alternate between filling the buffer with a batch and draining it again.
+static double elementsSingle(void* arg)
+{
+    struct Args* args = arg;
+    int64_t sum = 0;
+    double start = bench_now();
+    for (size_t i = 0; i < args->n; i += BATCH)
+    {
+        for (size_t j = 0; j < BATCH; ++j)
+            ctls_cbuf_push_i64(&args->buf, (int64_t)(i + j));
+        for (int64_t elem; ctls_cbuf_pop_i64(&args->buf, &elem);)
+            sum += elem;
+    }
+    double elapsed = bench_now() - start;
+    bench_consume(&sum);
+    return elapsed;
+}
+
+static double spansSingle(void* arg)
+{
+    struct Args* args = arg;
+    int64_t sum = 0;
+    double start = bench_now();
+    for (size_t i = 0; i < args->n; i += BATCH)
+    {
+        for (size_t j = 0, length; j < BATCH; j += length)
+        {
+            int64_t* span = ctls_cbuf_writeSpan_i64(&args->buf, &length);
+            if (length > BATCH - j)
+                length = BATCH - j;
+            for (size_t k = 0; k < length; ++k)
+                span[k] = (int64_t)(i + j + k);
+            ctls_cbuf_commitWrite_i64(&args->buf, length);
+        }
+        for (size_t length; ctls_cbuf_size_i64(&args->buf);)
+        {
+            const int64_t* span = ctls_cbuf_readSpan_i64(&args->buf, &length);
+            for (size_t k = 0; k < length; ++k)
+                sum += span[k];
+            ctls_cbuf_commitRead_i64(&args->buf, length);
+        }
+    }
+    double elapsed = bench_now() - start;
+    bench_consume(&sum);
+    return elapsed;
+}
+
+// The producers of the two-threaded benchmarks run on their own thread, while the calling thread consumes. Both yield
+// when they cannot make progress, so that the benchmark also completes on a single core.
+static void* produceElements(void* arg)
+{
+    struct Args* args = arg;
+    for (size_t i = 0; i < args->n;)
+    {
+        if (ctls_cbuf_push_i64(&args->buf, (int64_t)i))
+            ++i;
+        else
+            sched_yield();
+    }
+    return NULL;
+}
+
+static void* produceSpans(void* arg)
+{
+    struct Args* args = arg;
+    for (size_t i = 0; i < args->n;)
+    {
+        size_t length;
+        int64_t* span = ctls_cbuf_writeSpan_i64(&args->buf, &length);
+        if (length > args->n - i)
+            length = args->n - i;
+        if (!length)
+            sched_yield();
+        for (size_t k = 0; k < length; ++k)
+            span[k] = (int64_t)(i + k);
+        ctls_cbuf_commitWrite_i64(&args->buf, length);
+        i += length;
+    }
+    return NULL;
+}
+
+static double elementsSpsc(void* arg)
+{
+    struct Args* args = arg;
+    int64_t sum = 0;
+    pthread_t producer;
+    double start = bench_now();
+    pthread_create(&producer, NULL, produceElements, args);
+    for (size_t i = 0; i < args->n;)
+    {
+        int64_t elem;
+        if (ctls_cbuf_pop_i64(&args->buf, &elem))
+            sum += elem, ++i;
+        else
+            sched_yield();
+    }
+    pthread_join(producer, NULL);
+    double elapsed = bench_now() - start;
+    bench_consume(&sum);
+    return elapsed;
+}
+
+static double spansSpsc(void* arg)
+{
+    struct Args* args = arg;
+    int64_t sum = 0;
+    pthread_t producer;
+    double start = bench_now();
+    pthread_create(&producer, NULL, produceSpans, args);
+    for (size_t i = 0; i < args->n;)
+    {
+        size_t length;
+        const int64_t* span = ctls_cbuf_readSpan_i64(&args->buf, &length);
+        if (!length)
+            sched_yield();
+        for (size_t k = 0; k < length; ++k)
+            sum += span[k];
+        ctls_cbuf_commitRead_i64(&args->buf, length);
+        i += length;
+    }
+    pthread_join(producer, NULL);
+    double elapsed = bench_now() - start;
+    bench_consume(&sum);
+    return elapsed;
+}
+
+void bench_cyclicBuffer(struct bench_Context* ctx)
+{
+    struct Args args = {.n = bench_scaled(ctx, N)};
+    if (!ctls_cbuf_init_i64(&args.buf, CAPACITY))
+        return;
+    bench_run(ctx, SUITE, "single_thread", "element", sizeof(int64_t), args.n, args.n, elementsSingle, &args);
+    bench_run(ctx, SUITE, "single_thread", "span", sizeof(int64_t), args.n, args.n, spansSingle, &args);
+    bench_run(ctx, SUITE, "spsc", "element", sizeof(int64_t), args.n, args.n, elementsSpsc, &args);
+    bench_run(ctx, SUITE, "spsc", "span", sizeof(int64_t), args.n, args.n, spansSpsc, &args);
+    ctls_cbuf_reset_i64(&args.buf);
+}
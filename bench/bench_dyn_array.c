@@ -0,0 +1,418 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "cutils/data_structures/dyn_array.h"
+#include "cutils/data_structures/dyn_array_g.h"
+#include "bench.h"
+
+#define SUITE "dyn_array"
+
+// Problem sizes for linear-time benchmarks, and for those that shift the whole array on every operation.
+#define LARGE_N ((size_t)1 << 20)
+#define SMALL_N ((size_t)1 << 12)
+#define SMALL_BATCH 4
+#define LARGE_BATCH 1024
+#define COPIES 16
+#define SHRUNK_ARRAYS 64
+
+struct Elem16
+{
+    int64_t a, b;
+};
+
+struct Elem64
+{
+    int64_t a[8];
+};
+
+static inline int32_t make_i32(size_t i)
+{
+    return (int32_t)i;
+}
+
+static inline int64_t make_i64(size_t i)
+{
+    return (int64_t)i;
+}
+
+static inline struct Elem16 make_e16(size_t i)
+{
+    return (struct Elem16){(int64_t)i, (int64_t)i};
+}
+
+static inline struct Elem64 make_e64(size_t i)
+{
+    return (struct Elem64){{(int64_t)i}};
+}
+
+struct Benchmarks
+{
+    double (*append)(void* n);
+    double (*insertFront)(void* n);
+    double (*insertMiddle)(void* n);
+    double (*extendSmall)(void* n);
+    double (*extendLarge)(void* n);
+    double (*remove)(void* n);
+    double (*copy)(void* n);
+    double (*shrinkToFit)(void* n);
+};
+
+// Defines the benchmarks for the void* API. Each takes a pointer to its problem size and returns the number of seconds
+// spent in its timed region.
+#define DEFINE_VOID_BENCHMARKS(type, suffix) \
+\
+static void fillVoid_##suffix(struct ctls_DynArray* arr, size_t n) \
+{ \
+    ctls_dyn_defaultInit(arr, sizeof(type)); \
+    for (size_t i = 0; i < n; ++i) \
+    { \
+        type elem = make_##suffix(i); \
+        ctls_dyn_append(arr, &elem, sizeof(type)); \
+    } \
+} \
+\
+static double appendVoid_##suffix(void* arg) \
+{ \
+    size_t n = *(size_t*)arg; \
+    struct ctls_DynArray arr = {0}; \
+    double start = bench_now(); \
+    fillVoid_##suffix(&arr, n); \
+    double elapsed = bench_now() - start; \
+    bench_consume(arr.data); \
+    ctls_dyn_reset(&arr, sizeof(type)); \
+    return elapsed; \
+} \
+\
+static double insertVoid_##suffix(size_t n, size_t divisor) \
+{ \
+    struct ctls_DynArray arr = {0}; \
+    ctls_dyn_defaultInit(&arr, sizeof(type)); \
+    double start = bench_now(); \
+    for (size_t i = 0; i < n; ++i) \
+    { \
+        type elem = make_##suffix(i); \
+        ctls_dyn_insert(&arr, &elem, divisor ? arr.size / divisor : 0, 1, sizeof(type)); \
+    } \
+    double elapsed = bench_now() - start; \
+    bench_consume(arr.data); \
+    ctls_dyn_reset(&arr, sizeof(type)); \
+    return elapsed; \
+} \
+\
+static double insertFrontVoid_##suffix(void* arg) \
+{ \
+    return insertVoid_##suffix(*(size_t*)arg, 0); \
+} \
+\
+static double insertMiddleVoid_##suffix(void* arg) \
+{ \
+    return insertVoid_##suffix(*(size_t*)arg, 2); \
+} \
+\
+static double extendVoid_##suffix(size_t n, size_t batch) \
+{ \
+    type* src = malloc(batch * sizeof(type)); \
+    for (size_t i = 0; i < batch; ++i) \
+        src[i] = make_##suffix(i); \
+    struct ctls_DynArray arr = {0}; \
+    ctls_dyn_defaultInit(&arr, sizeof(type)); \
+    double start = bench_now(); \
+    for (size_t i = 0; i < n / batch; ++i) \
+        ctls_dyn_extend(&arr, src, batch, sizeof(type)); \
+    double elapsed = bench_now() - start; \
+    bench_consume(arr.data); \
+    ctls_dyn_reset(&arr, sizeof(type)); \
+    free(src); \
+    return elapsed; \
+} \
+\
+static double extendSmallVoid_##suffix(void* arg) \
+{ \
+    return extendVoid_##suffix(*(size_t*)arg, SMALL_BATCH); \
+} \
+\
+static double extendLargeVoid_##suffix(void* arg) \
+{ \
+    return extendVoid_##suffix(*(size_t*)arg, LARGE_BATCH); \
+} \
+\
+static double removeVoid_##suffix(void* arg) \
+{ \
+    struct ctls_DynArray arr = {0}; \
+    fillVoid_##suffix(&arr, *(size_t*)arg); \
+    double start = bench_now(); \
+    while (arr.size) \
+        ctls_dyn_remove(&arr, arr.size / 2, arr.size / 2 + 1, sizeof(type)); \
+    double elapsed = bench_now() - start; \
+    bench_consume(arr.data); \
+    ctls_dyn_reset(&arr, sizeof(type)); \
+    return elapsed; \
+} \
+\
+static double copyVoid_##suffix(void* arg) \
+{ \
+    struct ctls_DynArray src = {0}, dest = {0}; \
+    fillVoid_##suffix(&src, *(size_t*)arg); \
+    double start = bench_now(); \
+    for (size_t i = 0; i < COPIES; ++i) \
+        ctls_dyn_copy(&dest, &src, sizeof(type)); \
+    double elapsed = bench_now() - start; \
+    bench_consume(dest.data); \
+    ctls_dyn_reset(&src, sizeof(type)); \
+    ctls_dyn_reset(&dest, sizeof(type)); \
+    return elapsed; \
+} \
+\
+static double shrinkToFitVoid_##suffix(void* arg) \
+{ \
+    struct ctls_DynArray arrs[SHRUNK_ARRAYS] = {{0}}; \
+    for (size_t i = 0; i < SHRUNK_ARRAYS; ++i) \
+        fillVoid_##suffix(&arrs[i], *(size_t*)arg / SHRUNK_ARRAYS + 1); \
+    double start = bench_now(); \
+    for (size_t i = 0; i < SHRUNK_ARRAYS; ++i) \
+        ctls_dyn_shrinkToFit(&arrs[i], sizeof(type)); \
+    double elapsed = bench_now() - start; \
+    for (size_t i = 0; i < SHRUNK_ARRAYS; ++i) \
+        ctls_dyn_reset(&arrs[i], sizeof(type)); \
+    return elapsed; \
+} \
+\
+static const struct Benchmarks voidBenchmarks_##suffix = {appendVoid_##suffix, insertFrontVoid_##suffix, \
+    insertMiddleVoid_##suffix, extendSmallVoid_##suffix, extendLargeVoid_##suffix, removeVoid_##suffix, \
+    copyVoid_##suffix, shrinkToFitVoid_##suffix};
+
+// Defines the same benchmarks for a specialization created with CTLS_DYN_ARRAY.
+#define DEFINE_GENERIC_BENCHMARKS(type, suffix) \
+\
+CTLS_DYN_ARRAY(type, suffix) \
+\
+static void fillGeneric_##suffix(struct ctls_DynArray_##suffix* arr, size_t n) \
+{ \
+    ctls_dyn_defaultInit_##suffix(arr); \
+    for (size_t i = 0; i < n; ++i) \
+        ctls_dyn_append_##suffix(arr, make_##suffix(i)); \
+} \
+\
+static double appendGeneric_##suffix(void* arg) \
+{ \
+    size_t n = *(size_t*)arg; \
+    struct ctls_DynArray_##suffix arr = {0}; \
+    double start = bench_now(); \
+    fillGeneric_##suffix(&arr, n); \
+    double elapsed = bench_now() - start; \
+    bench_consume(arr.data); \
+    ctls_dyn_reset_##suffix(&arr); \
+    return elapsed; \
+} \
+\
+static double insertGeneric_##suffix(size_t n, size_t divisor) \
+{ \
+    struct ctls_DynArray_##suffix arr = {0}; \
+    ctls_dyn_defaultInit_##suffix(&arr); \
+    double start = bench_now(); \
+    for (size_t i = 0; i < n; ++i) \
+    { \
+        type elem = make_##suffix(i); \
+        ctls_dyn_insert_##suffix(&arr, &elem, divisor ? arr.size / divisor : 0, 1); \
+    } \
+    double elapsed = bench_now() - start; \
+    bench_consume(arr.data); \
+    ctls_dyn_reset_##suffix(&arr); \
+    return elapsed; \
+} \
+\
+static double insertFrontGeneric_##suffix(void* arg) \
+{ \
+    return insertGeneric_##suffix(*(size_t*)arg, 0); \
+} \
+\
+static double insertMiddleGeneric_##suffix(void* arg) \
+{ \
+    return insertGeneric_##suffix(*(size_t*)arg, 2); \
+} \
+\
+static double extendGeneric_##suffix(size_t n, size_t batch) \
+{ \
+    type* src = malloc(batch * sizeof(type)); \
+    for (size_t i = 0; i < batch; ++i) \
+        src[i] = make_##suffix(i); \
+    struct ctls_DynArray_##suffix arr = {0}; \
+    ctls_dyn_defaultInit_##suffix(&arr); \
+    double start = bench_now(); \
+    for (size_t i = 0; i < n / batch; ++i) \
+        ctls_dyn_extend_##suffix(&arr, src, batch); \
+    double elapsed = bench_now() - start; \
+    bench_consume(arr.data); \
+    ctls_dyn_reset_##suffix(&arr); \
+    free(src); \
+    return elapsed; \
+} \
+\
+static double extendSmallGeneric_##suffix(void* arg) \
+{ \
+    return extendGeneric_##suffix(*(size_t*)arg, SMALL_BATCH); \
+} \
+\
+static double extendLargeGeneric_##suffix(void* arg) \
+{ \
+    return extendGeneric_##suffix(*(size_t*)arg, LARGE_BATCH); \
+} \
+\
+static double removeGeneric_##suffix(void* arg) \
+{ \
+    struct ctls_DynArray_##suffix arr = {0}; \
+    fillGeneric_##suffix(&arr, *(size_t*)arg); \
+    double start = bench_now(); \
+    while (arr.size) \
+        ctls_dyn_remove_##suffix(&arr, arr.size / 2, arr.size / 2 + 1); \
+    double elapsed = bench_now() - start; \
+    bench_consume(arr.data); \
+    ctls_dyn_reset_##suffix(&arr); \
+    return elapsed; \
+} \
+\
+static double copyGeneric_##suffix(void* arg) \
+{ \
+    struct ctls_DynArray_##suffix src = {0}, dest = {0}; \
+    fillGeneric_##suffix(&src, *(size_t*)arg); \
+    double start = bench_now(); \
+    for (size_t i = 0; i < COPIES; ++i) \
+        ctls_dyn_copy_##suffix(&dest, &src); \
+    double elapsed = bench_now() - start; \
+    bench_consume(dest.data); \
+    ctls_dyn_reset_##suffix(&src); \
+    ctls_dyn_reset_##suffix(&dest); \
+    return elapsed; \
+} \
+\
+static double shrinkToFitGeneric_##suffix(void* arg) \
+{ \
+    struct ctls_DynArray_##suffix arrs[SHRUNK_ARRAYS] = {{0}}; \
+    for (size_t i = 0; i < SHRUNK_ARRAYS; ++i) \
+        fillGeneric_##suffix(&arrs[i], *(size_t*)arg / SHRUNK_ARRAYS + 1); \
+    double start = bench_now(); \
+    for (size_t i = 0; i < SHRUNK_ARRAYS; ++i) \
+        ctls_dyn_shrinkToFit_##suffix(&arrs[i]); \
+    double elapsed = bench_now() - start; \
+    for (size_t i = 0; i < SHRUNK_ARRAYS; ++i) \
+        ctls_dyn_reset_##suffix(&arrs[i]); \
+    return elapsed; \
+} \
+\
+static const struct Benchmarks genericBenchmarks_##suffix = {appendGeneric_##suffix, insertFrontGeneric_##suffix, \
+    insertMiddleGeneric_##suffix, extendSmallGeneric_##suffix, extendLargeGeneric_##suffix, \
+    removeGeneric_##suffix, copyGeneric_##suffix, shrinkToFitGeneric_##suffix};
+
+#define DEFINE_BENCHMARKS(type, suffix) \
+DEFINE_VOID_BENCHMARKS(type, suffix) \
+DEFINE_GENERIC_BENCHMARKS(type, suffix)
+
+DEFINE_BENCHMARKS(int32_t, i32)
+DEFINE_BENCHMARKS(int64_t, i64)
+DEFINE_BENCHMARKS(struct Elem16, e16)
+DEFINE_BENCHMARKS(struct Elem64, e64)
+
+static void runBenchmarks(struct bench_Context* ctx, const char* variant, size_t elemSize,
+    const struct Benchmarks* benchmarks)
+{
+    size_t large = bench_scaled(ctx, LARGE_N), small = bench_scaled(ctx, SMALL_N);
+    size_t smallBatches = large / SMALL_BATCH ? large / SMALL_BATCH : 1;
+    size_t largeBatches = large / LARGE_BATCH ? large / LARGE_BATCH : 1;
+    bench_run(ctx, SUITE, "append", variant, elemSize, large, large, benchmarks->append, &large);
+    bench_run(ctx, SUITE, "insert_front", variant, elemSize, small, small, benchmarks->insertFront, &small);
+    bench_run(ctx, SUITE, "insert_middle", variant, elemSize, small, small, benchmarks->insertMiddle, &small);
+    bench_run(ctx, SUITE, "extend_4", variant, elemSize, large, smallBatches, benchmarks->extendSmall, &large);
+    bench_run(ctx, SUITE, "extend_1024", variant, elemSize, large, largeBatches, benchmarks->extendLarge, &large);
+    bench_run(ctx, SUITE, "remove_middle", variant, elemSize, small, small, benchmarks->remove, &small);
+    bench_run(ctx, SUITE, "copy", variant, elemSize, large, COPIES, benchmarks->copy, &large);
+    bench_run(ctx, SUITE, "shrink_to_fit", variant, elemSize, large, SHRUNK_ARRAYS, benchmarks->shrinkToFit,
+        &large);
+}
+
+// Scattered removal deletes every `SCATTER_STRIDE`th element, first one `ctls_dyn_remove` call at a time, then with
+// each of the batched operations. Removing from the back keeps the remaining indices valid.
+#define SCATTER_STRIDE 8
+
+static bool isScattered(const int64_t* elem, void* ctx)
+{
+    (void)ctx;
+    return *elem % SCATTER_STRIDE == 0;
+}
+
+static double scatteredRemoval(size_t n, int method)
+{
+    struct ctls_DynArray_i64 arr = {0};
+    fillGeneric_i64(&arr, n);
+    size_t rangeCount = (n + SCATTER_STRIDE - 1) / SCATTER_STRIDE;
+    size_t* bounds = malloc(2 * rangeCount * sizeof(size_t));
+    for (size_t i = 0; i < rangeCount; ++i)
+        bounds[2 * i] = i * SCATTER_STRIDE, bounds[2 * i + 1] = i * SCATTER_STRIDE + 1;
+    double start = bench_now();
+    switch (method)
+    {
+    case 0:
+        for (size_t i = rangeCount; i-- > 0;)
+            ctls_dyn_remove_i64(&arr, i * SCATTER_STRIDE, i * SCATTER_STRIDE + 1);
+        break;
+    case 1:
+        ctls_dyn_removeRanges_i64(&arr, bounds, rangeCount);
+        break;
+    case 2:
+        ctls_dyn_eraseIf_i64(&arr, isScattered, NULL);
+        break;
+    default:
+        for (size_t i = rangeCount; i-- > 0;)
+            ctls_dyn_swapRemove_i64(&arr, i * SCATTER_STRIDE);
+        break;
+    }
+    double elapsed = bench_now() - start;
+    bench_consume(arr.data);
+    free(bounds);
+    ctls_dyn_reset_i64(&arr);
+    return elapsed;
+}
+
+static double scatteredRemove(void* arg)
+{
+    return scatteredRemoval(*(size_t*)arg, 0);
+}
+
+static double scatteredRemoveRanges(void* arg)
+{
+    return scatteredRemoval(*(size_t*)arg, 1);
+}
+
+static double scatteredEraseIf(void* arg)
+{
+    return scatteredRemoval(*(size_t*)arg, 2);
+}
+
+static double scatteredSwapRemove(void* arg)
+{
+    return scatteredRemoval(*(size_t*)arg, 3);
+}
+
+static void runScatteredBenchmarks(struct bench_Context* ctx)
+{
+    size_t n = bench_scaled(ctx, SMALL_N * SCATTER_STRIDE);
+    size_t removed = (n + SCATTER_STRIDE - 1) / SCATTER_STRIDE;
+    bench_run(ctx, SUITE, "remove_scattered", "remove", sizeof(int64_t), n, removed, scatteredRemove, &n);
+    bench_run(ctx, SUITE, "remove_scattered", "remove_ranges", sizeof(int64_t), n, removed, scatteredRemoveRanges,
+        &n);
+    bench_run(ctx, SUITE, "remove_scattered", "erase_if", sizeof(int64_t), n, removed, scatteredEraseIf, &n);
+    bench_run(ctx, SUITE, "remove_scattered", "swap_remove", sizeof(int64_t), n, removed, scatteredSwapRemove, &n);
+}
+
+void bench_dynArray(struct bench_Context* ctx)
+{
+    runBenchmarks(ctx, "void", sizeof(int32_t), &voidBenchmarks_i32);
+    runBenchmarks(ctx, "generic", sizeof(int32_t), &genericBenchmarks_i32);
+    runBenchmarks(ctx, "void", sizeof(int64_t), &voidBenchmarks_i64);
+    runBenchmarks(ctx, "generic", sizeof(int64_t), &genericBenchmarks_i64);
+    runBenchmarks(ctx, "void", sizeof(struct Elem16), &voidBenchmarks_e16);
+    runBenchmarks(ctx, "generic", sizeof(struct Elem16), &genericBenchmarks_e16);
+    runBenchmarks(ctx, "void", sizeof(struct Elem64), &voidBenchmarks_e64);
+    runBenchmarks(ctx, "generic", sizeof(struct Elem64), &genericBenchmarks_e64);
+    runScatteredBenchmarks(ctx);
+}
@@ -0,0 +1,137 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "cutils/data_structures/dyn_array.h"
+#include "cutils/data_structures/dyn_array_file.h"
+#include "bench.h"
+
+#define SUITE "dyn_array_file"
+#define N ((size_t)1 << 22)
+
+struct Record
+{
+    int64_t key, value;
+};
+
+struct Args
+{
+    struct ctls_DynArray arr;
+    // The same records, saved by `ctls_dyn_save()` and as a size, a capacity, and the raw elements.
+    const char* savedPath;
+    const char* rawPath;
+};
+
+// The ad-hoc format this file replaces. Like `ctls_dyn_save()`, it waits for the file to reach the disk.
+static bool saveRaw(const struct ctls_DynArray* arr, const char* path)
+{
+    FILE* file = fopen(path, "wb");
+    if (!file)
+        return false;
+    bool success = fwrite(&arr->size, sizeof arr->size, 1, file) == 1
+        && fwrite(&arr->capacity, sizeof arr->capacity, 1, file) == 1
+        && fwrite(arr->data, sizeof(struct Record), arr->size, file) == arr->size && !fflush(file)
+        && !fsync(fileno(file));
+    return !fclose(file) && success;
+}
+
+static double saveFwrite(void* arg)
+{
+    struct Args* args = arg;
+    double start = bench_now();
+    saveRaw(&args->arr, args->rawPath);
+    return bench_now() - start;
+}
+
+static double saveWritev(void* arg)
+{
+    struct Args* args = arg;
+    double start = bench_now();
+    ctls_dyn_save(&args->arr, args->savedPath, sizeof(struct Record), 0);
+    return bench_now() - start;
+}
+
+static double startupReadCopy(void* arg)
+{
+    struct Args* args = arg;
+    FILE* file = fopen(args->rawPath, "rb");
+    if (!file)
+        return 0;
+    struct ctls_DynArray arr = {0};
+    size_t size, capacity;
+    double start = bench_now();
+    if (fread(&size, sizeof size, 1, file) == 1 && fread(&capacity, sizeof capacity, 1, file) == 1
+        && ctls_dyn_init(&arr, capacity, sizeof(struct Record)))
+    {
+        arr.size = fread(arr.data, sizeof(struct Record), size, file);
+    }
+    double elapsed = bench_now() - start;
+    bench_consume(arr.data);
+    if (arr.data)
+        ctls_dyn_reset(&arr, sizeof(struct Record));
+    fclose(file);
+    return elapsed;
+}
+
+static double startupView(struct Args* args, bool verify)
+{
+    struct ctls_DynArrayView view;
+    double start = bench_now();
+    if (!ctls_dyn_openView(&view, args->savedPath, sizeof(struct Record)))
+        return 0;
+    bool valid = !verify || ctls_dyn_verifyView(&view);
+    double elapsed = bench_now() - start;
+    bench_consume(&valid);
+    ctls_dyn_closeView(&view);
+    return elapsed;
+}
+
+static double startupMapView(void* arg)
+{
+    return startupView(arg, false);
+}
+
+static double startupMapViewVerify(void* arg)
+{
+    return startupView(arg, true);
+}
+
+static bool makeTemporary(char* path)
+{
+    int fd = mkstemp(path);
+    return fd != -1 && !close(fd);
+}
+
+void bench_dynArrayFile(struct bench_Context* ctx)
+{
+    const char* dir = getenv("TMPDIR") ? getenv("TMPDIR") : "/tmp";
+    char savedPath[4096], rawPath[4096];
+    snprintf(savedPath, sizeof savedPath, "%s/cutils_bench_saved_XXXXXX", dir);
+    snprintf(rawPath, sizeof rawPath, "%s/cutils_bench_raw_XXXXXX", dir);
+    size_t n = bench_scaled(ctx, N);
+    struct Args args = {.savedPath = savedPath, .rawPath = rawPath};
+    if (!makeTemporary(savedPath))
+        return;
+    if (makeTemporary(rawPath))
+    {
+        if (ctls_dyn_init(&args.arr, n, sizeof(struct Record)))
+        {
+            for (size_t i = 0; i < n; ++i)
+                ctls_dyn_append(&args.arr, &(struct Record){(int64_t)i, (int64_t)i}, sizeof(struct Record));
+            // Each save leaves its file behind for the startup benchmarks.
+            bench_run(ctx, SUITE, "save", "fwrite", sizeof(struct Record), n, n, saveFwrite, &args);
+            bench_run(ctx, SUITE, "save", "writev", sizeof(struct Record), n, n, saveWritev, &args);
+            bench_run(ctx, SUITE, "startup", "read_copy", sizeof(struct Record), n, 1, startupReadCopy, &args);
+            bench_run(ctx, SUITE, "startup", "map_view", sizeof(struct Record), n, 1, startupMapView, &args);
+            bench_run(ctx, SUITE, "startup", "map_view_verify", sizeof(struct Record), n, 1, startupMapViewVerify,
+                &args);
+            ctls_dyn_reset(&args.arr, sizeof(struct Record));
+        }
+        unlink(rawPath);
+    }
+    unlink(savedPath);
+}
@@ -0,0 +1,266 @@
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "cutils/data_structures/hash_map_g.h"
+#include "bench.h"
+
+#define SUITE "hash_map"
+#define N ((size_t)1 << 20)
+
+#define HASH_U64(key) ctls_hmap_hashInt(key)
+#define EQ_U64(a, b) ((a) == (b))
+
+CTLS_HASH_MAP(uint64_t, uint64_t, benchU64, HASH_U64, EQ_U64)
+
+// The baseline is the textbook separately chained table: one heap node per entry, and a power-of-two bucket array that
+// doubles once the load factor reaches 1.
+
+struct Node
+{
+    struct Node* next;
+    uint64_t key;
+    uint64_t value;
+};
+
+struct Chained
+{
+    struct Node** buckets;
+    size_t size;
+    size_t bucketCount;
+};
+
+static bool chainedRehash(struct Chained* table, size_t bucketCount)
+{
+    struct Node** buckets = calloc(bucketCount, sizeof(struct Node*));
+    if (!buckets)
+        return false;
+    for (size_t i = 0; i < table->bucketCount; ++i)
+    {
+        for (struct Node *node = table->buckets[i], *next; node; node = next)
+        {
+            next = node->next;
+            struct Node** bucket = &buckets[ctls_hmap_hashInt(node->key) & (bucketCount - 1)];
+            node->next = *bucket, *bucket = node;
+        }
+    }
+    free(table->buckets);
+    table->buckets = buckets, table->bucketCount = bucketCount;
+    return true;
+}
+
+static uint64_t* chainedFind(const struct Chained* table, uint64_t key)
+{
+    if (!table->bucketCount)
+        return NULL;
+    for (struct Node* node = table->buckets[ctls_hmap_hashInt(key) & (table->bucketCount - 1)]; node; node = node->next)
+    {
+        if (node->key == key)
+            return &node->value;
+    }
+    return NULL;
+}
+
+static bool chainedInsert(struct Chained* table, uint64_t key, uint64_t value)
+{
+    uint64_t* existing = chainedFind(table, key);
+    if (existing)
+        return *existing = value, true;
+    if (table->size == table->bucketCount && !chainedRehash(table, table->bucketCount ? table->bucketCount * 2 : 16))
+        return false;
+    struct Node* node = malloc(sizeof(struct Node));
+    if (!node)
+        return false;
+    struct Node** bucket = &table->buckets[ctls_hmap_hashInt(key) & (table->bucketCount - 1)];
+    *node = (struct Node){.next = *bucket, .key = key, .value = value};
+    *bucket = node, ++table->size;
+    return true;
+}
+
+static bool chainedErase(struct Chained* table, uint64_t key)
+{
+    if (!table->bucketCount)
+        return false;
+    for (struct Node** link = &table->buckets[ctls_hmap_hashInt(key) & (table->bucketCount - 1)]; *link;
+        link = &(*link)->next)
+    {
+        if ((*link)->key == key)
+        {
+            struct Node* node = *link;
+            *link = node->next, --table->size;
+            free(node);
+            return true;
+        }
+    }
+    return false;
+}
+
+static void chainedReset(struct Chained* table)
+{
+    for (size_t i = 0; i < table->bucketCount; ++i)
+    {
+        for (struct Node *node = table->buckets[i], *next; node; node = next)
+            next = node->next, free(node);
+    }
+    free(table->buckets);
+    *table = (struct Chained){0};
+}
+
+struct Args
+{
+    size_t n;
+    uint64_t* keys;
+    uint64_t* missingKeys;
+    struct Chained chained;
+    struct ctls_HashMap_benchU64 swiss;
+};
+
+static uint64_t splitmix64(uint64_t* state)
+{
+    uint64_t z = (*state += 0x9E3779B97F4A7C15u);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9u;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBu;
+    return z ^ (z >> 31);
+}
+
+// Insertion starts from an empty table every time, so that growth is part of what is measured.
+static double insertChained(void* arg)
+{
+    struct Args* args = arg;
+    chainedReset(&args->chained);
+    double start = bench_now();
+    for (size_t i = 0; i < args->n; ++i)
+        chainedInsert(&args->chained, args->keys[i], i);
+    double elapsed = bench_now() - start;
+    bench_consume(&args->chained.size);
+    return elapsed;
+}
+
+static double insertSwiss(void* arg)
+{
+    struct Args* args = arg;
+    ctls_hmap_reset_benchU64(&args->swiss);
+    ctls_hmap_init_benchU64(&args->swiss);
+    double start = bench_now();
+    for (size_t i = 0; i < args->n; ++i)
+        ctls_hmap_insert_benchU64(&args->swiss, args->keys[i], i);
+    double elapsed = bench_now() - start;
+    bench_consume(&args->swiss.size);
+    return elapsed;
+}
+
+static double lookupChained(const struct Args* args, const uint64_t* keys)
+{
+    uint64_t sum = 0;
+    double start = bench_now();
+    for (size_t i = 0; i < args->n; ++i)
+    {
+        const uint64_t* value = chainedFind(&args->chained, keys[i]);
+        sum += value ? *value : 1;
+    }
+    double elapsed = bench_now() - start;
+    bench_consume(&sum);
+    return elapsed;
+}
+
+static double lookupSwiss(const struct Args* args, const uint64_t* keys)
+{
+    uint64_t sum = 0;
+    double start = bench_now();
+    for (size_t i = 0; i < args->n; ++i)
+    {
+        const uint64_t* value = ctls_hmap_find_benchU64(&args->swiss, keys[i]);
+        sum += value ? *value : 1;
+    }
+    double elapsed = bench_now() - start;
+    bench_consume(&sum);
+    return elapsed;
+}
+
+static double lookupHitChained(void* arg)
+{
+    struct Args* args = arg;
+    return lookupChained(args, args->keys);
+}
+
+static double lookupHitSwiss(void* arg)
+{
+    struct Args* args = arg;
+    return lookupSwiss(args, args->keys);
+}
+
+static double lookupMissChained(void* arg)
+{
+    struct Args* args = arg;
+    return lookupChained(args, args->missingKeys);
+}
+
+static double lookupMissSwiss(void* arg)
+{
+    struct Args* args = arg;
+    return lookupSwiss(args, args->missingKeys);
+}
+
+// Erasure refills the table outside of the timed region.
+static double eraseChained(void* arg)
+{
+    struct Args* args = arg;
+    for (size_t i = 0; i < args->n; ++i)
+        chainedInsert(&args->chained, args->keys[i], i);
+    double start = bench_now();
+    for (size_t i = 0; i < args->n; ++i)
+        chainedErase(&args->chained, args->keys[i]);
+    double elapsed = bench_now() - start;
+    bench_consume(&args->chained.size);
+    return elapsed;
+}
+
+static double eraseSwiss(void* arg)
+{
+    struct Args* args = arg;
+    for (size_t i = 0; i < args->n; ++i)
+        ctls_hmap_insert_benchU64(&args->swiss, args->keys[i], i);
+    double start = bench_now();
+    for (size_t i = 0; i < args->n; ++i)
+        ctls_hmap_erase_benchU64(&args->swiss, args->keys[i]);
+    double elapsed = bench_now() - start;
+    bench_consume(&args->swiss.size);
+    return elapsed;
+}
+
+void bench_hashMap(struct bench_Context* ctx)
+{
+    struct Args args = {.n = bench_scaled(ctx, N)};
+    args.keys = malloc(args.n * sizeof(uint64_t));
+    args.missingKeys = malloc(args.n * sizeof(uint64_t));
+    if (!args.keys || !args.missingKeys || !ctls_hmap_init_benchU64(&args.swiss))
+        goto cleanup;
+    // Present keys are odd and missing keys even, so that a miss can never hit by accident.
+    uint64_t state = 42;
+    for (size_t i = 0; i < args.n; ++i)
+    {
+        args.keys[i] = splitmix64(&state) | 1;
+        args.missingKeys[i] = splitmix64(&state) & ~(uint64_t)1;
+    }
+
+    bench_run(ctx, SUITE, "insert", "chained", sizeof(uint64_t), args.n, args.n, insertChained, &args);
+    bench_run(ctx, SUITE, "insert", "swiss", sizeof(uint64_t), args.n, args.n, insertSwiss, &args);
+    for (size_t i = 0; i < args.n; ++i)
+    {
+        chainedInsert(&args.chained, args.keys[i], i);
+        ctls_hmap_insert_benchU64(&args.swiss, args.keys[i], i);
+    }
+    bench_run(ctx, SUITE, "lookup_hit", "chained", sizeof(uint64_t), args.n, args.n, lookupHitChained, &args);
+    bench_run(ctx, SUITE, "lookup_hit", "swiss", sizeof(uint64_t), args.n, args.n, lookupHitSwiss, &args);
+    bench_run(ctx, SUITE, "lookup_miss", "chained", sizeof(uint64_t), args.n, args.n, lookupMissChained, &args);
+    bench_run(ctx, SUITE, "lookup_miss", "swiss", sizeof(uint64_t), args.n, args.n, lookupMissSwiss, &args);
+    bench_run(ctx, SUITE, "erase", "chained", sizeof(uint64_t), args.n, args.n, eraseChained, &args);
+    bench_run(ctx, SUITE, "erase", "swiss", sizeof(uint64_t), args.n, args.n, eraseSwiss, &args);
+
+cleanup:
+    chainedReset(&args.chained);
+    ctls_hmap_reset_benchU64(&args.swiss);
+    free(args.keys);
+    free(args.missingKeys);
+}
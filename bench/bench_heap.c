@@ -0,0 +1,147 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cutils/data_structures/dyn_array_g.h"
+#include "cutils/data_structures/heap_g.h"
+#include "bench.h"
+
+#define SUITE "heap"
+#define MIN_TIMERS ((size_t)1000)
+#define MAX_TIMERS ((size_t)10000000)
+// A linear scan reads every timer on every tick, so it is given fewer ticks for more timers, but never fewer than this.
+#define MIN_SCAN_TICKS ((size_t)64)
+#define SCAN_READS ((size_t)1 << 24)
+#define HEAP_TICKS ((size_t)1 << 20)
+
+// A timer that fires every `period` ticks, as a scheduler would keep it.
+struct Timer
+{
+    uint64_t deadline;
+    uint32_t id;
+    uint32_t period;
+};
+
+// The heap position of each timer, by id, maintained through index tracking.
+static size_t* timerPositions;
+
+#define EARLIER(a, b) ((a).deadline < (b).deadline)
+#define SET_TIMER_POSITION(timer, index) (timerPositions[(timer).id] = (index))
+
+CTLS_DYN_ARRAY(struct Timer, benchTimer)
+CTLS_HEAP_INDEXED(struct Timer, benchTimer, EARLIER, SET_TIMER_POSITION)
+
+struct Args
+{
+    struct ctls_DynArray_benchTimer timers;
+    // The timers in their original order, which `heapify` starts from each time.
+    struct Timer* initial;
+    size_t ticks;
+};
+
+// Fires the earliest timer and rearms it, finding it by scanning every timer, as the scheduler used to.
+static double tickScan(void* arg)
+{
+    struct Args* args = arg;
+    struct Timer* timers = args->timers.data;
+    size_t n = args->timers.size;
+    double start = bench_now();
+    for (size_t tick = 0; tick < args->ticks; ++tick)
+    {
+        size_t earliest = 0;
+        for (size_t i = 1; i < n; ++i)
+        {
+            if (EARLIER(timers[i], timers[earliest]))
+                earliest = i;
+        }
+        timers[earliest].deadline += timers[earliest].period;
+    }
+    double elapsed = bench_now() - start;
+    bench_consume(timers);
+    return elapsed;
+}
+
+// Fires the timer at the top of the heap and rearms it in place.
+static double tickHeap(void* arg)
+{
+    struct Args* args = arg;
+    double start = bench_now();
+    for (size_t tick = 0; tick < args->ticks; ++tick)
+    {
+        args->timers.data[0].deadline += args->timers.data[0].period;
+        ctls_heap_update_benchTimer(&args->timers, 0);
+    }
+    double elapsed = bench_now() - start;
+    bench_consume(args->timers.data);
+    return elapsed;
+}
+
+// Cancels a pseudo-random timer through its tracked position and schedules it again.
+static double rescheduleHeap(void* arg)
+{
+    struct Args* args = arg;
+    uint64_t state = 0x2545F4914F6CDD1Du;
+    double start = bench_now();
+    for (size_t tick = 0; tick < args->ticks; ++tick)
+    {
+        state ^= state << 13, state ^= state >> 7, state ^= state << 17;
+        uint32_t id = (uint32_t)(state % args->timers.size);
+        struct Timer timer = ctls_heap_removeAt_benchTimer(&args->timers, timerPositions[id]);
+        timer.deadline += timer.period / 2;
+        ctls_heap_push_benchTimer(&args->timers, timer);
+    }
+    double elapsed = bench_now() - start;
+    bench_consume(args->timers.data);
+    return elapsed;
+}
+
+static double heapify(void* arg)
+{
+    struct Args* args = arg;
+    memcpy(args->timers.data, args->initial, args->timers.size * sizeof(struct Timer));
+    double start = bench_now();
+    ctls_heap_heapify_benchTimer(&args->timers);
+    double elapsed = bench_now() - start;
+    bench_consume(args->timers.data);
+    return elapsed;
+}
+
+void bench_heap(struct bench_Context* ctx)
+{
+    for (size_t count = MIN_TIMERS; count <= MAX_TIMERS; count *= 10)
+    {
+        size_t n = bench_scaled(ctx, count);
+        struct Args args = {0};
+        timerPositions = malloc(n * sizeof(size_t));
+        args.initial = malloc(n * sizeof(struct Timer));
+        if (!timerPositions || !args.initial || !ctls_dyn_init_benchTimer(&args.timers, n))
+        {
+            free(timerPositions);
+            free(args.initial);
+            return;
+        }
+        uint64_t state = 0x9E3779B97F4A7C15u;
+        for (size_t i = 0; i < n; ++i)
+        {
+            state ^= state << 13, state ^= state >> 7, state ^= state << 17;
+            uint32_t period = (uint32_t)(state % 1000000) + 1;
+            args.initial[i] = (struct Timer){state % period, (uint32_t)i, period};
+        }
+        ctls_dyn_extend_benchTimer(&args.timers, args.initial, n);
+
+        args.ticks = SCAN_READS / n > MIN_SCAN_TICKS ? SCAN_READS / n : MIN_SCAN_TICKS;
+        bench_run(ctx, SUITE, "tick", "linear_scan", sizeof(struct Timer), n, args.ticks, tickScan, &args);
+        bench_run(ctx, SUITE, "heapify", "heap4", sizeof(struct Timer), n, n, heapify, &args);
+        // Makes the timers a heap even if `heapify` was filtered out.
+        ctls_heap_heapify_benchTimer(&args.timers);
+        args.ticks = HEAP_TICKS;
+        bench_run(ctx, SUITE, "tick", "heap4", sizeof(struct Timer), n, args.ticks, tickHeap, &args);
+        bench_run(ctx, SUITE, "reschedule", "heap4", sizeof(struct Timer), n, args.ticks, rescheduleHeap, &args);
+
+        ctls_dyn_reset_benchTimer(&args.timers);
+        free(args.initial);
+        free(timerPositions);
+        timerPositions = NULL;
+    }
+}
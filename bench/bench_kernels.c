@@ -0,0 +1,181 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "cutils/simd/kernels.h"
+#include "bench.h"
+
+#define SUITE "kernels"
+// Large enough that the arrays do not fit in cache, so that the vector kernels are measured against memory bandwidth.
+#define N ((size_t)1 << 23)
+
+struct Args
+{
+    void* data;
+    size_t n;
+};
+
+static const char* const levelNames[] = {"scalar", "sse2", "avx2"};
+
+// The hand-written loops are what callers wrote before the kernels existed. They are compiled with the same flags as
+// the rest of the suite, so the compiler is free to vectorize them for the baseline instruction set.
+#define DEFINE_KERNEL_BENCHMARKS(type, suffix, sumType) \
+\
+static double findLoop_##suffix(void* arg) \
+{ \
+    const struct Args* args = arg; \
+    const type* data = args->data; \
+    double start = bench_now(); \
+    size_t i = 0; \
+    while (i < args->n && data[i] != (type)-1) \
+        ++i; \
+    double elapsed = bench_now() - start; \
+    bench_consume(&i); \
+    return elapsed; \
+} \
+\
+static double findKernel_##suffix(void* arg) \
+{ \
+    const struct Args* args = arg; \
+    double start = bench_now(); \
+    size_t i = ctls_simd_find_##suffix(args->data, args->n, (type)-1); \
+    double elapsed = bench_now() - start; \
+    bench_consume(&i); \
+    return elapsed; \
+} \
+\
+static double countLoop_##suffix(void* arg) \
+{ \
+    const struct Args* args = arg; \
+    const type* data = args->data; \
+    double start = bench_now(); \
+    size_t count = 0; \
+    for (size_t i = 0; i < args->n; ++i) \
+        count += data[i] == (type)7; \
+    double elapsed = bench_now() - start; \
+    bench_consume(&count); \
+    return elapsed; \
+} \
+\
+static double countKernel_##suffix(void* arg) \
+{ \
+    const struct Args* args = arg; \
+    double start = bench_now(); \
+    size_t count = ctls_simd_count_##suffix(args->data, args->n, (type)7); \
+    double elapsed = bench_now() - start; \
+    bench_consume(&count); \
+    return elapsed; \
+} \
+\
+static double fillLoop_##suffix(void* arg) \
+{ \
+    const struct Args* args = arg; \
+    type* data = args->data; \
+    double start = bench_now(); \
+    for (size_t i = 0; i < args->n; ++i) \
+        data[i] = (type)3; \
+    double elapsed = bench_now() - start; \
+    bench_consume(data); \
+    return elapsed; \
+} \
+\
+static double fillKernel_##suffix(void* arg) \
+{ \
+    const struct Args* args = arg; \
+    double start = bench_now(); \
+    ctls_simd_fill_##suffix(args->data, args->n, (type)3); \
+    double elapsed = bench_now() - start; \
+    bench_consume(args->data); \
+    return elapsed; \
+} \
+\
+static double sumLoop_##suffix(void* arg) \
+{ \
+    const struct Args* args = arg; \
+    const type* data = args->data; \
+    double start = bench_now(); \
+    sumType sum = 0; \
+    for (size_t i = 0; i < args->n; ++i) \
+        sum += data[i]; \
+    double elapsed = bench_now() - start; \
+    bench_consume(&sum); \
+    return elapsed; \
+} \
+\
+static double sumKernel_##suffix(void* arg) \
+{ \
+    const struct Args* args = arg; \
+    double start = bench_now(); \
+    sumType sum = ctls_simd_sum_##suffix(args->data, args->n); \
+    double elapsed = bench_now() - start; \
+    bench_consume(&sum); \
+    return elapsed; \
+} \
+\
+static double maxLoop_##suffix(void* arg) \
+{ \
+    const struct Args* args = arg; \
+    const type* data = args->data; \
+    double start = bench_now(); \
+    type max = data[0]; \
+    for (size_t i = 1; i < args->n; ++i) \
+        max = data[i] > max ? data[i] : max; \
+    double elapsed = bench_now() - start; \
+    bench_consume(&max); \
+    return elapsed; \
+} \
+\
+static double maxKernel_##suffix(void* arg) \
+{ \
+    const struct Args* args = arg; \
+    double start = bench_now(); \
+    type max = ctls_simd_max_##suffix(args->data, args->n); \
+    double elapsed = bench_now() - start; \
+    bench_consume(&max); \
+    return elapsed; \
+} \
+\
+static void run_##suffix(struct bench_Context* ctx) \
+{ \
+    struct Args args = {NULL, bench_scaled(ctx, N)}; \
+    type* data = malloc(args.n * sizeof(type)); \
+    if (!data) \
+        return; \
+    for (size_t i = 0; i < args.n; ++i) \
+        data[i] = (type)(i % 1000); \
+    args.data = data; \
+    static const struct \
+    { \
+        const char* name; \
+        double (*loop)(void* arg); \
+        double (*kernel)(void* arg); \
+    } benchmarks[] = { \
+        {"find", findLoop_##suffix, findKernel_##suffix}, \
+        {"count", countLoop_##suffix, countKernel_##suffix}, \
+        {"sum", sumLoop_##suffix, sumKernel_##suffix}, \
+        {"max", maxLoop_##suffix, maxKernel_##suffix}, \
+        {"fill", fillLoop_##suffix, fillKernel_##suffix}, \
+    }; \
+    enum ctls_SimdLevel supported = ctls_simd_level(); \
+    for (size_t i = 0; i < sizeof benchmarks / sizeof *benchmarks; ++i) \
+    { \
+        bench_run(ctx, SUITE, benchmarks[i].name, "loop", sizeof(type), args.n, args.n, benchmarks[i].loop, &args); \
+        for (int level = CTLS_SIMD_SCALAR; level <= (int)supported; ++level) \
+        { \
+            ctls_simd_setLevel(level); \
+            bench_run(ctx, SUITE, benchmarks[i].name, levelNames[level], sizeof(type), args.n, args.n, \
+                benchmarks[i].kernel, &args); \
+        } \
+        ctls_simd_setLevel(supported); \
+    } \
+    free(data); \
+}
+
+DEFINE_KERNEL_BENCHMARKS(int32_t, i32, int64_t)
+DEFINE_KERNEL_BENCHMARKS(double, f64, double)
+
+void bench_kernels(struct bench_Context* ctx)
+{
+    run_i32(ctx);
+    run_f64(ctx);
+}
@@ -0,0 +1,135 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "cutils/data_structures/dyn_array.h"
+#include "cutils/data_structures/mapped_dyn_array.h"
+#include "bench.h"
+
+#define SUITE "mapped_dyn_array"
+#define N ((size_t)1 << 22)
+#define READ_BATCH 4096
+
+struct Record
+{
+    int64_t key, value;
+};
+
+struct Args
+{
+    size_t n;
+    // A file that holds `n` records, both as a mapped dynamic array and as a plain sequence of records.
+    const char* mappedPath;
+    const char* plainPath;
+};
+
+static double appendDyn(void* arg)
+{
+    const struct Args* args = arg;
+    struct ctls_DynArray arr = {0};
+    double start = bench_now();
+    ctls_dyn_defaultInit(&arr, sizeof(struct Record));
+    for (size_t i = 0; i < args->n; ++i)
+        ctls_dyn_append(&arr, &(struct Record){(int64_t)i, (int64_t)i}, sizeof(struct Record));
+    double elapsed = bench_now() - start;
+    bench_consume(arr.data);
+    ctls_dyn_reset(&arr, sizeof(struct Record));
+    return elapsed;
+}
+
+static double appendMapped(void* arg)
+{
+    const struct Args* args = arg;
+    struct ctls_MappedDynArray arr;
+    unlink(args->mappedPath);
+    double start = bench_now();
+    if (!ctls_mdyn_open(&arr, args->mappedPath, sizeof(struct Record), 8))
+        return 0;
+    for (size_t i = 0; i < args->n; ++i)
+        ctls_mdyn_append(&arr, &(struct Record){(int64_t)i, (int64_t)i});
+    double elapsed = bench_now() - start;
+    bench_consume(arr.data);
+    ctls_mdyn_close(&arr);
+    return elapsed;
+}
+
+// Rebuilds an array from a file of records, which is what a process has to do on startup without a file-backed array.
+static double startupRebuild(void* arg)
+{
+    const struct Args* args = arg;
+    struct Record* batch = malloc(READ_BATCH * sizeof(struct Record));
+    FILE* file = fopen(args->plainPath, "rb");
+    struct ctls_DynArray arr = {0};
+    double start = bench_now();
+    ctls_dyn_defaultInit(&arr, sizeof(struct Record));
+    for (size_t read; file && (read = fread(batch, sizeof(struct Record), READ_BATCH, file));)
+    {
+        for (size_t i = 0; i < read; ++i)
+            ctls_dyn_append(&arr, &batch[i], sizeof(struct Record));
+    }
+    double elapsed = bench_now() - start;
+    bench_consume(arr.data);
+    ctls_dyn_reset(&arr, sizeof(struct Record));
+    if (file)
+        fclose(file);
+    free(batch);
+    return elapsed;
+}
+
+static double startupReopen(void* arg)
+{
+    const struct Args* args = arg;
+    struct ctls_MappedDynArray arr;
+    double start = bench_now();
+    if (!ctls_mdyn_open(&arr, args->mappedPath, sizeof(struct Record), 8))
+        return 0;
+    double elapsed = bench_now() - start;
+    bench_consume(arr.data);
+    ctls_mdyn_close(&arr);
+    return elapsed;
+}
+
+static bool writePlain(const struct Args* args)
+{
+    FILE* file = fopen(args->plainPath, "wb");
+    if (!file)
+        return false;
+    bool success = true;
+    for (size_t i = 0; i < args->n && success; ++i)
+        success = fwrite(&(struct Record){(int64_t)i, (int64_t)i}, sizeof(struct Record), 1, file) == 1;
+    return !fclose(file) && success;
+}
+
+static bool makeTemporary(char* path)
+{
+    int fd = mkstemp(path);
+    return fd != -1 && !close(fd);
+}
+
+void bench_mappedDynArray(struct bench_Context* ctx)
+{
+    const char* dir = getenv("TMPDIR") ? getenv("TMPDIR") : "/tmp";
+    char mappedPath[4096], plainPath[4096];
+    snprintf(mappedPath, sizeof mappedPath, "%s/cutils_bench_mapped_XXXXXX", dir);
+    snprintf(plainPath, sizeof plainPath, "%s/cutils_bench_plain_XXXXXX", dir);
+    if (!makeTemporary(mappedPath))
+        return;
+    struct Args args = {bench_scaled(ctx, N), mappedPath, plainPath};
+    if (makeTemporary(plainPath))
+    {
+        bench_run(ctx, SUITE, "append", "dyn", sizeof(struct Record), args.n, args.n, appendDyn, &args);
+        // Leaves a file of `n` records behind for the startup benchmarks.
+        bench_run(ctx, SUITE, "append", "mapped", sizeof(struct Record), args.n, args.n, appendMapped, &args);
+        if (writePlain(&args))
+        {
+            bench_run(ctx, SUITE, "startup", "rebuild", sizeof(struct Record), args.n, 1, startupRebuild, &args);
+            bench_run(ctx, SUITE, "startup", "reopen", sizeof(struct Record), args.n, 1, startupReopen, &args);
+        }
+        unlink(plainPath);
+    }
+    unlink(mappedPath);
+}
@@ -0,0 +1,143 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "cutils/data_structures/dyn_array_g.h"
+#include "cutils/data_structures/seg_array_g.h"
+#include "bench.h"
+
+#define SUITE "seg_array"
+#define N ((size_t)1 << 22)
+
+CTLS_DYN_ARRAY(int64_t, benchSeg)
+CTLS_SEG_ARRAY(int64_t, benchSeg)
+
+struct Args
+{
+    size_t n;
+    // Filled with `n` elements for the read benchmarks.
+    struct ctls_DynArray_benchSeg dyn;
+    struct ctls_SegArray_benchSeg seg;
+};
+
+static double appendDyn(void* arg)
+{
+    struct Args* args = arg;
+    struct ctls_DynArray_benchSeg arr = {0};
+    double start = bench_now();
+    ctls_dyn_defaultInit_benchSeg(&arr);
+    for (size_t i = 0; i < args->n; ++i)
+        ctls_dyn_append_benchSeg(&arr, (int64_t)i);
+    double elapsed = bench_now() - start;
+    bench_consume(arr.data);
+    ctls_dyn_reset_benchSeg(&arr);
+    return elapsed;
+}
+
+static double appendSeg(void* arg)
+{
+    struct Args* args = arg;
+    struct ctls_SegArray_benchSeg arr = {0};
+    double start = bench_now();
+    ctls_seg_defaultInit_benchSeg(&arr);
+    for (size_t i = 0; i < args->n; ++i)
+        ctls_seg_append_benchSeg(&arr, (int64_t)i);
+    double elapsed = bench_now() - start;
+    bench_consume(arr.segments[0]);
+    ctls_seg_reset_benchSeg(&arr);
+    return elapsed;
+}
+
+// Reads the elements at pseudo-random indices, which costs the segmented array a segment lookup per read.
+static double randomReadDyn(void* arg)
+{
+    struct Args* args = arg;
+    uint64_t state = 0x2545F4914F6CDD1Du;
+    int64_t sum = 0;
+    double start = bench_now();
+    for (size_t i = 0; i < args->n; ++i)
+    {
+        state ^= state << 13, state ^= state >> 7, state ^= state << 17;
+        sum += args->dyn.data[state % args->n];
+    }
+    double elapsed = bench_now() - start;
+    bench_consume(&sum);
+    return elapsed;
+}
+
+static double randomReadSeg(void* arg)
+{
+    struct Args* args = arg;
+    uint64_t state = 0x2545F4914F6CDD1Du;
+    int64_t sum = 0;
+    double start = bench_now();
+    for (size_t i = 0; i < args->n; ++i)
+    {
+        state ^= state << 13, state ^= state >> 7, state ^= state << 17;
+        sum += *ctls_seg_at_benchSeg(&args->seg, state % args->n);
+    }
+    double elapsed = bench_now() - start;
+    bench_consume(&sum);
+    return elapsed;
+}
+
+// Times every append individually. Reallocations make a few of the dynamic array's appends copy the whole array,
+// which the median hides, but the tail does not.
+static void appendLatency(struct bench_Context* ctx, struct Args* args, bool segmented)
+{
+    const char* variant = segmented ? "seg" : "dyn";
+    if (!bench_enabled(ctx, SUITE, "append_latency", variant))
+        return;
+    double* latencies = malloc(args->n * sizeof(double));
+    if (!latencies)
+        return;
+    struct ctls_DynArray_benchSeg dyn = {0};
+    struct ctls_SegArray_benchSeg seg = {0};
+    if (segmented ? !ctls_seg_defaultInit_benchSeg(&seg) : !ctls_dyn_defaultInit_benchSeg(&dyn))
+    {
+        free(latencies);
+        return;
+    }
+    for (size_t i = 0; i < args->n; ++i)
+    {
+        double start = bench_now();
+        if (segmented)
+            ctls_seg_append_benchSeg(&seg, (int64_t)i);
+        else
+            ctls_dyn_append_benchSeg(&dyn, (int64_t)i);
+        latencies[i] = bench_now() - start;
+    }
+    bench_reportPercentiles(ctx, SUITE, "append_latency", variant, sizeof(int64_t), args->n, latencies, args->n);
+    if (segmented)
+        ctls_seg_reset_benchSeg(&seg);
+    else
+        ctls_dyn_reset_benchSeg(&dyn);
+    free(latencies);
+}
+
+void bench_segArray(struct bench_Context* ctx)
+{
+    struct Args args = {.n = bench_scaled(ctx, N)};
+    if (!ctls_dyn_init_benchSeg(&args.dyn, args.n))
+        return;
+    if (!ctls_seg_init_benchSeg(&args.seg, args.n))
+    {
+        ctls_dyn_reset_benchSeg(&args.dyn);
+        return;
+    }
+    for (size_t i = 0; i < args.n; ++i)
+    {
+        ctls_dyn_append_benchSeg(&args.dyn, (int64_t)i);
+        ctls_seg_append_benchSeg(&args.seg, (int64_t)i);
+    }
+
+    bench_run(ctx, SUITE, "append", "dyn", sizeof(int64_t), args.n, args.n, appendDyn, &args);
+    bench_run(ctx, SUITE, "append", "seg", sizeof(int64_t), args.n, args.n, appendSeg, &args);
+    appendLatency(ctx, &args, false);
+    appendLatency(ctx, &args, true);
+    bench_run(ctx, SUITE, "random_read", "dyn", sizeof(int64_t), args.n, args.n, randomReadDyn, &args);
+    bench_run(ctx, SUITE, "random_read", "seg", sizeof(int64_t), args.n, args.n, randomReadSeg, &args);
+
+    ctls_seg_reset_benchSeg(&args.seg);
+    ctls_dyn_reset_benchSeg(&args.dyn);
+}
@@ -0,0 +1,71 @@
+#include <stddef.h>
+#include <stdint.h>
+
+#include "cutils/data_structures/dyn_array_g.h"
+#include "cutils/data_structures/small_dyn_array_g.h"
+#include "bench.h"
+
+#define SUITE "small_dyn_array"
+#define ARRAYS ((size_t)1 << 18)
+#define INLINE_CAPACITY 8
+
+CTLS_DYN_ARRAY(int32_t, int32)
+CTLS_SMALL_DYN_ARRAY(int32_t, int32, INLINE_CAPACITY)
+
+struct Args
+{
+    size_t arrays;
+    size_t elems;
+};
+
+// Builds, sums, and destroys many short-lived arrays, which is the pattern small dynamic arrays are designed for.
+static double buildDyn(void* arg)
+{
+    const struct Args* args = arg;
+    int64_t sum = 0;
+    double start = bench_now();
+    for (size_t i = 0; i < args->arrays; ++i)
+    {
+        struct ctls_DynArray_int32 arr = {0};
+        ctls_dyn_defaultInit_int32(&arr);
+        for (size_t j = 0; j < args->elems; ++j)
+            ctls_dyn_append_int32(&arr, (int32_t)(i + j));
+        for (size_t j = 0; j < arr.size; ++j)
+            sum += arr.data[j];
+        ctls_dyn_reset_int32(&arr);
+    }
+    double elapsed = bench_now() - start;
+    bench_consume(&sum);
+    return elapsed;
+}
+
+static double buildSmall(void* arg)
+{
+    const struct Args* args = arg;
+    int64_t sum = 0;
+    double start = bench_now();
+    for (size_t i = 0; i < args->arrays; ++i)
+    {
+        struct ctls_SmallDynArray_int32 arr;
+        ctls_sdyn_init_int32(&arr);
+        for (size_t j = 0; j < args->elems; ++j)
+            ctls_sdyn_append_int32(&arr, (int32_t)(i + j));
+        for (size_t j = 0; j < arr.size; ++j)
+            sum += arr.data[j];
+        ctls_sdyn_reset_int32(&arr);
+    }
+    double elapsed = bench_now() - start;
+    bench_consume(&sum);
+    return elapsed;
+}
+
+void bench_smallDynArray(struct bench_Context* ctx)
+{
+    static const size_t elemCounts[] = {1, 4, INLINE_CAPACITY, 4 * INLINE_CAPACITY};
+    for (size_t i = 0; i < sizeof elemCounts / sizeof *elemCounts; ++i)
+    {
+        struct Args args = {bench_scaled(ctx, ARRAYS), elemCounts[i]};
+        bench_run(ctx, SUITE, "build", "dyn", sizeof(int32_t), args.elems, args.arrays, buildDyn, &args);
+        bench_run(ctx, SUITE, "build", "small", sizeof(int32_t), args.elems, args.arrays, buildSmall, &args);
+    }
+}
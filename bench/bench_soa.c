@@ -0,0 +1,122 @@
+#include <stddef.h>
+#include <stdint.h>
+
+#include "cutils/data_structures/dyn_array_g.h"
+#include "cutils/data_structures/soa_g.h"
+#include "bench.h"
+
+#define SUITE "soa"
+#define N ((size_t)1 << 20)
+#define STEPS 16
+
+#define PARTICLE_FIELDS(X) \
+    X(float, x) \
+    X(float, y) \
+    X(float, z) \
+    X(float, vx) \
+    X(float, vy) \
+    X(float, vz) \
+    X(float, mass) \
+    X(uint32_t, id)
+
+// The array-of-structs baseline stores the SoA container's own row struct.
+CTLS_SOA(PARTICLE_FIELDS, benchParticle)
+CTLS_DYN_ARRAY(struct ctls_SoaRow_benchParticle, benchParticle)
+
+struct Args
+{
+    size_t n;
+    struct ctls_DynArray_benchParticle aos;
+    struct ctls_Soa_benchParticle soa;
+};
+
+static struct ctls_SoaRow_benchParticle makeRow(size_t i)
+{
+    return (struct ctls_SoaRow_benchParticle){(float)i, 0, 0, 1, 0, 0, 1, (uint32_t)i};
+}
+
+static double appendAos(void* arg)
+{
+    struct Args* args = arg;
+    struct ctls_DynArray_benchParticle arr = {0};
+    ctls_dyn_defaultInit_benchParticle(&arr);
+    double start = bench_now();
+    for (size_t i = 0; i < args->n; ++i)
+        ctls_dyn_append_benchParticle(&arr, makeRow(i));
+    double elapsed = bench_now() - start;
+    bench_consume(arr.data);
+    ctls_dyn_reset_benchParticle(&arr);
+    return elapsed;
+}
+
+static double appendSoa(void* arg)
+{
+    struct Args* args = arg;
+    struct ctls_Soa_benchParticle soa = {0};
+    ctls_soa_defaultInit_benchParticle(&soa);
+    double start = bench_now();
+    for (size_t i = 0; i < args->n; ++i)
+        ctls_soa_append_benchParticle(&soa, makeRow(i));
+    double elapsed = bench_now() - start;
+    bench_consume(soa.x);
+    ctls_soa_reset_benchParticle(&soa);
+    return elapsed;
+}
+
+// The hot loop integrates one coordinate, touching two of the eight members.
+static double integrateAos(void* arg)
+{
+    struct Args* args = arg;
+    struct ctls_SoaRow_benchParticle* particles = args->aos.data;
+    double start = bench_now();
+    for (size_t step = 0; step < STEPS; ++step)
+    {
+        for (size_t i = 0; i < args->n; ++i)
+            particles[i].x += particles[i].vx * 0.01f;
+    }
+    double elapsed = bench_now() - start;
+    bench_consume(particles);
+    return elapsed;
+}
+
+static double integrateSoa(void* arg)
+{
+    struct Args* args = arg;
+    float* restrict x = args->soa.x;
+    const float* restrict vx = args->soa.vx;
+    double start = bench_now();
+    for (size_t step = 0; step < STEPS; ++step)
+    {
+        for (size_t i = 0; i < args->n; ++i)
+            x[i] += vx[i] * 0.01f;
+    }
+    double elapsed = bench_now() - start;
+    bench_consume(x);
+    return elapsed;
+}
+
+void bench_soa(struct bench_Context* ctx)
+{
+    struct Args args = {.n = bench_scaled(ctx, N)};
+    if (!ctls_dyn_init_benchParticle(&args.aos, args.n))
+        return;
+    if (!ctls_soa_init_benchParticle(&args.soa, args.n))
+    {
+        ctls_dyn_reset_benchParticle(&args.aos);
+        return;
+    }
+    for (size_t i = 0; i < args.n; ++i)
+    {
+        ctls_soa_append_benchParticle(&args.soa, makeRow(i));
+        ctls_dyn_append_benchParticle(&args.aos, makeRow(i));
+    }
+
+    size_t elemSize = sizeof(struct ctls_SoaRow_benchParticle);
+    bench_run(ctx, SUITE, "append", "aos", elemSize, args.n, args.n, appendAos, &args);
+    bench_run(ctx, SUITE, "append", "soa", elemSize, args.n, args.n, appendSoa, &args);
+    bench_run(ctx, SUITE, "integrate_x", "aos", elemSize, args.n, args.n * STEPS, integrateAos, &args);
+    bench_run(ctx, SUITE, "integrate_x", "soa", elemSize, args.n, args.n * STEPS, integrateSoa, &args);
+
+    ctls_soa_reset_benchParticle(&args.soa);
+    ctls_dyn_reset_benchParticle(&args.aos);
+}
@@ -0,0 +1,139 @@
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "cutils/data_structures/dyn_array_g.h"
+#include "cutils/data_structures/dyn_array_sort_g.h"
+#include "bench.h"
+
+#define SUITE "sort"
+#define N ((size_t)1 << 20)
+#define THREADS 4
+
+#define LESS_I64(a, b) ((a) < (b))
+#define KEY_I64(x) CTLS_DYN_SIGNED_KEY(uint64_t, x)
+
+CTLS_DYN_ARRAY(int64_t, sortI64)
+CTLS_DYN_ARRAY_SORT(int64_t, sortI64, LESS_I64)
+CTLS_DYN_ARRAY_RADIX_SORT(int64_t, sortI64, uint64_t, KEY_I64)
+
+struct Args
+{
+    const int64_t* input;
+    struct ctls_DynArray_sortI64 arr;
+};
+
+static int compareI64(const void* a, const void* b)
+{
+    int64_t x = *(const int64_t*)a, y = *(const int64_t*)b;
+    return (x > y) - (x < y);
+}
+
+// Every sort starts from the same unsorted input, which is copied in outside of the timed region.
+static double sortWith(struct Args* args, int method)
+{
+    memcpy(args->arr.data, args->input, args->arr.size * sizeof(int64_t));
+    double start = bench_now();
+    switch (method)
+    {
+    case 0:
+        qsort(args->arr.data, args->arr.size, sizeof(int64_t), compareI64);
+        break;
+    case 1:
+        ctls_dyn_sort_sortI64(&args->arr);
+        break;
+    case 2:
+        ctls_dyn_stableSort_sortI64(&args->arr);
+        break;
+    case 3:
+        ctls_dyn_parallelSort_sortI64(&args->arr, THREADS);
+        break;
+    default:
+        ctls_dyn_radixSort_sortI64(&args->arr);
+        break;
+    }
+    double elapsed = bench_now() - start;
+    bench_consume(args->arr.data);
+    return elapsed;
+}
+
+static double sortQsort(void* arg)
+{
+    return sortWith(arg, 0);
+}
+
+static double sortPdq(void* arg)
+{
+    return sortWith(arg, 1);
+}
+
+static double sortStable(void* arg)
+{
+    return sortWith(arg, 2);
+}
+
+static double sortParallel(void* arg)
+{
+    return sortWith(arg, 3);
+}
+
+static double sortRadix(void* arg)
+{
+    return sortWith(arg, 4);
+}
+
+// Lookups search the sorted array for every input element, in input order.
+static double searchBsearch(void* arg)
+{
+    struct Args* args = arg;
+    size_t found = 0;
+    double start = bench_now();
+    for (size_t i = 0; i < args->arr.size; ++i)
+        found += bsearch(&args->input[i], args->arr.data, args->arr.size, sizeof(int64_t), compareI64) != NULL;
+    double elapsed = bench_now() - start;
+    bench_consume(&found);
+    return elapsed;
+}
+
+static double searchLowerBound(void* arg)
+{
+    struct Args* args = arg;
+    size_t found = 0;
+    double start = bench_now();
+    for (size_t i = 0; i < args->arr.size; ++i)
+        found += ctls_dyn_lowerBound_sortI64(&args->arr, args->input[i]);
+    double elapsed = bench_now() - start;
+    bench_consume(&found);
+    return elapsed;
+}
+
+void bench_sort(struct bench_Context* ctx)
+{
+    size_t n = bench_scaled(ctx, N);
+    int64_t* input = malloc(n * sizeof(int64_t));
+    struct Args args = {.input = input};
+    if (!input || !ctls_dyn_init_sortI64(&args.arr, n))
+    {
+        free(input);
+        return;
+    }
+    uint64_t state = 0x2545F4914F6CDD1Du;
+    for (size_t i = 0; i < n; ++i)
+    {
+        state ^= state << 13, state ^= state >> 7, state ^= state << 17;
+        input[i] = (int64_t)state;
+    }
+    args.arr.size = n;
+
+    bench_run(ctx, SUITE, "sort_random", "qsort", sizeof(int64_t), n, n, sortQsort, &args);
+    bench_run(ctx, SUITE, "sort_random", "pdq", sizeof(int64_t), n, n, sortPdq, &args);
+    bench_run(ctx, SUITE, "sort_random", "stable", sizeof(int64_t), n, n, sortStable, &args);
+    bench_run(ctx, SUITE, "sort_random", "parallel_4", sizeof(int64_t), n, n, sortParallel, &args);
+    bench_run(ctx, SUITE, "sort_random", "radix", sizeof(int64_t), n, n, sortRadix, &args);
+    bench_run(ctx, SUITE, "search", "bsearch", sizeof(int64_t), n, n, searchBsearch, &args);
+    bench_run(ctx, SUITE, "search", "lower_bound", sizeof(int64_t), n, n, searchLowerBound, &args);
+
+    ctls_dyn_reset_sortI64(&args.arr);
+    free(input);
+}
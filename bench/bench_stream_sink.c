@@ -0,0 +1,148 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "cutils/data_structures/dyn_array.h"
+#include "cutils/data_structures/stream_sink.h"
+#include "bench.h"
+
+#define SUITE "stream_sink"
+// 64 MiB of records, written in buffers of 512 KiB.
+#define N ((size_t)1 << 22)
+#define BUFFER_CAPACITY ((size_t)1 << 15)
+
+struct Record
+{
+    uint64_t timestamp;
+    uint32_t source;
+    float value;
+};
+
+struct Args
+{
+    size_t n;
+    const char* path;
+    // Whether each buffer must reach the disk before the producer may reuse it.
+    bool durable;
+    // The time each append took, or `NULL` if appends are not timed individually.
+    double* latencies;
+};
+
+static struct Record makeRecord(size_t i)
+{
+    return (struct Record){i, (uint32_t)(i % 64), (float)i};
+}
+
+// Writes the buffered records at the end of the file and empties the buffer, as the producer used to.
+static bool writeOut(int fd, struct ctls_DynArray* arr)
+{
+    const char* bytes = arr->data;
+    size_t len = arr->size * sizeof(struct Record);
+    while (len)
+    {
+        ssize_t written = write(fd, bytes, len);
+        if (written < 0)
+            return false;
+        bytes += written, len -= (size_t)written;
+    }
+    ctls_dyn_remove(arr, 0, arr->size, sizeof(struct Record));
+    return true;
+}
+
+static double streamInline(void* arg)
+{
+    struct Args* args = arg;
+    struct ctls_DynArray arr;
+    int fd = open(args->path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC | (args->durable ? O_DSYNC : 0), 0666);
+    if (fd == -1)
+        return 0;
+    if (!ctls_dyn_init(&arr, BUFFER_CAPACITY, sizeof(struct Record)))
+    {
+        close(fd);
+        return 0;
+    }
+    double start = bench_now();
+    for (size_t i = 0; i < args->n; ++i)
+    {
+        struct Record record = makeRecord(i);
+        double appendStart = args->latencies ? bench_now() : 0;
+        ctls_dyn_append(&arr, &record, sizeof(struct Record));
+        if (arr.size == BUFFER_CAPACITY)
+            writeOut(fd, &arr);
+        if (args->latencies)
+            args->latencies[i] = bench_now() - appendStart;
+    }
+    writeOut(fd, &arr);
+    double elapsed = bench_now() - start;
+    ctls_dyn_reset(&arr, sizeof(struct Record));
+    close(fd);
+    return elapsed;
+}
+
+static double streamSink(void* arg)
+{
+    struct Args* args = arg;
+    struct ctls_StreamSink sink;
+    if (!ctls_sink_open(&sink, args->path, sizeof(struct Record), BUFFER_CAPACITY, args->durable))
+        return 0;
+    double start = bench_now();
+    for (size_t i = 0; i < args->n; ++i)
+    {
+        struct Record record = makeRecord(i);
+        double appendStart = args->latencies ? bench_now() : 0;
+        ctls_sink_append(&sink, &record);
+        if (args->latencies)
+            args->latencies[i] = bench_now() - appendStart;
+    }
+    ctls_sink_flush(&sink);
+    double elapsed = bench_now() - start;
+    ctls_sink_close(&sink);
+    return elapsed;
+}
+
+// Times every append individually. Most appends only copy a record either way; the tail shows the appends that wait
+// for a write.
+static void appendLatency(struct bench_Context* ctx, struct Args* args, const char* benchmark, const char* variant,
+    double (*fn)(void* arg))
+{
+    if (!bench_enabled(ctx, SUITE, benchmark, variant))
+        return;
+    args->latencies = malloc(args->n * sizeof(double));
+    if (!args->latencies)
+        return;
+    fn(args);
+    bench_reportPercentiles(ctx, SUITE, benchmark, variant, sizeof(struct Record), args->n, args->latencies, args->n);
+    free(args->latencies);
+    args->latencies = NULL;
+}
+
+void bench_streamSink(struct bench_Context* ctx)
+{
+    const char* dir = getenv("TMPDIR") ? getenv("TMPDIR") : "/tmp";
+    char path[4096];
+    snprintf(path, sizeof path, "%s/cutils_bench_stream_XXXXXX", dir);
+    int fd = mkstemp(path);
+    if (fd == -1)
+        return;
+    close(fd);
+    struct Args args = {.n = bench_scaled(ctx, N), .path = path};
+
+    // Writes that only reach the page cache, then writes that wait for the disk.
+    for (int durable = 0; durable <= 1; ++durable)
+    {
+        const char* stream = durable ? "stream_durable" : "stream";
+        const char* latency = durable ? "append_latency_durable" : "append_latency";
+        args.durable = durable;
+        bench_run(ctx, SUITE, stream, "inline_write", sizeof(struct Record), args.n, args.n, streamInline, &args);
+        bench_run(ctx, SUITE, stream, "double_buffered", sizeof(struct Record), args.n, args.n, streamSink, &args);
+        appendLatency(ctx, &args, latency, "inline_write", streamInline);
+        appendLatency(ctx, &args, latency, "double_buffered", streamSink);
+    }
+    unlink(path);
+}
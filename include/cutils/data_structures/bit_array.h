@@ -0,0 +1,224 @@
+#ifndef CUTILS_DATA_STRUCTURES_BIT_ARRAY_H_10162026
+#define CUTILS_DATA_STRUCTURES_BIT_ARRAY_H_10162026
+
+/** @file
+ * @brief Contains a dynamic array of bits, packed 64 to a word.
+ *
+ * A `ctls_BitArray` takes an eighth of the memory of a dynamic array of `bool`, and operations that look at many bits
+ * at once, such as counting or combining them, process a whole word per step instead of a byte. Counting, searching,
+ * and the bulk operations are carried out by the bitwise kernels of cutils/simd/kernels.h, so they use AVX2 and
+ * `POPCNT` on processors that support them.
+ *
+ * The bit at index *i* is bit *i* % 64 of word *i* / 64, counting from the least significant bit. Every bit at or
+ * beyond `ctls_BitArray::size` is kept zero, so the words can be counted and combined without masking the last one.
+ * Code that modifies `ctls_BitArray::words` directly must preserve this.
+ *
+ * @code
+ * struct ctls_BitArray visited;
+ * ctls_bit_init(&visited, nodeCount);
+ * ctls_bit_resize(&visited, nodeCount, false);
+ * // ...
+ * for (size_t i = ctls_bit_findFirstSet(&visited, 0); i < visited.size; i = ctls_bit_findFirstSet(&visited, i + 1))
+ *     visit(i);
+ * @endcode
+ *
+ * As with `ctls_DynArray`, the capacity grows according to `ctls_BitArray::growthPolicy`, and the memory can be
+ * obtained through a custom allocator.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "cutils/data_structures/dyn_growth.h"
+#include "cutils/memory/allocator.h"
+
+/** @brief The number of bits in each of a bit array's words. */
+#define CTLS_BIT_WORD_BITS 64
+
+/** @brief A dynamic array of bits. */
+struct ctls_BitArray
+{
+    /** @brief the words that contain this bit array's bits */
+    uint64_t* words;
+    /** @brief number of bits contained in this bit array */
+    size_t size;
+    /** @brief maximum number of bits that can be contained in this bit array until it must be expanded; a multiple of
+     *     `CTLS_BIT_WORD_BITS` */
+    size_t capacity;
+    /** @brief the allocator that owns `ctls_BitArray::words`, or `NULL` for the standard library allocator */
+    const struct ctls_Allocator* allocator;
+    /** @brief how this bit array's capacity grows once it runs out of room */
+    enum ctls_DynGrowthPolicy growthPolicy;
+};
+
+/** @brief Returns the bit at index `pos`, which must be less than `bitArr->size`. */
+static inline bool ctls_bit_test(const struct ctls_BitArray* bitArr, size_t pos)
+{
+    return bitArr->words[pos / CTLS_BIT_WORD_BITS] >> pos % CTLS_BIT_WORD_BITS & 1;
+}
+
+/** @brief Sets the bit at index `pos`, which must be less than `bitArr->size`. */
+static inline void ctls_bit_set(struct ctls_BitArray* bitArr, size_t pos)
+{
+    bitArr->words[pos / CTLS_BIT_WORD_BITS] |= (uint64_t)1 << pos % CTLS_BIT_WORD_BITS;
+}
+
+/** @brief Clears the bit at index `pos`, which must be less than `bitArr->size`. */
+static inline void ctls_bit_clear(struct ctls_BitArray* bitArr, size_t pos)
+{
+    bitArr->words[pos / CTLS_BIT_WORD_BITS] &= ~((uint64_t)1 << pos % CTLS_BIT_WORD_BITS);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Initialization and Cleanup
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Initializes an empty bit array with a given initial capacity.
+ * @param bitArr pointer to an uninitialized bit array, or `NULL`
+ * @param initialCapacity `bitArr`'s chosen initial capacity in bits, must be nonzero. It is rounded up to a multiple of
+ *     `CTLS_BIT_WORD_BITS`.
+ * @return On success, returns a dynamically allocated bit array if `bitArr` was originally `NULL`, `bitArr` otherwise.
+ *     On failure, returns `NULL`.
+ */
+struct ctls_BitArray* ctls_bit_init(struct ctls_BitArray* bitArr, size_t initialCapacity);
+
+/**
+ * @brief Initializes an empty bit array whose memory is obtained through a given allocator.
+ * @param bitArr pointer to an uninitialized bit array, or `NULL`
+ * @param initialCapacity `bitArr`'s chosen initial capacity in bits, must be nonzero
+ * @param allocator the allocator that is to own `bitArr->words`, or `NULL` for the standard library allocator
+ * @return On success, returns a dynamically allocated bit array if `bitArr` was originally `NULL`, `bitArr` otherwise.
+ *     On failure, returns `NULL`.
+ *
+ * If `bitArr` is `NULL`, the bit array itself is still allocated with `malloc`.
+ */
+struct ctls_BitArray* ctls_bit_initWithAllocator(struct ctls_BitArray* bitArr, size_t initialCapacity,
+    const struct ctls_Allocator* allocator);
+
+/**
+ * @brief Initializes an empty bit array with the default initial capacity.
+ * @param bitArr pointer to an uninitialized bit array, or `NULL`
+ * @return On success, returns a dynamically allocated bit array if `bitArr` was originally `NULL`, `bitArr` otherwise.
+ *     On failure, returns `NULL`.
+ */
+struct ctls_BitArray* ctls_bit_defaultInit(struct ctls_BitArray* bitArr);
+
+/**
+ * @brief Frees `bitArr->words` and zeroes `bitArr`'s members out.
+ * @param bitArr pointer to an initialized bit array
+ */
+void ctls_bit_reset(struct ctls_BitArray* bitArr);
+
+/**
+ * @brief Frees excess memory held by a bit array.
+ * @param bitArr pointer to an initialized bit array
+ * @return `true` if operation succeeds, `false` if not
+ *
+ * If the operation succeeds, `bitArr->capacity` is `bitArr->size` rounded up to a multiple of `CTLS_BIT_WORD_BITS`.
+ */
+bool ctls_bit_shrinkToFit(struct ctls_BitArray* bitArr);
+
+/**
+ * @brief Copies the contents of one bit array into another.
+ * @param dest pointer to the destination bit array; must be either initialized, zeroed out, or `NULL`
+ * @param src pointer to the source bit array
+ * @return On success, returns a pointer to a bit array with the same bits as `src`. This pointer equals `dest` if
+ *     `dest` was not `NULL`. Otherwise, it points to a dynamically allocated bit array. On failure, returns `NULL`.
+ */
+struct ctls_BitArray* ctls_bit_copy(struct ctls_BitArray* restrict dest, const struct ctls_BitArray* restrict src);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Mutators
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Adds a bit to the end of a bit array.
+ * @param bitArr pointer to an initialized bit array
+ * @param value the bit that is to be added
+ * @return `true` if operation succeeds, `false` if not
+ */
+bool ctls_bit_append(struct ctls_BitArray* bitArr, bool value);
+
+/**
+ * @brief Adds the first `srcLen` bits of `src` to the end of a bit array.
+ * @param bitArr pointer to an initialized bit array
+ * @param src pointer to words holding the bits that are to be added, in the same layout as `bitArr->words`; must not
+ *     point into `bitArr->words`
+ * @param srcLen number of bits that are to be added
+ * @return `true` if operation succeeds, `false` if not
+ *
+ * The bits are shifted into place a word at a time, even if `bitArr->size` is not a multiple of `CTLS_BIT_WORD_BITS`.
+ * Bits of `src` beyond the first `srcLen` are ignored.
+ */
+bool ctls_bit_extend(struct ctls_BitArray* bitArr, const uint64_t* src, size_t srcLen);
+
+/**
+ * @brief Changes the number of bits in a bit array.
+ * @param bitArr pointer to an initialized bit array
+ * @param size the new number of bits
+ * @param value the value of the bits added if `size` is greater than `bitArr->size`
+ * @return `true` if operation succeeds, `false` if not
+ */
+bool ctls_bit_resize(struct ctls_BitArray* bitArr, size_t size, bool value);
+
+/**
+ * @brief Removes the bits of a bit array at indices \f$i\f$ such that \f$from <= i < to\f$.
+ * @param bitArr pointer to an initialized bit array
+ * @param from first index whose corresponding bit is removed
+ * @param to index after the last whose corresponding bit is removed; must not be less than `from` or greater than
+ *     `bitArr->size`
+ *
+ * The bits after `to` are shifted down a word at a time.
+ */
+void ctls_bit_remove(struct ctls_BitArray* bitArr, size_t from, size_t to);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Queries
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/** @brief Returns the number of set bits in a bit array. */
+size_t ctls_bit_popcount(const struct ctls_BitArray* bitArr);
+
+/**
+ * @brief Finds the first set bit of a bit array at or after a given index.
+ * @param bitArr pointer to an initialized bit array
+ * @param from index at which the search starts
+ * @return the index of the first set bit at or after `from`, or `bitArr->size` if there is none
+ */
+size_t ctls_bit_findFirstSet(const struct ctls_BitArray* bitArr, size_t from);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Bulk Operations
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Clears each bit of `dest` whose counterpart in `src` is clear.
+ * @param dest pointer to an initialized bit array
+ * @param src pointer to an initialized bit array of the same size as `dest`, which may be `dest` itself
+ */
+void ctls_bit_and(struct ctls_BitArray* dest, const struct ctls_BitArray* src);
+
+/**
+ * @brief Sets each bit of `dest` whose counterpart in `src` is set.
+ * @param dest pointer to an initialized bit array
+ * @param src pointer to an initialized bit array of the same size as `dest`, which may be `dest` itself
+ */
+void ctls_bit_or(struct ctls_BitArray* dest, const struct ctls_BitArray* src);
+
+/**
+ * @brief Flips each bit of `dest` whose counterpart in `src` is set.
+ * @param dest pointer to an initialized bit array
+ * @param src pointer to an initialized bit array of the same size as `dest`, which may be `dest` itself
+ */
+void ctls_bit_xor(struct ctls_BitArray* dest, const struct ctls_BitArray* src);
+
+/**
+ * @brief Clears each bit of `dest` whose counterpart in `src` is set.
+ * @param dest pointer to an initialized bit array
+ * @param src pointer to an initialized bit array of the same size as `dest`, which may be `dest` itself
+ */
+void ctls_bit_andNot(struct ctls_BitArray* dest, const struct ctls_BitArray* src);
+
+#endif
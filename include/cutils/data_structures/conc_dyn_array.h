@@ -0,0 +1,204 @@
+#ifndef CUTILS_DATA_STRUCTURES_CONC_DYN_ARRAY_H_10162026
+#define CUTILS_DATA_STRUCTURES_CONC_DYN_ARRAY_H_10162026
+
+/** @file
+ * @brief Contains a dynamic array that many threads can append to concurrently without locking.
+ *
+ * Like those of `ctls_DynArray`, the functions declared in this file take a final `elemSize` parameter, which must be
+ * the same for every call that acts on a given concurrent dynamic array.
+ *
+ * A concurrent dynamic array stores its elements in segments. The first segment holds `1 << firstSegmentShift`
+ * elements, and each following segment holds twice as many as the one before it, so only a logarithmic number of
+ * segments is ever needed. Segments are never moved or freed until the array is reset, which is what lets threads
+ * append without waiting for each other:
+ * - A thread claims slots by atomically advancing `ctls_ConcDynArray::size`, after making sure the segments that hold
+ *     those slots exist.
+ * - A missing segment is allocated by whichever thread first needs it, and published with a compare-and-swap. Threads
+ *     that lose the race free their segment and use the winner's. No thread ever waits for another to finish growing
+ *     the array.
+ * - Once claimed, slots belong to the claiming thread, which fills them without any further synchronization.
+ *
+ * As a consequence, the elements are only contiguous within a segment. `ctls_cdyn_at()` locates a single element, and
+ * `ctls_cdyn_span()` locates a run of elements within one segment. `ctls_cdyn_flatten()` copies the elements into a
+ * regular `ctls_DynArray` once the threads are done.
+ *
+ * The functions that append, namely `ctls_cdyn_append()`, `ctls_cdyn_extend()`, and `ctls_cdyn_reserveRange()`, may be
+ * called concurrently with each other and with `ctls_cdyn_at()` and `ctls_cdyn_span()`. All other functions require
+ * exclusive access. A slot's contents are only visible to other threads once they have synchronized with the thread
+ * that filled it, for instance by joining it.
+ *
+ * `ctls_ConcDynArray::allocator` is called concurrently, so it must be thread-safe. The standard library allocator is;
+ * the allocators in cutils/memory are not.
+ */
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdatomic.h>
+
+#include "cutils/data_structures/dyn_array.h"
+#include "cutils/memory/allocator.h"
+
+/** @brief The maximum number of segments a concurrent dynamic array can have. */
+#define CTLS_CDYN_MAX_SEGMENTS (sizeof(size_t) * 8)
+
+/** @brief A dynamic array that supports concurrent appends. */
+struct ctls_ConcDynArray
+{
+    /** @brief the blocks that contain this array's elements; segment *k* holds `2^(firstSegmentShift + k)` elements */
+    _Atomic(void*) segments[CTLS_CDYN_MAX_SEGMENTS];
+    /** @brief number of slots claimed so far, including those that have yet to be filled */
+    atomic_size_t size;
+    /** @brief base-2 logarithm of the number of elements in the first segment */
+    size_t firstSegmentShift;
+    /** @brief the thread-safe allocator that owns every segment, or `NULL` for the standard library allocator */
+    const struct ctls_Allocator* allocator;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Initialization and Cleanup
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Initializes a concurrent dynamic array.
+ * @param concArr pointer to an uninitialized concurrent dynamic array, or `NULL`
+ * @param initialCapacity the minimum capacity of the first segment; must be nonzero
+ * @param elemSize size of one of `concArr`'s elements
+ * @return On success, returns a dynamically allocated concurrent dynamic array if `concArr` was originally `NULL`,
+ *     `concArr` otherwise. On failure, returns `NULL`.
+ *
+ * `initialCapacity` is rounded up to a power of two, and the first segment is allocated immediately.
+ */
+struct ctls_ConcDynArray* ctls_cdyn_init(struct ctls_ConcDynArray* concArr, size_t initialCapacity, size_t elemSize);
+
+/**
+ * @brief Initializes a concurrent dynamic array whose segments are obtained through a given allocator.
+ * @param concArr pointer to an uninitialized concurrent dynamic array, or `NULL`
+ * @param initialCapacity the minimum capacity of the first segment; must be nonzero
+ * @param elemSize size of one of `concArr`'s elements
+ * @param allocator a thread-safe allocator, or `NULL` for the standard library allocator
+ * @return On success, returns a dynamically allocated concurrent dynamic array if `concArr` was originally `NULL`,
+ *     `concArr` otherwise. On failure, returns `NULL`.
+ */
+struct ctls_ConcDynArray* ctls_cdyn_initWithAllocator(struct ctls_ConcDynArray* concArr, size_t initialCapacity,
+    size_t elemSize, const struct ctls_Allocator* allocator);
+
+/**
+ * @brief Initializes a concurrent dynamic array with the default initial capacity.
+ * @param concArr pointer to an uninitialized concurrent dynamic array, or `NULL`
+ * @param elemSize size of one of `concArr`'s elements
+ * @return On success, returns a dynamically allocated concurrent dynamic array if `concArr` was originally `NULL`,
+ *     `concArr` otherwise. On failure, returns `NULL`.
+ */
+struct ctls_ConcDynArray* ctls_cdyn_defaultInit(struct ctls_ConcDynArray* concArr, size_t elemSize);
+
+/**
+ * @brief Frees every segment of a concurrent dynamic array and zeroes its members out.
+ * @param concArr pointer to an initialized concurrent dynamic array
+ * @param elemSize size of one of `concArr`'s elements
+ */
+void ctls_cdyn_reset(struct ctls_ConcDynArray* concArr, size_t elemSize);
+
+/**
+ * @brief Copies the elements of a concurrent dynamic array into a regular dynamic array.
+ * @param dest pointer to the destination dynamic array; must be either initialized, zeroed out, or `NULL`
+ * @param src pointer to the source concurrent dynamic array
+ * @param elemSize size of one of `src`'s elements
+ * @return On success, returns a pointer to a dynamic array that contains copies of `src`'s elements, in order. This
+ *     pointer equals `dest` if `dest` was not `NULL`. Otherwise, it points to a dynamically allocated dynamic array. On
+ *     failure, returns `NULL`.
+ *
+ * Any elements `dest` contained are replaced. Every claimed slot of `src` must have been filled.
+ */
+struct ctls_DynArray* ctls_cdyn_flatten(struct ctls_DynArray* restrict dest,
+    const struct ctls_ConcDynArray* restrict src, size_t elemSize);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Element Access
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Returns the number of slots claimed so far.
+ * @param concArr pointer to an initialized concurrent dynamic array
+ *
+ * While other threads are appending, the result may be stale by the time it is returned.
+ */
+static inline size_t ctls_cdyn_size(const struct ctls_ConcDynArray* concArr)
+{
+    return atomic_load_explicit(&concArr->size, memory_order_relaxed);
+}
+
+/**
+ * @brief Returns a pointer to the slot at a given index.
+ * @param concArr pointer to an initialized concurrent dynamic array
+ * @param index index of a claimed slot
+ * @param elemSize size of one of `concArr`'s elements
+ */
+void* ctls_cdyn_at(const struct ctls_ConcDynArray* concArr, size_t index, size_t elemSize);
+
+/**
+ * @brief Returns a pointer to the slot at a given index, and the number of slots that follow it contiguously.
+ * @param concArr pointer to an initialized concurrent dynamic array
+ * @param index index of a claimed slot
+ * @param elemSize size of one of `concArr`'s elements
+ * @param length assigned the number of contiguous slots starting at `index`, which is at least 1. These extend to the
+ *     end of `index`'s segment, and may include slots that have not been claimed.
+ *
+ * Lets a range of slots be visited one segment at a time:
+ * @code
+ * for (size_t i = first, length; i < first + count; i += length)
+ * {
+ *     int* span = ctls_cdyn_span(&concArr, i, sizeof(int), &length);
+ *     if (length > first + count - i)
+ *         length = first + count - i;
+ *     // ... fill span[0] through span[length - 1] ...
+ * }
+ * @endcode
+ */
+void* ctls_cdyn_span(const struct ctls_ConcDynArray* concArr, size_t index, size_t elemSize, size_t* length);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Mutators
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Claims a range of consecutive slots at the end of a concurrent dynamic array.
+ * @param concArr pointer to an initialized concurrent dynamic array
+ * @param count number of slots to claim
+ * @param elemSize size of one of `concArr`'s elements
+ * @param first assigned the index of the first claimed slot on success
+ * @return `true` if the operation succeeds, `false` if memory for the slots could not be allocated
+ *
+ * The claimed slots are uninitialized, and the calling thread is expected to fill them, for instance via
+ * `ctls_cdyn_span()`. On failure, no slots are claimed, although segments allocated along the way are kept.
+ *
+ * Claiming a block of slots at once, and filling it afterwards, lets threads append without touching shared state for
+ * every element.
+ */
+bool ctls_cdyn_reserveRange(struct ctls_ConcDynArray* concArr, size_t count, size_t elemSize, size_t* first);
+
+/**
+ * @brief Adds an element to the end of a concurrent dynamic array.
+ * @param concArr pointer to an initialized concurrent dynamic array
+ * @param elem pointer to the element that is to be added
+ * @param elemSize size of one of `concArr`'s elements
+ * @return `true` if the operation succeeds, `false` if not
+ *
+ * Elements appended concurrently by different threads end up in an unspecified order.
+ */
+bool ctls_cdyn_append(struct ctls_ConcDynArray* restrict concArr, const void* restrict elem, size_t elemSize);
+
+/**
+ * @brief Adds the elements of `src` to the end of a concurrent dynamic array.
+ * @param concArr pointer to an initialized concurrent dynamic array
+ * @param src pointer to the elements that are to be added
+ * @param srcLen number of elements that are to be added
+ * @param elemSize size of one of `concArr`'s elements
+ * @return `true` if the operation succeeds, `false` if not
+ *
+ * The elements of `src` remain consecutive, even if other threads append concurrently.
+ */
+bool ctls_cdyn_extend(struct ctls_ConcDynArray* restrict concArr, const void* restrict src, size_t srcLen,
+    size_t elemSize);
+
+#endif
@@ -0,0 +1,244 @@
+#ifndef CUTILS_DATA_STRUCTURES_COW_DYN_ARRAY_H_10162026
+#define CUTILS_DATA_STRUCTURES_COW_DYN_ARRAY_H_10162026
+
+/** @file
+ * @brief Contains a copy-on-write dynamic array, whose immutable snapshots can be shared between threads.
+ *
+ * Like those of `ctls_DynArray`, the functions declared in this file take a final `elemSize` parameter, which must be
+ * the same for every call that acts on a given copy-on-write array, or on any of its snapshots.
+ *
+ * A copy-on-write array keeps its elements, size, and capacity in a reference-counted `ctls_CowBlock`. Copying the
+ * array with `ctls_cow_copy()`, or taking a snapshot of it with `ctls_cow_snapshot()`, merely increments the block's
+ * reference count, so it takes constant time regardless of the array's size. A mutator only modifies the block in place
+ * if it holds the only reference to it. Otherwise, it first copies the block, and releases its reference to the shared
+ * one, which therefore never changes as long as anybody can still see it. Elements must only be modified through the
+ * pointer returned by `ctls_cow_mutableData()`, which unshares the block first.
+ *
+ * A snapshot is a pointer to an immutable block, and may be read by any number of threads at once.
+ * `ctls_cow_release()` gives up a reference, and frees the block once the last one is gone. Reference counts are
+ * updated atomically, so a snapshot may be released on a different thread than the one that took it.
+ *
+ * **Publishing versions**
+ *
+ * A `ctls_CowSlot` lets a writer hand new versions of an array to readers on other threads. The writer modifies its
+ * array as usual, and calls `ctls_cow_publish()` to make a snapshot of it the slot's current version. Readers call
+ * `ctls_cow_acquire()` to obtain a reference to the current version, which they can keep reading for as long as they
+ * like, and release once they are done. Acquiring never waits for the writer, though it starts over if a publish
+ * happens to move readers on while it is announcing itself. Publishing briefly waits for readers that are in the
+ * middle of acquiring the previous version, and then releases the slot's reference to it, so a version is freed once
+ * the last reader that acquired it releases it.
+ *
+ * @code
+ * // On the writer's thread:
+ * ctls_cow_append(&config, &entry, sizeof(struct Entry));
+ * ctls_cow_publish(&configSlot, &config, sizeof(struct Entry));
+ *
+ * // On a reader's thread:
+ * const struct ctls_CowBlock* current = ctls_cow_acquire(&configSlot);
+ * const struct Entry* entries = ctls_cow_data(current);
+ * // ...
+ * ctls_cow_release(current, sizeof(struct Entry));
+ * @endcode
+ *
+ * Blocks are freed by whichever thread releases the last reference, so the array's allocator must be thread-safe if
+ * snapshots are released on other threads. The standard library allocator is; the allocators in cutils/memory are not.
+ */
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#include "cutils/data_structures/dyn_growth.h"
+#include "cutils/memory/allocator.h"
+
+/** @brief A reference-counted block of elements, shared by copy-on-write arrays and snapshots. */
+struct ctls_CowBlock
+{
+    /** @brief number of arrays, snapshots, and slots that refer to this block */
+    atomic_size_t refs;
+    /** @brief number of elements contained in this block */
+    size_t size;
+    /** @brief maximum number of elements that fit in this block */
+    size_t capacity;
+    /** @brief the allocator that owns this block, or `NULL` for the standard library allocator */
+    const struct ctls_Allocator* allocator;
+    /** @brief the elements */
+    max_align_t data[];
+};
+
+/** @brief A copy-on-write dynamic array. */
+struct ctls_CowDynArray
+{
+    /** @brief the block that holds this array's elements, which may be shared */
+    struct ctls_CowBlock* block;
+    /** @brief how this array's capacity grows once it runs out of room */
+    enum ctls_DynGrowthPolicy growthPolicy;
+};
+
+/** @brief A slot through which a writer publishes versions of a copy-on-write array. Zero-initialize before use. */
+struct ctls_CowSlot
+{
+    /** @brief the current version, or `NULL` if none has been published yet */
+    _Atomic(struct ctls_CowBlock*) current;
+    /** @brief selects which of `ctls_CowSlot::readers` acquiring readers announce themselves in */
+    atomic_size_t epoch;
+    /** @brief numbers of readers in the middle of acquiring the current version, by epoch */
+    atomic_size_t readers[2];
+};
+
+/** @brief Returns the elements of a snapshot. */
+static inline const void* ctls_cow_data(const struct ctls_CowBlock* snapshot)
+{
+    return snapshot->data;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Initialization and Cleanup
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Initializes an empty copy-on-write array with a given initial capacity.
+ * @param cowArr pointer to an uninitialized copy-on-write array, or `NULL`
+ * @param initialCapacity `cowArr`'s chosen initial capacity, must be nonzero
+ * @param elemSize size of one of `cowArr`'s elements
+ * @return On success, returns a dynamically allocated copy-on-write array if `cowArr` was originally `NULL`, `cowArr`
+ *     otherwise. On failure, returns `NULL`.
+ */
+struct ctls_CowDynArray* ctls_cow_init(struct ctls_CowDynArray* cowArr, size_t initialCapacity, size_t elemSize);
+
+/**
+ * @brief Initializes an empty copy-on-write array whose blocks are obtained through a given allocator.
+ * @param cowArr pointer to an uninitialized copy-on-write array, or `NULL`
+ * @param initialCapacity `cowArr`'s chosen initial capacity, must be nonzero
+ * @param elemSize size of one of `cowArr`'s elements
+ * @param allocator the allocator that is to own every block of `cowArr`, or `NULL` for the standard library allocator
+ * @return On success, returns a dynamically allocated copy-on-write array if `cowArr` was originally `NULL`, `cowArr`
+ *     otherwise. On failure, returns `NULL`.
+ */
+struct ctls_CowDynArray* ctls_cow_initWithAllocator(struct ctls_CowDynArray* cowArr, size_t initialCapacity,
+    size_t elemSize, const struct ctls_Allocator* allocator);
+
+/**
+ * @brief Releases a copy-on-write array's reference to its block, and zeroes the array out.
+ * @param cowArr pointer to an initialized copy-on-write array
+ * @param elemSize size of one of `cowArr`'s elements
+ */
+void ctls_cow_reset(struct ctls_CowDynArray* cowArr, size_t elemSize);
+
+/**
+ * @brief Makes a copy-on-write array share another's elements, in constant time.
+ * @param dest pointer to an uninitialized copy-on-write array, or `NULL`
+ * @param src pointer to an initialized copy-on-write array
+ * @return On success, returns a dynamically allocated copy-on-write array if `dest` was originally `NULL`, `dest`
+ *     otherwise. On failure, returns `NULL`.
+ *
+ * The first mutation of either array copies the elements.
+ */
+struct ctls_CowDynArray* ctls_cow_copy(struct ctls_CowDynArray* dest, const struct ctls_CowDynArray* src);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Snapshots
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Takes an immutable snapshot of a copy-on-write array, in constant time.
+ * @param cowArr pointer to an initialized copy-on-write array
+ * @return a new reference to `cowArr`'s block, which must eventually be passed to `ctls_cow_release()`
+ */
+const struct ctls_CowBlock* ctls_cow_snapshot(const struct ctls_CowDynArray* cowArr);
+
+/**
+ * @brief Releases a reference to a block, and frees the block if it was the last.
+ * @param snapshot a snapshot, or `NULL`
+ * @param elemSize size of one of the snapshot's elements
+ */
+void ctls_cow_release(const struct ctls_CowBlock* snapshot, size_t elemSize);
+
+/**
+ * @brief Makes a snapshot the current version of a slot, and releases the previous version.
+ * @param slot pointer to a slot
+ * @param cowArr pointer to the copy-on-write array a snapshot of which is to be published
+ * @param elemSize size of one of `cowArr`'s elements
+ *
+ * Must not be called concurrently with itself or with `ctls_cow_resetSlot()` on the same slot. May be called
+ * concurrently with `ctls_cow_acquire()`.
+ */
+void ctls_cow_publish(struct ctls_CowSlot* slot, const struct ctls_CowDynArray* cowArr, size_t elemSize);
+
+/**
+ * @brief Acquires a reference to the current version of a slot.
+ * @param slot pointer to a slot
+ * @return a snapshot, which must eventually be passed to `ctls_cow_release()`, or `NULL` if nothing has been published
+ */
+const struct ctls_CowBlock* ctls_cow_acquire(struct ctls_CowSlot* slot);
+
+/**
+ * @brief Releases a slot's current version, and zeroes the slot out.
+ * @param slot pointer to a slot
+ * @param elemSize size of one of the current version's elements
+ *
+ * Requires exclusive access to `slot`. Snapshots acquired through it remain valid.
+ */
+void ctls_cow_resetSlot(struct ctls_CowSlot* slot, size_t elemSize);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Mutators
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Returns a pointer to a copy-on-write array's elements through which they may be modified.
+ * @param cowArr pointer to an initialized copy-on-write array
+ * @param elemSize size of one of `cowArr`'s elements
+ * @return the elements, or `NULL` if they were shared and could not be copied
+ *
+ * If the elements are shared, they are copied first. The pointer is invalidated by any other mutator, and by taking a
+ * snapshot.
+ */
+void* ctls_cow_mutableData(struct ctls_CowDynArray* cowArr, size_t elemSize);
+
+/**
+ * @brief Adds an element to the end of a copy-on-write array.
+ * @param cowArr pointer to an initialized copy-on-write array
+ * @param elem pointer to the element that is to be added
+ * @param elemSize size of one of `cowArr`'s elements
+ * @return `true` if the operation succeeds, `false` if not
+ */
+bool ctls_cow_append(struct ctls_CowDynArray* restrict cowArr, const void* restrict elem, size_t elemSize);
+
+/**
+ * @brief Inserts the elements of `src` before the element of a copy-on-write array at index `pos`.
+ * @param cowArr pointer to an initialized copy-on-write array
+ * @param src pointer to the elements that are to be added; must not point into `cowArr`'s block
+ * @param pos index before which elements are to be added. Must not be greater than `cowArr->block->size`.
+ * @param srcLen number of elements that are to be added
+ * @param elemSize size of one of `cowArr`'s elements
+ * @return `true` if the operation succeeds, `false` if not
+ *
+ * If the elements are shared, they are copied into a block with room for the new ones, so they are only copied once.
+ */
+bool ctls_cow_insert(struct ctls_CowDynArray* cowArr, const void* src, size_t pos, size_t srcLen, size_t elemSize);
+
+/**
+ * @brief Inserts the elements of `src` at the end of a copy-on-write array.
+ * @param cowArr pointer to an initialized copy-on-write array
+ * @param src pointer to the elements that are to be added; must not point into `cowArr`'s block
+ * @param srcLen number of elements that are to be added
+ * @param elemSize size of one of `cowArr`'s elements
+ * @return `true` if the operation succeeds, `false` if not
+ */
+bool ctls_cow_extend(struct ctls_CowDynArray* cowArr, const void* src, size_t srcLen, size_t elemSize);
+
+/**
+ * @brief Removes the elements of a copy-on-write array at indices \f$i\f$ such that \f$from <= i < to\f$.
+ * @param cowArr pointer to an initialized copy-on-write array
+ * @param from first index whose corresponding element is removed
+ * @param to index after the last whose corresponding element is removed; must not be less than `from` or greater than
+ *     `cowArr->block->size`
+ * @param elemSize size of one of `cowArr`'s elements
+ * @return `true` if the operation succeeds, `false` if the elements were shared and could not be copied
+ *
+ * If the elements are shared, only those that remain are copied.
+ */
+bool ctls_cow_remove(struct ctls_CowDynArray* cowArr, size_t from, size_t to, size_t elemSize);
+
+#endif
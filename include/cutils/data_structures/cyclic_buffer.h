@@ -0,0 +1,202 @@
+#ifndef CUTILS_DATA_STRUCTURES_CYCLIC_BUFFER_H_822020
+#define CUTILS_DATA_STRUCTURES_CYCLIC_BUFFER_H_822020
+
+/** @file
+ * @brief Contains a cyclic buffer implementation.
+ *
+ * A cyclic buffer is a first-in, first-out queue of fixed capacity. Like those of `ctls_DynArray`, the functions
+ * declared in this file take a final `elemSize` parameter, which must be the same for every call that acts on a given
+ * cyclic buffer.
+ *
+ * The capacity of a cyclic buffer is always a power of two. `ctls_CyclicBuffer::left` and `ctls_CyclicBuffer::right`
+ * count the elements popped and pushed over the buffer's lifetime, and wrap around only at `SIZE_MAX`. The buffer
+ * holds `right - left` elements, and an element's slot is found by masking its count with `capacity - 1`, so no
+ * division or branch is needed to wrap around.
+ *
+ * **Single-producer, single-consumer use**
+ *
+ * One thread, the producer, may push while another, the consumer, pops, without any locking. The producer may call
+ * `ctls_cbuf_push()`, `ctls_cbuf_pushMany()`, `ctls_cbuf_writeSpan()`, and `ctls_cbuf_commitWrite()`; the consumer may
+ * call `ctls_cbuf_pop()`, `ctls_cbuf_popMany()`, `ctls_cbuf_readSpan()`, and `ctls_cbuf_commitRead()`. Both may call
+ * `ctls_cbuf_size()`. All other functions require exclusive access. The producer's and the consumer's counters lie on
+ * separate cache lines, and each side keeps a cached copy of the other's counter, so they only contend when the buffer
+ * is nearly full or nearly empty. On x86, the atomic operations involved compile to plain loads and stores, so a buffer
+ * used by a single thread costs nothing extra.
+ *
+ * **Zero-copy spans**
+ *
+ * `ctls_cbuf_writeSpan()` returns the contiguous free slots at the back of the buffer. The producer fills as many of
+ * them as it likes, then publishes them with `ctls_cbuf_commitWrite()`. Likewise, `ctls_cbuf_readSpan()` returns the
+ * contiguous elements at the front, which the consumer processes in place and then releases with
+ * `ctls_cbuf_commitRead()`. A span never wraps around, so when the free slots or the elements wrap around, a second
+ * call returns the remainder.
+ *
+ * @code
+ * size_t length;
+ * struct Packet* span = ctls_cbuf_writeSpan(&buf, sizeof(struct Packet), &length);
+ * size_t received = receivePackets(span, length);
+ * ctls_cbuf_commitWrite(&buf, received);
+ * @endcode
+ */
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#include "cutils/memory/allocator.h"
+
+/** @brief The alignment that keeps the producer's and the consumer's members on separate cache lines. */
+#define CTLS_CBUF_CACHE_LINE 64
+
+/** @brief A cyclic buffer. */
+struct ctls_CyclicBuffer
+{
+    /** @brief the block of memory that contains this cyclic buffer's slots */
+    void* data;
+    /** @brief number of slots in `ctls_CyclicBuffer::data`; always a power of two */
+    size_t capacity;
+    /** @brief the allocator that owns `ctls_CyclicBuffer::data`, or `NULL` for the standard library allocator */
+    const struct ctls_Allocator* allocator;
+    /** @brief number of elements pushed so far; written only by the producer */
+    _Alignas(CTLS_CBUF_CACHE_LINE) atomic_size_t right;
+    /** @brief the producer's most recent copy of `ctls_CyclicBuffer::left` */
+    size_t cachedLeft;
+    /** @brief number of elements popped so far; written only by the consumer */
+    _Alignas(CTLS_CBUF_CACHE_LINE) atomic_size_t left;
+    /** @brief the consumer's most recent copy of `ctls_CyclicBuffer::right` */
+    size_t cachedRight;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Initialization and Cleanup
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Initializes an empty cyclic buffer.
+ * @param buf pointer to an uninitialized cyclic buffer, or `NULL`
+ * @param capacity the minimum capacity of `buf`; must be nonzero
+ * @param elemSize size of one of `buf`'s elements
+ * @return On success, returns a dynamically allocated cyclic buffer if `buf` was originally `NULL`, `buf` otherwise.
+ *     On failure, returns `NULL`.
+ *
+ * `capacity` is rounded up to a power of two. A cyclic buffer allocated by this function is suitably aligned, and must
+ * be freed with `free`.
+ */
+struct ctls_CyclicBuffer* ctls_cbuf_init(struct ctls_CyclicBuffer* buf, size_t capacity, size_t elemSize);
+
+/**
+ * @brief Initializes an empty cyclic buffer whose memory is obtained through a given allocator.
+ * @param buf pointer to an uninitialized cyclic buffer, or `NULL`
+ * @param capacity the minimum capacity of `buf`; must be nonzero
+ * @param elemSize size of one of `buf`'s elements
+ * @param allocator the allocator that is to own `buf->data`, or `NULL` for the standard library allocator
+ * @return On success, returns a dynamically allocated cyclic buffer if `buf` was originally `NULL`, `buf` otherwise.
+ *     On failure, returns `NULL`.
+ */
+struct ctls_CyclicBuffer* ctls_cbuf_initWithAllocator(struct ctls_CyclicBuffer* buf, size_t capacity,
+    size_t elemSize, const struct ctls_Allocator* allocator);
+
+/**
+ * @brief Frees `buf->data` and zeroes `buf`'s members out.
+ * @param buf pointer to an initialized cyclic buffer
+ * @param elemSize size of one of `buf`'s elements
+ */
+void ctls_cbuf_reset(struct ctls_CyclicBuffer* buf, size_t elemSize);
+
+/**
+ * @brief Returns the number of elements in a cyclic buffer.
+ * @param buf pointer to an initialized cyclic buffer
+ *
+ * While the producer or the consumer is active, the result may be stale by the time it is returned.
+ */
+static inline size_t ctls_cbuf_size(const struct ctls_CyclicBuffer* buf)
+{
+    size_t left = atomic_load_explicit(&buf->left, memory_order_acquire);
+    return atomic_load_explicit(&buf->right, memory_order_acquire) - left;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Producer
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Adds an element to the back of a cyclic buffer.
+ * @param buf pointer to an initialized cyclic buffer
+ * @param elem pointer to the element that is to be added
+ * @param elemSize size of one of `buf`'s elements
+ * @return `true` if the element was added, `false` if `buf` is full
+ */
+bool ctls_cbuf_push(struct ctls_CyclicBuffer* restrict buf, const void* restrict elem, size_t elemSize);
+
+/**
+ * @brief Adds as many elements of `src` to the back of a cyclic buffer as fit.
+ * @param buf pointer to an initialized cyclic buffer
+ * @param src pointer to the elements that are to be added
+ * @param srcLen number of elements that are to be added
+ * @param elemSize size of one of `buf`'s elements
+ * @return the number of elements added, which are the first ones of `src`
+ */
+size_t ctls_cbuf_pushMany(struct ctls_CyclicBuffer* restrict buf, const void* restrict src, size_t srcLen,
+    size_t elemSize);
+
+/**
+ * @brief Returns the contiguous free slots at the back of a cyclic buffer.
+ * @param buf pointer to an initialized cyclic buffer
+ * @param elemSize size of one of `buf`'s elements
+ * @param length assigned the number of contiguous free slots, which is zero if `buf` is full
+ * @return a pointer to the first free slot
+ *
+ * The slots only become part of `buf` once they are committed with `ctls_cbuf_commitWrite()`.
+ */
+void* ctls_cbuf_writeSpan(struct ctls_CyclicBuffer* buf, size_t elemSize, size_t* length);
+
+/**
+ * @brief Adds the first `count` slots returned by `ctls_cbuf_writeSpan()` to the back of a cyclic buffer.
+ * @param buf pointer to an initialized cyclic buffer
+ * @param count number of slots that were filled; must not exceed the length returned by `ctls_cbuf_writeSpan()`
+ */
+void ctls_cbuf_commitWrite(struct ctls_CyclicBuffer* buf, size_t count);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Consumer
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Removes the element at the front of a cyclic buffer.
+ * @param buf pointer to an initialized cyclic buffer
+ * @param elem pointer to where the element is to be copied, or `NULL` to discard it
+ * @param elemSize size of one of `buf`'s elements
+ * @return `true` if an element was removed, `false` if `buf` is empty
+ */
+bool ctls_cbuf_pop(struct ctls_CyclicBuffer* restrict buf, void* restrict elem, size_t elemSize);
+
+/**
+ * @brief Removes up to `destLen` elements from the front of a cyclic buffer.
+ * @param buf pointer to an initialized cyclic buffer
+ * @param dest pointer to where the elements are to be copied
+ * @param destLen maximum number of elements that are to be removed
+ * @param elemSize size of one of `buf`'s elements
+ * @return the number of elements removed
+ */
+size_t ctls_cbuf_popMany(struct ctls_CyclicBuffer* restrict buf, void* restrict dest, size_t destLen,
+    size_t elemSize);
+
+/**
+ * @brief Returns the contiguous elements at the front of a cyclic buffer.
+ * @param buf pointer to an initialized cyclic buffer
+ * @param elemSize size of one of `buf`'s elements
+ * @param length assigned the number of contiguous elements, which is zero if `buf` is empty
+ * @return a pointer to the element at the front
+ *
+ * The elements remain in `buf` until they are released with `ctls_cbuf_commitRead()`.
+ */
+void* ctls_cbuf_readSpan(struct ctls_CyclicBuffer* buf, size_t elemSize, size_t* length);
+
+/**
+ * @brief Removes the first `count` elements returned by `ctls_cbuf_readSpan()` from the front of a cyclic buffer.
+ * @param buf pointer to an initialized cyclic buffer
+ * @param count number of elements that were processed; must not exceed the length returned by `ctls_cbuf_readSpan()`
+ */
+void ctls_cbuf_commitRead(struct ctls_CyclicBuffer* buf, size_t count);
+
+#endif
@@ -0,0 +1,250 @@
+#ifndef CUTILS_DATA_STRUCTURES_CYCLIC_BUFFER_G_H_10162026
+#define CUTILS_DATA_STRUCTURES_CYCLIC_BUFFER_G_H_10162026
+
+/** @file
+ * @brief Contains a generic version of `ctls_CyclicBuffer`.
+ *
+ * The macros in this file create specializations of `ctls_CyclicBuffer`, in the same manner as those in
+ * cutils/data_structures/dyn_array_g.h create specializations of `ctls_DynArray`. They take the same `type` and
+ * `suffix` arguments.
+ *
+ * The functions associated with a given specialization are nearly identical to those declared in
+ * cutils/data_structures/cyclic_buffer.h, and so are the rules for single-producer, single-consumer use. Here are
+ * their differences:
+ *
+ * - In a generic function parameter, all occurrences of the identifier `ctls_CyclicBuffer` are replaced with the
+ *     specialization.
+ * - A generic function has no `elemSize` parameter.
+ * - For a specialization for type *T*, `ctls_cbuf_push_##suffix`'s parameter `elem` is of type *T*, and spans are
+ *     returned as pointers to *T*.
+ *
+ * @code
+ * CTLS_CYCLIC_BUFFER(struct Packet, packet)
+ *
+ * void drain(struct ctls_CyclicBuffer_packet* buf)
+ * {
+ *     size_t length;
+ *     struct Packet* span = ctls_cbuf_readSpan_packet(buf, &length);
+ *     for (size_t i = 0; i < length; ++i)
+ *         process(&span[i]);
+ *     ctls_cbuf_commitRead_packet(buf, length);
+ * }
+ * @endcode
+ */
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdatomic.h>
+
+#include "cutils/data_structures/cyclic_buffer.h"
+#include "cutils/data_structures/dyn_growth.h"
+#include "cutils/memory/allocator.h"
+
+/**
+ * @brief Creates declarations for a specialization of `ctls_CyclicBuffer`.
+ * @param type the name of the type to be specialized for
+ * @param suffix a string appended to each declared identifier
+ *
+ * The corresponding implementation is created via `CTLS_CYCLIC_BUFFER_DEF`.
+ */
+#define CTLS_CYCLIC_BUFFER_DECL(type, suffix) \
+\
+struct ctls_CyclicBuffer_##suffix \
+{ \
+    type* data; \
+    size_t capacity; \
+    const struct ctls_Allocator* allocator; \
+    _Alignas(CTLS_CBUF_CACHE_LINE) atomic_size_t right; \
+    size_t cachedLeft; \
+    _Alignas(CTLS_CBUF_CACHE_LINE) atomic_size_t left; \
+    size_t cachedRight; \
+}; \
+\
+struct ctls_CyclicBuffer_##suffix* ctls_cbuf_init_##suffix(struct ctls_CyclicBuffer_##suffix* buf, size_t capacity); \
+struct ctls_CyclicBuffer_##suffix* ctls_cbuf_initWithAllocator_##suffix(struct ctls_CyclicBuffer_##suffix* buf, \
+    size_t capacity, const struct ctls_Allocator* allocator); \
+void ctls_cbuf_reset_##suffix(struct ctls_CyclicBuffer_##suffix* buf); \
+size_t ctls_cbuf_size_##suffix(const struct ctls_CyclicBuffer_##suffix* buf); \
+bool ctls_cbuf_push_##suffix(struct ctls_CyclicBuffer_##suffix* buf, type elem); \
+size_t ctls_cbuf_pushMany_##suffix(struct ctls_CyclicBuffer_##suffix* restrict buf, type const* restrict src, \
+    size_t srcLen); \
+type* ctls_cbuf_writeSpan_##suffix(struct ctls_CyclicBuffer_##suffix* buf, size_t* length); \
+void ctls_cbuf_commitWrite_##suffix(struct ctls_CyclicBuffer_##suffix* buf, size_t count); \
+bool ctls_cbuf_pop_##suffix(struct ctls_CyclicBuffer_##suffix* restrict buf, type* restrict elem); \
+size_t ctls_cbuf_popMany_##suffix(struct ctls_CyclicBuffer_##suffix* restrict buf, type* restrict dest, \
+    size_t destLen); \
+type* ctls_cbuf_readSpan_##suffix(struct ctls_CyclicBuffer_##suffix* buf, size_t* length); \
+void ctls_cbuf_commitRead_##suffix(struct ctls_CyclicBuffer_##suffix* buf, size_t count);
+
+/**
+ * @brief Creates definitions for a specialization of `ctls_CyclicBuffer`.
+ * @param type the name of the type to be specialized for
+ * @param suffix a string appended to each declared identifier
+ *
+ * The corresponding declarations can, and should, be included via `CTLS_CYCLIC_BUFFER_DECL`.
+ */
+#define CTLS_CYCLIC_BUFFER_DEF(type, suffix) \
+\
+struct ctls_CyclicBuffer_##suffix* ctls_cbuf_initWithAllocator_##suffix(struct ctls_CyclicBuffer_##suffix* buf, \
+    size_t capacity, const struct ctls_Allocator* allocator) \
+{ \
+    size_t roundedCapacity = (size_t)1 << ctls_dyn_floorLog2(capacity); \
+    if (roundedCapacity < capacity && !(roundedCapacity <<= 1)) \
+        return NULL; \
+    if (roundedCapacity > SIZE_MAX / sizeof(type)) \
+        return NULL; \
+    bool bufOriginallyNull = !buf; \
+    if (bufOriginallyNull) \
+        buf = aligned_alloc(_Alignof(struct ctls_CyclicBuffer_##suffix), sizeof(struct ctls_CyclicBuffer_##suffix)); \
+    if (buf) \
+    { \
+        type* newData = ctls_allocate(allocator, roundedCapacity * sizeof(type)); \
+        if (newData) \
+        { \
+            buf->data = newData, buf->capacity = roundedCapacity, buf->allocator = allocator; \
+            atomic_init(&buf->right, 0); \
+            atomic_init(&buf->left, 0); \
+            buf->cachedLeft = buf->cachedRight = 0; \
+        } \
+        else \
+        { \
+            if (bufOriginallyNull) \
+                free(buf); \
+            buf = NULL; \
+        } \
+    } \
+    return buf; \
+} \
+\
+struct ctls_CyclicBuffer_##suffix* ctls_cbuf_init_##suffix(struct ctls_CyclicBuffer_##suffix* buf, size_t capacity) \
+{ \
+    return ctls_cbuf_initWithAllocator_##suffix(buf, capacity, NULL); \
+} \
+\
+void ctls_cbuf_reset_##suffix(struct ctls_CyclicBuffer_##suffix* buf) \
+{ \
+    ctls_deallocate(buf->allocator, buf->data, buf->capacity * sizeof(type)); \
+    memset(buf, 0, sizeof(struct ctls_CyclicBuffer_##suffix)); \
+} \
+\
+size_t ctls_cbuf_size_##suffix(const struct ctls_CyclicBuffer_##suffix* buf) \
+{ \
+    size_t left = atomic_load_explicit(&buf->left, memory_order_acquire); \
+    return atomic_load_explicit(&buf->right, memory_order_acquire) - left; \
+} \
+\
+bool ctls_cbuf_push_##suffix(struct ctls_CyclicBuffer_##suffix* buf, type elem) \
+{ \
+    size_t right = atomic_load_explicit(&buf->right, memory_order_relaxed); \
+    if (right - buf->cachedLeft == buf->capacity) \
+    { \
+        buf->cachedLeft = atomic_load_explicit(&buf->left, memory_order_acquire); \
+        if (right - buf->cachedLeft == buf->capacity) \
+            return false; \
+    } \
+    buf->data[right & (buf->capacity - 1)] = elem; \
+    atomic_store_explicit(&buf->right, right + 1, memory_order_release); \
+    return true; \
+} \
+\
+type* ctls_cbuf_writeSpan_##suffix(struct ctls_CyclicBuffer_##suffix* buf, size_t* length) \
+{ \
+    size_t right = atomic_load_explicit(&buf->right, memory_order_relaxed), offset = right & (buf->capacity - 1); \
+    buf->cachedLeft = atomic_load_explicit(&buf->left, memory_order_acquire); \
+    size_t vacant = buf->capacity - (right - buf->cachedLeft), contiguous = buf->capacity - offset; \
+    *length = vacant < contiguous ? vacant : contiguous; \
+    return buf->data + offset; \
+} \
+\
+void ctls_cbuf_commitWrite_##suffix(struct ctls_CyclicBuffer_##suffix* buf, size_t count) \
+{ \
+    size_t right = atomic_load_explicit(&buf->right, memory_order_relaxed); \
+    atomic_store_explicit(&buf->right, right + count, memory_order_release); \
+} \
+\
+size_t ctls_cbuf_pushMany_##suffix(struct ctls_CyclicBuffer_##suffix* restrict buf, type const* restrict src, \
+    size_t srcLen) \
+{ \
+    size_t pushed = 0; \
+    for (int i = 0; i < 2 && pushed < srcLen; ++i) \
+    { \
+        size_t length; \
+        type* span = ctls_cbuf_writeSpan_##suffix(buf, &length); \
+        if (length > srcLen - pushed) \
+            length = srcLen - pushed; \
+        if (!length) \
+            break; \
+        memcpy(span, src + pushed, length * sizeof(type)); \
+        ctls_cbuf_commitWrite_##suffix(buf, length); \
+        pushed += length; \
+    } \
+    return pushed; \
+} \
+\
+bool ctls_cbuf_pop_##suffix(struct ctls_CyclicBuffer_##suffix* restrict buf, type* restrict elem) \
+{ \
+    size_t left = atomic_load_explicit(&buf->left, memory_order_relaxed); \
+    if (left == buf->cachedRight) \
+    { \
+        buf->cachedRight = atomic_load_explicit(&buf->right, memory_order_acquire); \
+        if (left == buf->cachedRight) \
+            return false; \
+    } \
+    if (elem) \
+        *elem = buf->data[left & (buf->capacity - 1)]; \
+    atomic_store_explicit(&buf->left, left + 1, memory_order_release); \
+    return true; \
+} \
+\
+type* ctls_cbuf_readSpan_##suffix(struct ctls_CyclicBuffer_##suffix* buf, size_t* length) \
+{ \
+    size_t left = atomic_load_explicit(&buf->left, memory_order_relaxed), offset = left & (buf->capacity - 1); \
+    buf->cachedRight = atomic_load_explicit(&buf->right, memory_order_acquire); \
+    size_t available = buf->cachedRight - left, contiguous = buf->capacity - offset; \
+    *length = available < contiguous ? available : contiguous; \
+    return buf->data + offset; \
+} \
+\
+void ctls_cbuf_commitRead_##suffix(struct ctls_CyclicBuffer_##suffix* buf, size_t count) \
+{ \
+    size_t left = atomic_load_explicit(&buf->left, memory_order_relaxed); \
+    atomic_store_explicit(&buf->left, left + count, memory_order_release); \
+} \
+\
+size_t ctls_cbuf_popMany_##suffix(struct ctls_CyclicBuffer_##suffix* restrict buf, type* restrict dest, \
+    size_t destLen) \
+{ \
+    size_t popped = 0; \
+    for (int i = 0; i < 2 && popped < destLen; ++i) \
+    { \
+        size_t length; \
+        type* span = ctls_cbuf_readSpan_##suffix(buf, &length); \
+        if (length > destLen - popped) \
+            length = destLen - popped; \
+        if (!length) \
+            break; \
+        memcpy(dest + popped, span, length * sizeof(type)); \
+        ctls_cbuf_commitRead_##suffix(buf, length); \
+        popped += length; \
+    } \
+    return popped; \
+}
+
+/**
+ * @brief a convenience function that calls both `CTLS_CYCLIC_BUFFER_DECL` and `CTLS_CYCLIC_BUFFER_DEF`.
+ * @param type the name of the type to be specialized for
+ * @param suffix a string appended to each declared identifier
+ *
+ * **Usage**
+ * @code
+ * CTLS_CYCLIC_BUFFER(int, int)
+ * @endcode
+ */
+#define CTLS_CYCLIC_BUFFER(type, suffix) \
+CTLS_CYCLIC_BUFFER_DECL(type, suffix) \
+CTLS_CYCLIC_BUFFER_DEF(type, suffix)
+
+#endif
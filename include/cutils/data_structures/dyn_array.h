@@ -10,7 +10,7 @@
  * set to *S*. In short, the size of an element of a given dynamic array should be treated as if it was constant.
  *
  * The following invariants should be adhered to:
- * - `ctls_DynArray::data` must be either `NULL` or dynamically allocated.
+ * - `ctls_DynArray::data` must be either `NULL` or allocated by `ctls_DynArray::allocator`.
  * - If `ctls_DynArray::data != NULL`:
  *     - `ctls_DynArray::capacity` must not be zero.
  *     - `ctls_DynArray::size` must not be greater than `ctls_DynArray::capacity`.
@@ -24,15 +24,40 @@
  *
  * A dynamic array's elements can be accessed via `ctls_DynArray::data`.
  *
+ * All of a dynamic array's memory is obtained through `ctls_DynArray::allocator`. A null allocator denotes `malloc`,
+ * `realloc`, and `free`, so a dynamic array whose members have been zeroed out uses the standard library allocator.
+ * Other allocators, such as those declared in cutils/memory/arena.h, cutils/memory/pool.h, and cutils/memory/bump.h,
+ * can be attached with `ctls_dyn_initWithAllocator()`. `ctls_dyn_initAligned()` attaches one of the allocators declared
+ * in cutils/memory/aligned.h, which keeps `ctls_DynArray::data` aligned to a given boundary across reallocations.
+ *
  * Though a given dynamic array's elements are often all of the same type, there is no reason why they cannot be of
  * different types, as long as each type has the same size.
  *
- * `FE_INEXACT` may be raised during a call to `ctls_dyn_append()`, `ctls_dyn_insert()`, or `ctls_dyn_extend()`.
+ * When a dynamic array runs out of room, its capacity grows according to `ctls_DynArray::growthPolicy`, which may be
+ * assigned at any time. A zeroed-out policy grows by approximately the golden ratio. Growth uses integer arithmetic
+ * only, and mutators that fit within the current capacity never reallocate.
+ *
+ * How often dynamic arrays reallocate and shift their elements, and how much of their capacity goes unused, can be
+ * measured by building with the instrumentation described in cutils/data_structures/dyn_stats.h.
+ *
+ * Unless `CTLS_DYN_NO_INLINE` is defined before this file is included, `ctls_dyn_append()`, `ctls_dyn_insert()`,
+ * `ctls_dyn_extend()`, and `ctls_dyn_swapRemove()` are also defined as function-like macros, which expand to calls to
+ * inline versions of them. The inline versions handle the common case, in which the array does not need to grow,
+ * themselves, and only call the out-of-line functions otherwise. As `elemSize` is usually a constant, compilers turn
+ * their calls to `memcpy` into plain loads and stores, so appending an element of 1, 2, 4, 8, or 16 bytes compiles down
+ * to a capacity check, a store, and an increment. The out-of-line functions are unaffected, and can still be called,
+ * or have their addresses taken, by putting their names in parentheses, as in `(ctls_dyn_append)(arr, &x, sizeof x)`.
  */
 
 #include <stddef.h>
+#include <string.h>
 #include <stdbool.h>
 
+#include "cutils/data_structures/dyn_growth.h"
+#include "cutils/data_structures/dyn_stats.h"
+#include "cutils/memory/aligned.h"
+#include "cutils/memory/allocator.h"
+
 /** @brief A dynamic array. */
 struct ctls_DynArray
 {
@@ -42,6 +67,10 @@ struct ctls_DynArray
     size_t size;
     /** @brief maximum number of elements that can be contained in this dynamic array until it must be expanded */
     size_t capacity;
+    /** @brief the allocator that owns `ctls_DynArray::data`, or `NULL` for the standard library allocator */
+    const struct ctls_Allocator* allocator;
+    /** @brief how this dynamic array's capacity grows once it runs out of room */
+    enum ctls_DynGrowthPolicy growthPolicy;
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -58,13 +87,30 @@ struct ctls_DynArray
  *
  * First, if `dynArr` is null, it is assigned a dynamically allocated dynamic array. Then, `dynArr->data` is assigned a
  * dynamically allocated memory block just large enough for `initialCapacity` elements. If all allocations were
- * successful, `dynArr->capacity` is set to `initialCapacity`, `dynArr->size` is set to zero, and `dynArr` is returned.
+ * successful, `dynArr->capacity` is set to `initialCapacity`, `dynArr->size` is set to zero, `dynArr->growthPolicy` is
+ * set to `CTLS_DYN_GROWTH_GOLDEN`, and `dynArr` is returned.
  * Otherwise, `dynArr` is freed if it was dynamically allocated within the function, and `NULL` is returned.
  *
  * This is only a convenience function. A dynamic array can be initialized manually if desired.
  */
 struct ctls_DynArray* ctls_dyn_init(struct ctls_DynArray* dynArr, size_t initialCapacity, size_t elemSize);
 
+/**
+ * @brief Initializes a dynamic array whose memory is obtained through a given allocator.
+ * @param dynArr pointer to an uninitialized dynamic array, or `NULL`
+ * @param initialCapacity `dynArr`'s chosen initial capacity, must be nonzero
+ * @param elemSize size of one of `dynArr`'s elements
+ * @param allocator the allocator that is to own `dynArr->data`, or `NULL` for the standard library allocator
+ * @return On success, returns a dynamically allocated dynamic array if `dynArr` was originally `NULL`, `dynArr`
+ *     otherwise. On failure, returns `NULL`.
+ *
+ * Behaves like `ctls_dyn_init()`, except that `dynArr->data` is allocated by `allocator`, and `dynArr->allocator` is
+ * set to `allocator`. If `dynArr` is `NULL`, the dynamic array itself is still allocated with `malloc`. `allocator`
+ * must outlive `dynArr->data`.
+ */
+struct ctls_DynArray* ctls_dyn_initWithAllocator(struct ctls_DynArray* dynArr, size_t initialCapacity,
+    size_t elemSize, const struct ctls_Allocator* allocator);
+
 /**
  * @brief Initializes a dynamic array with the default initial capacity.
  * @param dynArr pointer to an uninitialized dynamic array, or `NULL`
@@ -79,6 +125,22 @@ struct ctls_DynArray* ctls_dyn_init(struct ctls_DynArray* dynArr, size_t initial
  */
 struct ctls_DynArray* ctls_dyn_defaultInit(struct ctls_DynArray* dynArr, size_t elemSize);
 
+/**
+ * @brief Initializes a dynamic array whose elements are aligned to a given boundary.
+ * @param dynArr pointer to an uninitialized dynamic array, or `NULL`
+ * @param initialCapacity `dynArr`'s chosen initial capacity, must be nonzero
+ * @param elemSize size of one of `dynArr`'s elements
+ * @param alignment the alignment of `dynArr->data`, in bytes. Must be a power of two no greater than
+ *     `CTLS_MAX_ALIGNMENT`.
+ * @return On success, returns a dynamically allocated dynamic array if `dynArr` was originally `NULL`, `dynArr`
+ *     otherwise. On failure, or if `alignment` is not supported, returns `NULL`.
+ *
+ * Equivalent to `ctls_dyn_initWithAllocator(dynArr, initialCapacity, elemSize, ctls_alignedAllocator(alignment))`.
+ * Since the allocator stays attached, `dynArr->data` remains aligned after every reallocation.
+ */
+struct ctls_DynArray* ctls_dyn_initAligned(struct ctls_DynArray* dynArr, size_t initialCapacity, size_t elemSize,
+    size_t alignment);
+
 /**
  * @brief Frees `dynArr->data` and zeroes `dynArr`'s members out.
  * @param dynArr pointer to an initialized dynamic array
@@ -108,7 +170,8 @@ bool ctls_dyn_shrinkToFit(struct ctls_DynArray* dynArr, size_t elemSize);
  *     failure, returns `NULL`.
  *
  * If the operation succeeds, the dynamic array accessible via the returned pointer has the same size, capacity, and
- * element size as `src`.
+ * element size as `src`. If `dest` had no memory block, the copy's memory is obtained through `src->allocator`;
+ * otherwise, `dest` keeps its own allocator.
  *
  * This is only a convenience function. Making a copy of a dynamic array can be performed manually, if desired. This
  * should be done if, for instance, `src`'s elements are aggregates and must be deep copied.
@@ -174,4 +237,107 @@ bool ctls_dyn_extend(struct ctls_DynArray* dynArr, const void* src, size_t srcLe
  */
 void ctls_dyn_remove(struct ctls_DynArray* dynArr, size_t from, size_t to, size_t elemSize);
 
+/**
+ * @brief Removes several ranges of elements from a dynamic array in a single pass.
+ * @param dynArr pointer to an initialized dynamic array
+ * @param bounds pointer to `2 * rangeCount` indices \f$from_0, to_0, from_1, to_1, ...\f$. Each pair is subject to the
+ *     same requirements as the `from` and `to` parameters of `ctls_dyn_remove()`, and the ranges must be sorted in
+ *     ascending order and must not overlap, so that \f$to_j <= from_{j + 1}\f$.
+ * @param rangeCount number of ranges that are to be removed
+ * @param elemSize size of one of `dynArr`'s elements
+ *
+ * Equivalent to calling `ctls_dyn_remove()` for each range, from the last to the first, except that every remaining
+ * element is moved at most once. Removing \f$k\f$ ranges therefore takes \f$O(size)\f$ time, rather than
+ * \f$O(k \cdot size)\f$.
+ */
+void ctls_dyn_removeRanges(struct ctls_DynArray* dynArr, const size_t* bounds, size_t rangeCount, size_t elemSize);
+
+/**
+ * @brief Removes every element of a dynamic array that satisfies a predicate.
+ * @param dynArr pointer to an initialized dynamic array
+ * @param pred called once for each element, in order, with a pointer to the element and `ctx`. Returns `true` if the
+ *     element is to be removed.
+ * @param ctx passed to `pred` unchanged; may be `NULL`
+ * @param elemSize size of one of `dynArr`'s elements
+ * @return the number of elements removed
+ *
+ * The remaining elements keep their relative order. The array is compacted in a single pass, which moves each run of
+ * remaining elements at most once.
+ */
+size_t ctls_dyn_eraseIf(struct ctls_DynArray* dynArr, bool (*pred)(const void* elem, void* ctx), void* ctx,
+    size_t elemSize);
+
+/**
+ * @brief Removes an element from a dynamic array by moving the last element into its place.
+ * @param dynArr pointer to an initialized dynamic array
+ * @param pos index of the element that is to be removed. Must be between 0 and `dynArr->size - 1`, inclusive.
+ * @param elemSize size of one of `dynArr`'s elements
+ *
+ * Takes constant time, but does not preserve the order of the elements.
+ */
+void ctls_dyn_swapRemove(struct ctls_DynArray* dynArr, size_t pos, size_t elemSize);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Inline Fast Paths
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CTLS_DYN_NO_INLINE
+
+/** @brief The inline version of `ctls_dyn_append()`, which only calls it when `dynArr` must grow. */
+static inline bool ctls_dyn_appendInline(struct ctls_DynArray* restrict dynArr, const void* restrict elem,
+    size_t elemSize)
+{
+    if (dynArr->size == dynArr->capacity)
+        return ctls_dyn_append(dynArr, elem, elemSize);
+    memcpy((char*)dynArr->data + dynArr->size * elemSize, elem, elemSize);
+    ++dynArr->size;
+    return true;
+}
+
+/** @brief The inline version of `ctls_dyn_extend()`, which only calls it when `dynArr` must grow. */
+static inline bool ctls_dyn_extendInline(struct ctls_DynArray* dynArr, const void* src, size_t srcLen,
+    size_t elemSize)
+{
+    if (srcLen > dynArr->capacity - dynArr->size)
+        return ctls_dyn_extend(dynArr, src, srcLen, elemSize);
+    memmove((char*)dynArr->data + dynArr->size * elemSize, src, srcLen * elemSize);
+    dynArr->size += srcLen;
+    return true;
+}
+
+/** @brief The inline version of `ctls_dyn_swapRemove()`. */
+static inline void ctls_dyn_swapRemoveInline(struct ctls_DynArray* dynArr, size_t pos, size_t elemSize)
+{
+    if (pos != --dynArr->size)
+        memcpy((char*)dynArr->data + pos * elemSize, (char*)dynArr->data + dynArr->size * elemSize, elemSize);
+}
+
+// The macros are variadic so that arguments such as compound literals, which may contain commas, pass through intact.
+#define ctls_dyn_append(...) ctls_dyn_appendInline(__VA_ARGS__)
+#define ctls_dyn_extend(...) ctls_dyn_extendInline(__VA_ARGS__)
+#define ctls_dyn_swapRemove(...) ctls_dyn_swapRemoveInline(__VA_ARGS__)
+
+// Shifting elements is recorded by the statistics, which only the out-of-line version can attribute to its site.
+#ifndef CTLS_DYN_STATS
+
+/** @brief The inline version of `ctls_dyn_insert()`, which only calls it when `dynArr` must grow. */
+static inline bool ctls_dyn_insertInline(struct ctls_DynArray* dynArr, const void* src, size_t pos, size_t srcLen,
+    size_t elemSize)
+{
+    if (srcLen > dynArr->capacity - dynArr->size)
+        return ctls_dyn_insert(dynArr, src, pos, srcLen, elemSize);
+    char* data = dynArr->data;
+    CTLS_DYN_PROBE(move, dynArr, (dynArr->size - pos) * elemSize, 0);
+    memmove(data + (pos + srcLen) * elemSize, data + pos * elemSize, (dynArr->size - pos) * elemSize);
+    memmove(data + pos * elemSize, src, srcLen * elemSize);
+    dynArr->size += srcLen;
+    return true;
+}
+
+#define ctls_dyn_insert(...) ctls_dyn_insertInline(__VA_ARGS__)
+
+#endif
+
+#endif
+
 #endif
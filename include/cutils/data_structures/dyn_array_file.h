@@ -0,0 +1,104 @@
+#ifndef CUTILS_DATA_STRUCTURES_DYN_ARRAY_FILE_H_10162026
+#define CUTILS_DATA_STRUCTURES_DYN_ARRAY_FILE_H_10162026
+
+/** @file
+ * @brief Contains a file format for saving the elements of a `ctls_DynArray`, and for viewing them without copying.
+ *
+ * `ctls_dyn_save()` writes a dynamic array's elements to a file, preceded by a header of `CTLS_DYN_FILE_HEADER_SIZE`
+ * bytes. The header records the format's version, the byte order of the machine that wrote the file, the element size,
+ * the number of elements, the alignment of the first element within the file, and a checksum of the elements. The
+ * header and the elements are written with a single `writev` call where possible, to a temporary file that replaces
+ * `path` only once it is complete and has reached the disk, so a crash while saving never leaves a truncated file
+ * behind.
+ *
+ * `ctls_dyn_openView()` maps such a file read-only and returns a `ctls_DynArrayView` whose `data` points straight into
+ * the mapping. Nothing but the header is read, so opening a view takes constant time regardless of the file's size, and
+ * the operating system pages elements in as they are accessed. The elements are as aligned in memory as they are in the
+ * file. Verifying the checksum, on the other hand, reads every element, and so is left to `ctls_dyn_verifyView()`.
+ *
+ * A view that needs to be modified can be copied into a dynamic array:
+ *
+ * @code
+ * struct ctls_DynArrayView view;
+ * struct ctls_DynArray arr;
+ * if (ctls_dyn_openView(&view, "checkpoint.bin", sizeof(struct Order)))
+ * {
+ *     if (ctls_dyn_init(&arr, view.size ? view.size : 1, sizeof(struct Order)))
+ *         ctls_dyn_extend(&arr, view.data, view.size, sizeof(struct Order));
+ *     ctls_dyn_closeView(&view);
+ * }
+ * @endcode
+ *
+ * Elements are stored as raw bytes. A file can only be viewed on a machine with the same byte order as the one that
+ * wrote it, and by a process that agrees on the elements' representation. This file requires a POSIX system.
+ */
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "cutils/data_structures/dyn_array.h"
+
+/** @brief The size of the header that precedes the elements in a file, and the default alignment of the elements. */
+#define CTLS_DYN_FILE_HEADER_SIZE 64
+
+/** @brief A read-only view of the elements saved in a file. */
+struct ctls_DynArrayView
+{
+    /** @brief the first element, which lies within `ctls_DynArrayView::mapping` */
+    const void* data;
+    /** @brief number of elements in the view */
+    size_t size;
+    /** @brief size of one element, as recorded in the file */
+    size_t elemSize;
+    /** @brief the start of the read-only mapping of the file, where the header lies */
+    void* mapping;
+    /** @brief size of the mapping */
+    size_t mappingSize;
+};
+
+/**
+ * @brief Saves a dynamic array's elements to a file.
+ * @param dynArr pointer to an initialized dynamic array
+ * @param path path of the file that is to be written; an existing file is replaced
+ * @param elemSize size of one of `dynArr`'s elements
+ * @param alignment the alignment of the first element within the file, or zero for `CTLS_DYN_FILE_HEADER_SIZE`. Must be
+ *     a power of two no greater than `CTLS_MAX_ALIGNMENT`.
+ * @return `true` if the operation succeeds, `false` if not
+ *
+ * Only `dynArr->size` elements are saved; the file does not record `dynArr`'s capacity. If the operation fails, the
+ * file at `path` is left untouched.
+ */
+bool ctls_dyn_save(const struct ctls_DynArray* dynArr, const char* path, size_t elemSize, size_t alignment);
+
+/**
+ * @brief Opens a read-only view of the elements in a file written by `ctls_dyn_save()`.
+ * @param view pointer to an uninitialized view, or `NULL`
+ * @param path path of the file
+ * @param elemSize the expected size of one element
+ * @return On success, returns a dynamically allocated view if `view` was originally `NULL`, `view` otherwise. On
+ *     failure, returns `NULL`.
+ *
+ * The operation fails if the file's header is invalid, if it was written by a machine of a different byte order or by
+ * an unknown version of this library, or if it records a different element size. The elements must not be modified
+ * through `view->data`. Changes made to the file after the view is opened may or may not be seen through it.
+ */
+struct ctls_DynArrayView* ctls_dyn_openView(struct ctls_DynArrayView* view, const char* path, size_t elemSize);
+
+/**
+ * @brief Checks that the elements in a view match the checksum recorded in its file.
+ * @param view pointer to an open view
+ * @return `true` if they match, `false` if not
+ *
+ * Reads every element, so takes time proportional to the size of the file.
+ */
+bool ctls_dyn_verifyView(const struct ctls_DynArrayView* view);
+
+/**
+ * @brief Unmaps a view's file and zeroes the view out.
+ * @param view pointer to an open view
+ *
+ * A view allocated by `ctls_dyn_openView()` must still be freed with `free`.
+ */
+void ctls_dyn_closeView(struct ctls_DynArrayView* view);
+
+#endif
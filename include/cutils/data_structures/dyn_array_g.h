@@ -32,20 +32,29 @@
  *     specialization.
  * - A generic function has no `elemSize` parameter.
  * - For a specialization for type *T*, `ctls_dyn_append`'s parameter `elem` is of type *T*, rather than
- *     `const void* restrict`.
+ *     `const void* restrict`, and `ctls_dyn_eraseIf`'s predicate takes a `type const*` rather than a `const void*`.
  *
  * It should be noted that the functions and objects associated with a given specialization of `ctls_DynArray` have
  * external linkage if the corresponding functions and objects are declared in cutils/data_structures/dyn_array.h.
+ *
+ * Each specialization carries an `allocator` member, just like `ctls_DynArray`. A specialization defined with
+ * `CTLS_DYN_ARRAY_DEF_WITH_ALLOCATOR` attaches a given allocator to every dynamic array it initializes, unless
+ * `ctls_dyn_initWithAllocator_##suffix` is used to choose another.
  */
 
 #include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
-#include <math.h>
+#include <stdint.h>
 
+#include "cutils/data_structures/dyn_growth.h"
+#include "cutils/data_structures/dyn_stats.h"
 #include "cutils/math/constants.h"
+#include "cutils/memory/aligned.h"
+#include "cutils/memory/allocator.h"
 
+/** @brief the nominal growth factor of `CTLS_DYN_GROWTH_GOLDEN` */
 #define CTLS_DYN_GROWTH_FACTOR CTLS_PHI
 #define CTLS_DYN_DEFAULT_INITIAL_CAPACITY 8
 
@@ -75,11 +84,17 @@ struct ctls_DynArray_##suffix \
 { \
     type* data; \
     size_t size, capacity; \
+    const struct ctls_Allocator* allocator; \
+    enum ctls_DynGrowthPolicy growthPolicy; \
 }; \
 \
 struct ctls_DynArray_##suffix* ctls_dyn_init_##suffix(struct ctls_DynArray_##suffix* dynArr, \
     size_t initialCapacity); \
+struct ctls_DynArray_##suffix* ctls_dyn_initWithAllocator_##suffix(struct ctls_DynArray_##suffix* dynArr, \
+    size_t initialCapacity, const struct ctls_Allocator* allocator); \
 struct ctls_DynArray_##suffix* ctls_dyn_defaultInit_##suffix(struct ctls_DynArray_##suffix* dynArr); \
+struct ctls_DynArray_##suffix* ctls_dyn_initAligned_##suffix(struct ctls_DynArray_##suffix* dynArr, \
+    size_t initialCapacity, size_t alignment); \
 void ctls_dyn_reset_##suffix(struct ctls_DynArray_##suffix* dynArr); \
 bool ctls_dyn_shrinkToFit_##suffix(struct ctls_DynArray_##suffix* dynArr); \
 struct ctls_DynArray_##suffix* ctls_dyn_copy_##suffix(struct ctls_DynArray_##suffix* restrict dest, \
@@ -88,42 +103,71 @@ bool ctls_dyn_append_##suffix(struct ctls_DynArray_##suffix* dynArr, type elem);
 bool ctls_dyn_insert_##suffix(struct ctls_DynArray_##suffix* dynArr, type const* src, size_t pos, \
     size_t srcLen); \
 bool ctls_dyn_extend_##suffix(struct ctls_DynArray_##suffix* dynArr, type const* src, size_t srcLen); \
-void ctls_dyn_remove_##suffix(struct ctls_DynArray_##suffix* dynArr, size_t from, size_t to);
+void ctls_dyn_remove_##suffix(struct ctls_DynArray_##suffix* dynArr, size_t from, size_t to); \
+void ctls_dyn_removeRanges_##suffix(struct ctls_DynArray_##suffix* dynArr, const size_t* bounds, \
+    size_t rangeCount); \
+size_t ctls_dyn_eraseIf_##suffix(struct ctls_DynArray_##suffix* dynArr, bool (*pred)(type const* elem, void* ctx), \
+    void* ctx); \
+void ctls_dyn_swapRemove_##suffix(struct ctls_DynArray_##suffix* dynArr, size_t pos);
 
 /**
- * @brief Creates definitions for a specialization of `ctls_DynArray`.
+ * @brief Creates definitions for a specialization of `ctls_DynArray` whose dynamic arrays use a given allocator.
  * @param type the name of the type to be specialized for
  * @param suffix a string appended to each declared identifier
+ * @param defaultAllocator an expression of type `const struct ctls_Allocator*`, evaluated each time a dynamic array is
+ *     initialized via `ctls_dyn_init_##suffix` or `ctls_dyn_defaultInit_##suffix`. `NULL` denotes the standard library
+ *     allocator.
  *
  * The corresponding declarations can, and should, be included via `CTLS_DYN_ARRAY_DECL`.
  *
  * **Usage**
  * @code
+ * extern struct ctls_Arena requestArena;
+ *
  * CTLS_DYN_ARRAY_DECL(int, int)
- * CTLS_DYN_ARRAY_DEF(int, int)
+ * CTLS_DYN_ARRAY_DEF_WITH_ALLOCATOR(int, int, &requestArena.allocator)
  * @endcode
  */
-#define CTLS_DYN_ARRAY_DEF(type, suffix) \
+#define CTLS_DYN_ARRAY_DEF_WITH_ALLOCATOR(type, suffix, defaultAllocator) \
+\
+CTLS_DYN_STATS_SITE(ctls_dyn_stats_##suffix, #suffix) \
 \
 static bool ctls_dyn_reallocData_##suffix(struct ctls_DynArray_##suffix* dynArr, size_t newCapacity) \
 { \
-    type* newData = realloc(dynArr->data, newCapacity * sizeof(type)); \
+    type* newData = ctls_reallocate(dynArr->allocator, dynArr->data, dynArr->capacity * sizeof(type), \
+        newCapacity * sizeof(type)); \
     if (newData) \
+    { \
+        CTLS_DYN_ON_REALLOC(ctls_dyn_stats_##suffix, dynArr, dynArr->capacity, newCapacity, sizeof(type)); \
         dynArr->data = newData, dynArr->capacity = newCapacity; \
+    } \
     return newData; \
 } \
 \
-struct ctls_DynArray_##suffix* ctls_dyn_init_##suffix(struct ctls_DynArray_##suffix* dynArr, \
-    size_t initialCapacity) \
+static bool ctls_dyn_grow_##suffix(struct ctls_DynArray_##suffix* dynArr, size_t srcLen) \
+{ \
+    if (srcLen > SIZE_MAX - dynArr->size) \
+        return false; \
+    size_t newCapacity = ctls_dyn_grownCapacity(dynArr->growthPolicy, dynArr->capacity, dynArr->size + srcLen, \
+        sizeof(type)); \
+    return newCapacity && ctls_dyn_reallocData_##suffix(dynArr, newCapacity); \
+} \
+\
+struct ctls_DynArray_##suffix* ctls_dyn_initWithAllocator_##suffix(struct ctls_DynArray_##suffix* dynArr, \
+    size_t initialCapacity, const struct ctls_Allocator* allocator) \
 { \
     bool dynArrOriginallyNull = !dynArr; \
     if (dynArrOriginallyNull) \
         dynArr = malloc(sizeof *dynArr); \
     if (dynArr) \
     { \
-        void* newData = malloc(initialCapacity * sizeof(type)); \
+        void* newData = ctls_allocate(allocator, initialCapacity * sizeof(type)); \
         if (newData) \
-            *dynArr = (struct ctls_DynArray_##suffix){newData, 0, initialCapacity}; \
+        { \
+            *dynArr = (struct ctls_DynArray_##suffix){newData, 0, initialCapacity, allocator, \
+                CTLS_DYN_GROWTH_GOLDEN}; \
+            CTLS_DYN_ON_INIT(ctls_dyn_stats_##suffix, dynArr, sizeof(type)); \
+        } \
         else \
         { \
             if (dynArrOriginallyNull) \
@@ -134,14 +178,28 @@ struct ctls_DynArray_##suffix* ctls_dyn_init_##suffix(struct ctls_DynArray_##suf
     return dynArr; \
 } \
 \
+struct ctls_DynArray_##suffix* ctls_dyn_init_##suffix(struct ctls_DynArray_##suffix* dynArr, \
+    size_t initialCapacity) \
+{ \
+    return ctls_dyn_initWithAllocator_##suffix(dynArr, initialCapacity, (defaultAllocator)); \
+} \
+\
 struct ctls_DynArray_##suffix* ctls_dyn_defaultInit_##suffix(struct ctls_DynArray_##suffix* dynArr) \
 { \
     return ctls_dyn_init_##suffix(dynArr, CTLS_DYN_DEFAULT_INITIAL_CAPACITY); \
 } \
 \
+struct ctls_DynArray_##suffix* ctls_dyn_initAligned_##suffix(struct ctls_DynArray_##suffix* dynArr, \
+    size_t initialCapacity, size_t alignment) \
+{ \
+    const struct ctls_Allocator* allocator = ctls_alignedAllocator(alignment); \
+    return allocator ? ctls_dyn_initWithAllocator_##suffix(dynArr, initialCapacity, allocator) : NULL; \
+} \
+\
 void ctls_dyn_reset_##suffix(struct ctls_DynArray_##suffix* dynArr) \
 { \
-    free(dynArr->data); \
+    CTLS_DYN_ON_RESET(ctls_dyn_stats_##suffix, dynArr, sizeof(type)); \
+    ctls_deallocate(dynArr->allocator, dynArr->data, dynArr->capacity * sizeof(type)); \
     memset(dynArr, 0, sizeof(struct ctls_DynArray_##suffix)); \
 } \
 \
@@ -153,10 +211,9 @@ bool ctls_dyn_shrinkToFit_##suffix(struct ctls_DynArray_##suffix* dynArr) \
 struct ctls_DynArray_##suffix* ctls_dyn_copy_##suffix(struct ctls_DynArray_##suffix* restrict dest, \
     const struct ctls_DynArray_##suffix* restrict src) \
 { \
-    bool destOriginallyNull = !dest; \
     if (!dest || !dest->data) \
     { \
-        dest = ctls_dyn_init_##suffix(dest, src->capacity); \
+        dest = ctls_dyn_initWithAllocator_##suffix(dest, src->capacity, src->allocator); \
         if (!dest) \
             return NULL; \
     } \
@@ -169,12 +226,8 @@ struct ctls_DynArray_##suffix* ctls_dyn_copy_##suffix(struct ctls_DynArray_##suf
 \
 bool ctls_dyn_append_##suffix(struct ctls_DynArray_##suffix* dynArr, type elem) \
 { \
-    if (dynArr->size == dynArr->capacity) \
-    { \
-        size_t newCapacity = round(CTLS_DYN_GROWTH_FACTOR * dynArr->capacity); \
-        if (newCapacity < dynArr->capacity || !ctls_dyn_reallocData_##suffix(dynArr, newCapacity)) \
-            return false; \
-    } \
+    if (dynArr->size == dynArr->capacity && !ctls_dyn_grow_##suffix(dynArr, 1)) \
+        return false; \
     dynArr->data[dynArr->size++] = elem; \
     return true; \
 } \
@@ -182,14 +235,9 @@ bool ctls_dyn_append_##suffix(struct ctls_DynArray_##suffix* dynArr, type elem)
 bool ctls_dyn_insert_##suffix(struct ctls_DynArray_##suffix* dynArr, type const* src, size_t pos, \
     size_t srcLen) \
 { \
-    size_t n = dynArr->capacity; \
-    for (; n < dynArr->size + srcLen; n = round(CTLS_DYN_GROWTH_FACTOR * n)) \
-    { \
-        if (n < dynArr->capacity) \
-            return false; \
-    } \
-    if (!ctls_dyn_reallocData_##suffix(dynArr, n)) \
+    if (srcLen > dynArr->capacity - dynArr->size && !ctls_dyn_grow_##suffix(dynArr, srcLen)) \
         return false; \
+    CTLS_DYN_ON_MOVE(ctls_dyn_stats_##suffix, dynArr, (dynArr->size - pos) * sizeof(type)); \
     memmove(dynArr->data + pos + srcLen, dynArr->data + pos, (dynArr->size - pos) * sizeof(type)); \
     memmove(dynArr->data + pos, src, srcLen * sizeof(type)); \
     dynArr->size += srcLen; \
@@ -203,10 +251,66 @@ bool ctls_dyn_extend_##suffix(struct ctls_DynArray_##suffix* dynArr, type const*
 \
 void ctls_dyn_remove_##suffix(struct ctls_DynArray_##suffix* dynArr, size_t from, size_t to) \
 { \
+    CTLS_DYN_ON_MOVE(ctls_dyn_stats_##suffix, dynArr, (dynArr->size - to) * sizeof(type)); \
     memmove(dynArr->data + from, dynArr->data + to, (dynArr->size - to) * sizeof(type)); \
     dynArr->size -= (to - from); \
+} \
+\
+void ctls_dyn_removeRanges_##suffix(struct ctls_DynArray_##suffix* dynArr, const size_t* bounds, \
+    size_t rangeCount) \
+{ \
+    if (!rangeCount) \
+        return; \
+    size_t kept = bounds[0]; \
+    for (size_t i = 0; i < rangeCount; ++i) \
+    { \
+        size_t to = bounds[2 * i + 1], next = i + 1 < rangeCount ? bounds[2 * i + 2] : dynArr->size; \
+        memmove(dynArr->data + kept, dynArr->data + to, (next - to) * sizeof(type)); \
+        kept += next - to; \
+    } \
+    CTLS_DYN_ON_MOVE(ctls_dyn_stats_##suffix, dynArr, (kept - bounds[0]) * sizeof(type)); \
+    dynArr->size = kept; \
+} \
+\
+size_t ctls_dyn_eraseIf_##suffix(struct ctls_DynArray_##suffix* dynArr, bool (*pred)(type const* elem, void* ctx), \
+    void* ctx) \
+{ \
+    size_t first = 0; \
+    while (first < dynArr->size && !pred(dynArr->data + first, ctx)) \
+        ++first; \
+    size_t kept = first; \
+    for (size_t i = first + 1; i < dynArr->size; ++i) \
+    { \
+        if (!pred(dynArr->data + i, ctx)) \
+            dynArr->data[kept++] = dynArr->data[i]; \
+    } \
+    CTLS_DYN_ON_MOVE(ctls_dyn_stats_##suffix, dynArr, (kept - first) * sizeof(type)); \
+    size_t removed = dynArr->size - kept; \
+    dynArr->size = kept; \
+    return removed; \
+} \
+\
+void ctls_dyn_swapRemove_##suffix(struct ctls_DynArray_##suffix* dynArr, size_t pos) \
+{ \
+    dynArr->data[pos] = dynArr->data[--dynArr->size]; \
 }
 
+/**
+ * @brief Creates definitions for a specialization of `ctls_DynArray`.
+ * @param type the name of the type to be specialized for
+ * @param suffix a string appended to each declared identifier
+ *
+ * The corresponding declarations can, and should, be included via `CTLS_DYN_ARRAY_DECL`. Equivalent to
+ * `CTLS_DYN_ARRAY_DEF_WITH_ALLOCATOR(type, suffix, NULL)`.
+ *
+ * **Usage**
+ * @code
+ * CTLS_DYN_ARRAY_DECL(int, int)
+ * CTLS_DYN_ARRAY_DEF(int, int)
+ * @endcode
+ */
+#define CTLS_DYN_ARRAY_DEF(type, suffix) CTLS_DYN_ARRAY_DEF_WITH_ALLOCATOR(type, suffix, NULL)
+
 /**
  * @brief a convenience function that calls both `CTLS_DYN_ARRAY_DECL` and `CTLS_DYN_ARRAY_DEF`.
  * @param type the name of the type to be specialized for
@@ -0,0 +1,269 @@
+#ifndef CUTILS_DATA_STRUCTURES_DYN_ARRAY_KERNELS_G_H_10162026
+#define CUTILS_DATA_STRUCTURES_DYN_ARRAY_KERNELS_G_H_10162026
+
+/** @file
+ * @brief Contains optional search, fill, and reduction functions for specializations of `ctls_DynArray`.
+ *
+ * The macros in this file add functions to a specialization created with the macros in
+ * cutils/data_structures/dyn_array_g.h. They take the same `type` and `suffix` arguments, which must name an existing
+ * specialization for an arithmetic type, plus a `sumType` argument, the type sums are returned in.
+ *
+ * If `type` is `int32_t`, `uint32_t`, `int64_t`, `uint64_t`, `float`, or `double`, the functions forward to the
+ * vectorized kernels declared in cutils/simd/kernels.h, which are dispatched at runtime to SSE2 or AVX2. The choice is
+ * made at compile time, so no overhead is incurred. For other types, such as `short` and `long long`, as well as for
+ * unsigned sums and extrema, a scalar loop is used instead. Sums are computed in `sumType`, or wider, so the sum of a
+ * `float` array is only computed in single precision if `sumType` is `float`. Where no kernel computes in a type at
+ * least as precise as `sumType`, such as for 64-bit integers summed in `double` or `double` summed in `long double`,
+ * the scalar loop is used as well. The caveats listed in cutils/simd/kernels.h regarding NaNs and the order of
+ * floating-point addition apply.
+ *
+ * **Usage**
+ * @code
+ * CTLS_DYN_ARRAY(double, double)
+ * CTLS_DYN_ARRAY_KERNELS(double, double, double)
+ *
+ * double mean(const struct ctls_DynArray_double* arr)
+ * {
+ *     return ctls_dyn_sum_double(arr) / arr->size;
+ * }
+ * @endcode
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "cutils/simd/kernels.h"
+
+/** @brief Classifies `type` by the kernels in cutils/simd/kernels.h that can operate on it. */
+#define CTLS_DYN_KERNEL_CLASS(type) _Generic((type*)0, \
+    int32_t*: 1, \
+    uint32_t*: 2, \
+    int64_t*: 3, \
+    uint64_t*: 4, \
+    float*: 5, \
+    double*: 6, \
+    default: 0)
+
+/**
+ * @brief Classifies `sumType` by the kernels that may compute sums returned in it: 1 for `float`, 2 for `double`, 3 for
+ *     a standard integer type, and 0 for any other type, such as `long double`, which is summed by a scalar loop
+ *     instead.
+ *
+ * The 64-bit integer kernels wrap modulo 2^64, which matches summing in an integer type of at most 64 bits, but not in
+ * a floating-point type. The `double` kernel computes in `double`, which is narrower than `long double`.
+ */
+#define CTLS_DYN_SUM_CLASS(sumType) _Generic((sumType*)0, \
+    float*: 1, \
+    double*: 2, \
+    char*: 3, \
+    signed char*: 3, \
+    unsigned char*: 3, \
+    short*: 3, \
+    unsigned short*: 3, \
+    int*: 3, \
+    unsigned*: 3, \
+    long*: 3, \
+    unsigned long*: 3, \
+    long long*: 3, \
+    unsigned long long*: 3, \
+    default: 0)
+
+/**
+ * @brief Creates declarations for the search, fill, and reduction functions of a specialization of `ctls_DynArray`.
+ * @param type the name of the type the specialization is for
+ * @param suffix the suffix of the specialization
+ * @param sumType the type `ctls_dyn_sum_##suffix` returns
+ *
+ * The following functions are declared:
+ * - `size_t ctls_dyn_find_##suffix(dynArr, value)` returns the index of the first element equal to `value`, or
+ *     `dynArr->size` if there is none.
+ * - `bool ctls_dyn_contains_##suffix(dynArr, value)` returns whether any element is equal to `value`.
+ * - `size_t ctls_dyn_count_##suffix(dynArr, value)` returns the number of elements equal to `value`.
+ * - `void ctls_dyn_fill_##suffix(dynArr, value)` assigns `value` to every element.
+ * - `sumType ctls_dyn_sum_##suffix(dynArr)` returns the sum of the elements.
+ * - `type ctls_dyn_min_##suffix(dynArr)` and `type ctls_dyn_max_##suffix(dynArr)` return the smallest and largest
+ *     element. `dynArr` must not be empty.
+ * - `bool ctls_dyn_equal_##suffix(a, b)` returns whether `a` and `b` have the same size and bitwise identical
+ *     elements.
+ */
+#define CTLS_DYN_ARRAY_KERNELS_DECL(type, suffix, sumType) \
+\
+size_t ctls_dyn_find_##suffix(const struct ctls_DynArray_##suffix* dynArr, type value); \
+bool ctls_dyn_contains_##suffix(const struct ctls_DynArray_##suffix* dynArr, type value); \
+size_t ctls_dyn_count_##suffix(const struct ctls_DynArray_##suffix* dynArr, type value); \
+void ctls_dyn_fill_##suffix(struct ctls_DynArray_##suffix* dynArr, type value); \
+sumType ctls_dyn_sum_##suffix(const struct ctls_DynArray_##suffix* dynArr); \
+type ctls_dyn_min_##suffix(const struct ctls_DynArray_##suffix* dynArr); \
+type ctls_dyn_max_##suffix(const struct ctls_DynArray_##suffix* dynArr); \
+bool ctls_dyn_equal_##suffix(const struct ctls_DynArray_##suffix* a, const struct ctls_DynArray_##suffix* b);
+
+/**
+ * @brief Creates definitions for the search, fill, and reduction functions of a specialization of `ctls_DynArray`.
+ * @param type the name of the type the specialization is for
+ * @param suffix the suffix of the specialization
+ * @param sumType the type `ctls_dyn_sum_##suffix` returns
+ *
+ * The corresponding declarations can, and should, be included via `CTLS_DYN_ARRAY_KERNELS_DECL`.
+ */
+#define CTLS_DYN_ARRAY_KERNELS_DEF(type, suffix, sumType) \
+\
+size_t ctls_dyn_find_##suffix(const struct ctls_DynArray_##suffix* dynArr, type value) \
+{ \
+    switch (CTLS_DYN_KERNEL_CLASS(type)) \
+    { \
+    case 1: case 2: \
+        return ctls_simd_find_i32((const int32_t*)dynArr->data, dynArr->size, (int32_t)value); \
+    case 3: case 4: \
+        return ctls_simd_find_i64((const int64_t*)dynArr->data, dynArr->size, (int64_t)value); \
+    case 5: \
+        return ctls_simd_find_f32((const float*)dynArr->data, dynArr->size, (float)value); \
+    case 6: \
+        return ctls_simd_find_f64((const double*)dynArr->data, dynArr->size, (double)value); \
+    } \
+    for (size_t i = 0; i < dynArr->size; ++i) \
+    { \
+        if (dynArr->data[i] == value) \
+            return i; \
+    } \
+    return dynArr->size; \
+} \
+\
+bool ctls_dyn_contains_##suffix(const struct ctls_DynArray_##suffix* dynArr, type value) \
+{ \
+    return ctls_dyn_find_##suffix(dynArr, value) != dynArr->size; \
+} \
+\
+size_t ctls_dyn_count_##suffix(const struct ctls_DynArray_##suffix* dynArr, type value) \
+{ \
+    switch (CTLS_DYN_KERNEL_CLASS(type)) \
+    { \
+    case 1: case 2: \
+        return ctls_simd_count_i32((const int32_t*)dynArr->data, dynArr->size, (int32_t)value); \
+    case 3: case 4: \
+        return ctls_simd_count_i64((const int64_t*)dynArr->data, dynArr->size, (int64_t)value); \
+    case 5: \
+        return ctls_simd_count_f32((const float*)dynArr->data, dynArr->size, (float)value); \
+    case 6: \
+        return ctls_simd_count_f64((const double*)dynArr->data, dynArr->size, (double)value); \
+    } \
+    size_t count = 0; \
+    for (size_t i = 0; i < dynArr->size; ++i) \
+        count += dynArr->data[i] == value; \
+    return count; \
+} \
+\
+void ctls_dyn_fill_##suffix(struct ctls_DynArray_##suffix* dynArr, type value) \
+{ \
+    switch (CTLS_DYN_KERNEL_CLASS(type)) \
+    { \
+    case 1: case 2: \
+        ctls_simd_fill_i32((int32_t*)dynArr->data, dynArr->size, (int32_t)value); \
+        return; \
+    case 3: case 4: \
+        ctls_simd_fill_i64((int64_t*)dynArr->data, dynArr->size, (int64_t)value); \
+        return; \
+    case 5: \
+        ctls_simd_fill_f32((float*)dynArr->data, dynArr->size, (float)value); \
+        return; \
+    case 6: \
+        ctls_simd_fill_f64((double*)dynArr->data, dynArr->size, (double)value); \
+        return; \
+    } \
+    for (size_t i = 0; i < dynArr->size; ++i) \
+        dynArr->data[i] = value; \
+} \
+\
+sumType ctls_dyn_sum_##suffix(const struct ctls_DynArray_##suffix* dynArr) \
+{ \
+    switch (CTLS_DYN_KERNEL_CLASS(type)) \
+    { \
+    case 1: \
+        /* Computed in int64_t, which holds the sum of any array of int32_t exactly. */ \
+        return (sumType)ctls_simd_sum_i32((const int32_t*)dynArr->data, dynArr->size); \
+    case 3: \
+        if (CTLS_DYN_SUM_CLASS(sumType) == 3) \
+            return (sumType)ctls_simd_sum_i64((const int64_t*)dynArr->data, dynArr->size); \
+        break; \
+    case 4: \
+        if (CTLS_DYN_SUM_CLASS(sumType) == 3) \
+            return (sumType)(uint64_t)ctls_simd_sum_i64((const int64_t*)dynArr->data, dynArr->size); \
+        break; \
+    case 5: \
+        /* A float sum is only computed in float if that is what it is returned in. */ \
+        if (CTLS_DYN_SUM_CLASS(sumType) == 1) \
+            return (sumType)ctls_simd_sum_f32((const float*)dynArr->data, dynArr->size); \
+        if (CTLS_DYN_SUM_CLASS(sumType) == 2) \
+            return (sumType)ctls_simd_sumWide_f32((const float*)dynArr->data, dynArr->size); \
+        break; \
+    case 6: \
+        if (CTLS_DYN_SUM_CLASS(sumType) == 2) \
+            return (sumType)ctls_simd_sum_f64((const double*)dynArr->data, dynArr->size); \
+        break; \
+    } \
+    sumType sum = 0; \
+    for (size_t i = 0; i < dynArr->size; ++i) \
+        sum += dynArr->data[i]; \
+    return sum; \
+} \
+\
+type ctls_dyn_min_##suffix(const struct ctls_DynArray_##suffix* dynArr) \
+{ \
+    switch (CTLS_DYN_KERNEL_CLASS(type)) \
+    { \
+    case 1: \
+        return (type)ctls_simd_min_i32((const int32_t*)dynArr->data, dynArr->size); \
+    case 3: \
+        return (type)ctls_simd_min_i64((const int64_t*)dynArr->data, dynArr->size); \
+    case 5: \
+        return (type)ctls_simd_min_f32((const float*)dynArr->data, dynArr->size); \
+    case 6: \
+        return (type)ctls_simd_min_f64((const double*)dynArr->data, dynArr->size); \
+    } \
+    type min = dynArr->data[0]; \
+    for (size_t i = 1; i < dynArr->size; ++i) \
+        min = dynArr->data[i] < min ? dynArr->data[i] : min; \
+    return min; \
+} \
+\
+type ctls_dyn_max_##suffix(const struct ctls_DynArray_##suffix* dynArr) \
+{ \
+    switch (CTLS_DYN_KERNEL_CLASS(type)) \
+    { \
+    case 1: \
+        return (type)ctls_simd_max_i32((const int32_t*)dynArr->data, dynArr->size); \
+    case 3: \
+        return (type)ctls_simd_max_i64((const int64_t*)dynArr->data, dynArr->size); \
+    case 5: \
+        return (type)ctls_simd_max_f32((const float*)dynArr->data, dynArr->size); \
+    case 6: \
+        return (type)ctls_simd_max_f64((const double*)dynArr->data, dynArr->size); \
+    } \
+    type max = dynArr->data[0]; \
+    for (size_t i = 1; i < dynArr->size; ++i) \
+        max = dynArr->data[i] > max ? dynArr->data[i] : max; \
+    return max; \
+} \
+\
+bool ctls_dyn_equal_##suffix(const struct ctls_DynArray_##suffix* a, const struct ctls_DynArray_##suffix* b) \
+{ \
+    return a->size == b->size && (!a->size || ctls_simd_equal(a->data, b->data, a->size * sizeof(type))); \
+}
+
+/**
+ * @brief a convenience function that calls both `CTLS_DYN_ARRAY_KERNELS_DECL` and `CTLS_DYN_ARRAY_KERNELS_DEF`.
+ * @param type the name of the type the specialization is for
+ * @param suffix the suffix of the specialization
+ * @param sumType the type `ctls_dyn_sum_##suffix` returns
+ *
+ * **Usage**
+ * @code
+ * CTLS_DYN_ARRAY(int, int)
+ * CTLS_DYN_ARRAY_KERNELS(int, int, long long)
+ * @endcode
+ */
+#define CTLS_DYN_ARRAY_KERNELS(type, suffix, sumType) \
+CTLS_DYN_ARRAY_KERNELS_DECL(type, suffix, sumType) \
+CTLS_DYN_ARRAY_KERNELS_DEF(type, suffix, sumType)
+
+#endif
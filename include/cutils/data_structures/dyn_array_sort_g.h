@@ -0,0 +1,533 @@
+#ifndef CUTILS_DATA_STRUCTURES_DYN_ARRAY_SORT_G_H_10162026
+#define CUTILS_DATA_STRUCTURES_DYN_ARRAY_SORT_G_H_10162026
+
+/** @file
+ * @brief Contains optional sorting and binary search functions for specializations of `ctls_DynArray`.
+ *
+ * The macros in this file add functions to a specialization created with the macros in
+ * cutils/data_structures/dyn_array_g.h. They take the same `type` and `suffix` arguments, which must name an existing
+ * specialization. `CTLS_DYN_ARRAY_SORT` also takes a `less` argument, the name of a function or function-like macro
+ * such that `less(a, b)` is nonzero if and only if the element `a` is ordered before the element `b`. `less` must be a
+ * strict weak ordering. Because it is expanded into every generated function, the comparison is inlined, unlike the
+ * one `qsort` calls through a function pointer.
+ *
+ * `ctls_dyn_sort_##suffix` is a pattern-defeating quicksort. It partitions around the median of three elements, or of
+ * nine for large ranges, sorts small ranges by insertion, and recognizes ranges that are already sorted or consist of
+ * equal elements in linear time. Unbalanced partitions make it shuffle a few elements to break up adversarial
+ * patterns, and after too many, it switches to heapsort, so the worst case remains \f$O(n \log n)\f$. It is not
+ * stable.
+ *
+ * `ctls_dyn_stableSort_##suffix` and `ctls_dyn_parallelSort_##suffix` are merge sorts, and are stable. The latter
+ * sorts the halves of the array on separate threads, recursively, and merges them as the threads finish. A program
+ * that uses it must be linked against the POSIX threads library.
+ *
+ * `CTLS_DYN_ARRAY_RADIX_SORT` adds a least-significant-digit radix sort for elements with unsigned integer keys,
+ * which needs no comparisons at all. It is stable.
+ *
+ * **Usage**
+ * @code
+ * #define LESS(a, b) ((a).priority < (b).priority)
+ * #define KEY(task) ((task).priority)
+ *
+ * CTLS_DYN_ARRAY(struct Task, task)
+ * CTLS_DYN_ARRAY_SORT(struct Task, task, LESS)
+ * CTLS_DYN_ARRAY_RADIX_SORT(struct Task, task, uint32_t, KEY)
+ * @endcode
+ */
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <pthread.h>
+
+#include "cutils/data_structures/dyn_growth.h"
+#include "cutils/memory/allocator.h"
+
+/** @brief Ranges shorter than this are sorted by insertion. */
+#define CTLS_DYN_SORT_INSERTION_THRESHOLD 24
+/** @brief Ranges at least this long are partitioned around the median of nine elements, rather than three. */
+#define CTLS_DYN_SORT_NINTHER_THRESHOLD 128
+/** @brief `ctls_dyn_parallelSort_##suffix` sorts ranges shorter than this on the calling thread. */
+#define CTLS_DYN_PARALLEL_SORT_GRAIN 16384
+
+/**
+ * @brief Maps a signed integer to a radix sort key of unsigned type `keyType` that preserves its order.
+ * @param keyType an unsigned integer type as wide as the type of `x`
+ * @param x a signed integer
+ */
+#define CTLS_DYN_SIGNED_KEY(keyType, x) ((keyType)(x) ^ ((keyType)1 << (sizeof(keyType) * 8 - 1)))
+
+/**
+ * @brief Creates declarations for the sorting and binary search functions of a specialization of `ctls_DynArray`.
+ * @param type the name of the type the specialization is for
+ * @param suffix the suffix of the specialization
+ *
+ * The following functions are declared:
+ * - `void ctls_dyn_sort_##suffix(dynArr)` sorts the elements.
+ * - `bool ctls_dyn_stableSort_##suffix(dynArr)` sorts the elements, preserving the order of equivalent ones. It
+ *     allocates a buffer of `dynArr->size / 2` elements through `dynArr->allocator`, and returns `false`, leaving
+ *     `dynArr` unchanged, if that fails.
+ * - `bool ctls_dyn_parallelSort_##suffix(dynArr, threadCount)` behaves like `ctls_dyn_stableSort_##suffix`, but uses
+ *     up to `threadCount` threads, counting the calling one, and a buffer of `dynArr->size` elements. If a thread
+ *     cannot be created, its work is done by the thread that would have created it.
+ * - `size_t ctls_dyn_lowerBound_##suffix(dynArr, value)` returns the index of the first element not ordered before
+ *     `value`, or `dynArr->size` if there is none. `dynArr` must be sorted.
+ * - `size_t ctls_dyn_upperBound_##suffix(dynArr, value)` returns the index of the first element ordered after
+ *     `value`, or `dynArr->size` if there is none. `dynArr` must be sorted.
+ * - `bool ctls_dyn_insertSorted_##suffix(dynArr, elem)` inserts `elem` after every element not ordered after it, so
+ *     that `dynArr` remains sorted, and returns `true` on success. `dynArr` must be sorted.
+ */
+#define CTLS_DYN_ARRAY_SORT_DECL(type, suffix) \
+\
+void ctls_dyn_sort_##suffix(struct ctls_DynArray_##suffix* dynArr); \
+bool ctls_dyn_stableSort_##suffix(struct ctls_DynArray_##suffix* dynArr); \
+bool ctls_dyn_parallelSort_##suffix(struct ctls_DynArray_##suffix* dynArr, unsigned threadCount); \
+size_t ctls_dyn_lowerBound_##suffix(const struct ctls_DynArray_##suffix* dynArr, type value); \
+size_t ctls_dyn_upperBound_##suffix(const struct ctls_DynArray_##suffix* dynArr, type value); \
+bool ctls_dyn_insertSorted_##suffix(struct ctls_DynArray_##suffix* dynArr, type elem);
+
+/**
+ * @brief Creates definitions for the sorting and binary search functions of a specialization of `ctls_DynArray`.
+ * @param type the name of the type the specialization is for
+ * @param suffix the suffix of the specialization
+ * @param less the ordering of the elements
+ *
+ * The corresponding declarations can, and should, be included via `CTLS_DYN_ARRAY_SORT_DECL`.
+ */
+#define CTLS_DYN_ARRAY_SORT_DEF(type, suffix, less) \
+\
+static void ctls_dyn_sortSwap_##suffix(type* a, type* b) \
+{ \
+    type temp = *a; \
+    *a = *b, *b = temp; \
+} \
+\
+static void ctls_dyn_insertionSort_##suffix(type* first, type* last) \
+{ \
+    if (last - first < 2) \
+        return; \
+    for (type* cur = first + 1; cur < last; ++cur) \
+    { \
+        if (!less(*cur, cur[-1])) \
+            continue; \
+        type elem = *cur; \
+        type* sift = cur; \
+        do \
+            *sift = sift[-1]; \
+        while (--sift != first && less(elem, sift[-1])); \
+        *sift = elem; \
+    } \
+} \
+\
+/* Behaves like insertion sort, but gives up once more than a few elements have been moved. Returns whether the */ \
+/* range was sorted. */ \
+static bool ctls_dyn_partialInsertionSort_##suffix(type* first, type* last) \
+{ \
+    if (last - first < 2) \
+        return true; \
+    size_t moved = 0; \
+    for (type* cur = first + 1; cur < last; ++cur) \
+    { \
+        if (!less(*cur, cur[-1])) \
+            continue; \
+        type elem = *cur; \
+        type* sift = cur; \
+        do \
+            *sift = sift[-1]; \
+        while (--sift != first && less(elem, sift[-1])); \
+        *sift = elem; \
+        if ((moved += (size_t)(cur - sift)) > 8) \
+            return false; \
+    } \
+    return true; \
+} \
+\
+static void ctls_dyn_siftDown_##suffix(type* heap, size_t size, size_t i) \
+{ \
+    type elem = heap[i]; \
+    for (size_t child; (child = 2 * i + 1) < size; i = child) \
+    { \
+        if (child + 1 < size && less(heap[child], heap[child + 1])) \
+            ++child; \
+        if (!less(elem, heap[child])) \
+            break; \
+        heap[i] = heap[child]; \
+    } \
+    heap[i] = elem; \
+} \
+\
+static void ctls_dyn_heapSort_##suffix(type* first, type* last) \
+{ \
+    size_t size = (size_t)(last - first); \
+    for (size_t i = size / 2; i-- > 0;) \
+        ctls_dyn_siftDown_##suffix(first, size, i); \
+    while (size > 1) \
+    { \
+        ctls_dyn_sortSwap_##suffix(first, first + --size); \
+        ctls_dyn_siftDown_##suffix(first, size, 0); \
+    } \
+} \
+\
+static void ctls_dyn_sort3_##suffix(type* a, type* b, type* c) \
+{ \
+    if (less(*b, *a)) \
+        ctls_dyn_sortSwap_##suffix(a, b); \
+    if (less(*c, *b)) \
+        ctls_dyn_sortSwap_##suffix(b, c); \
+    if (less(*b, *a)) \
+        ctls_dyn_sortSwap_##suffix(a, b); \
+} \
+\
+/* Partitions around `*first` into the elements ordered before it and the rest, and returns the pivot's final */ \
+/* position. An element not ordered before the pivot must lie somewhere after `first`, which the choice of pivot */ \
+/* ensures; the inner loops need no bounds checks as a result. */ \
+static type* ctls_dyn_partitionRight_##suffix(type* begin, type* end, bool* alreadyPartitioned) \
+{ \
+    type pivot = *begin; \
+    type *first = begin, *last = end; \
+    while (less(*++first, pivot)) \
+        ; \
+    if (first - 1 == begin) \
+    { \
+        while (first < last && !less(*--last, pivot)) \
+            ; \
+    } \
+    else \
+    { \
+        while (!less(*--last, pivot)) \
+            ; \
+    } \
+    *alreadyPartitioned = first >= last; \
+    while (first < last) \
+    { \
+        ctls_dyn_sortSwap_##suffix(first, last); \
+        while (less(*++first, pivot)) \
+            ; \
+        while (!less(*--last, pivot)) \
+            ; \
+    } \
+    type* pivotPos = first - 1; \
+    *begin = *pivotPos, *pivotPos = pivot; \
+    return pivotPos; \
+} \
+\
+/* Partitions around `*first` into the elements equivalent to it and those ordered after it. Used when the pivot is */ \
+/* equivalent to the element preceding the range, in which case no element of the range is ordered before it. */ \
+static type* ctls_dyn_partitionLeft_##suffix(type* begin, type* end) \
+{ \
+    type pivot = *begin; \
+    type *first = begin, *last = end; \
+    while (less(pivot, *--last)) \
+        ; \
+    if (last + 1 == end) \
+    { \
+        while (first < last && !less(pivot, *++first)) \
+            ; \
+    } \
+    else \
+    { \
+        while (!less(pivot, *++first)) \
+            ; \
+    } \
+    while (first < last) \
+    { \
+        ctls_dyn_sortSwap_##suffix(first, last); \
+        while (less(pivot, *--last)) \
+            ; \
+        while (!less(pivot, *++first)) \
+            ; \
+    } \
+    *begin = *last, *last = pivot; \
+    return last; \
+} \
+\
+static void ctls_dyn_pdqSort_##suffix(type* begin, type* end, unsigned badAllowed, bool leftmost) \
+{ \
+    for (;;) \
+    { \
+        size_t size = (size_t)(end - begin); \
+        if (size < CTLS_DYN_SORT_INSERTION_THRESHOLD) \
+        { \
+            ctls_dyn_insertionSort_##suffix(begin, end); \
+            return; \
+        } \
+        size_t half = size / 2; \
+        if (size >= CTLS_DYN_SORT_NINTHER_THRESHOLD) \
+        { \
+            ctls_dyn_sort3_##suffix(begin, begin + half, end - 1); \
+            ctls_dyn_sort3_##suffix(begin + 1, begin + (half - 1), end - 2); \
+            ctls_dyn_sort3_##suffix(begin + 2, begin + (half + 1), end - 3); \
+            ctls_dyn_sort3_##suffix(begin + (half - 1), begin + half, begin + (half + 1)); \
+            ctls_dyn_sortSwap_##suffix(begin, begin + half); \
+        } \
+        else \
+        { \
+            ctls_dyn_sort3_##suffix(begin + half, begin, end - 1); \
+        } \
+        if (!leftmost && !less(begin[-1], *begin)) \
+        { \
+            begin = ctls_dyn_partitionLeft_##suffix(begin, end) + 1; \
+            continue; \
+        } \
+        bool alreadyPartitioned; \
+        type* pivotPos = ctls_dyn_partitionRight_##suffix(begin, end, &alreadyPartitioned); \
+        size_t leftSize = (size_t)(pivotPos - begin), rightSize = (size_t)(end - (pivotPos + 1)); \
+        if (leftSize < size / 8 || rightSize < size / 8) \
+        { \
+            if (!--badAllowed) \
+            { \
+                ctls_dyn_heapSort_##suffix(begin, end); \
+                return; \
+            } \
+            if (leftSize >= CTLS_DYN_SORT_INSERTION_THRESHOLD) \
+            { \
+                ctls_dyn_sortSwap_##suffix(begin, begin + leftSize / 4); \
+                ctls_dyn_sortSwap_##suffix(pivotPos - 1, pivotPos - leftSize / 4); \
+            } \
+            if (rightSize >= CTLS_DYN_SORT_INSERTION_THRESHOLD) \
+            { \
+                ctls_dyn_sortSwap_##suffix(pivotPos + 1, pivotPos + (1 + rightSize / 4)); \
+                ctls_dyn_sortSwap_##suffix(end - 1, end - rightSize / 4); \
+            } \
+        } \
+        else if (alreadyPartitioned && ctls_dyn_partialInsertionSort_##suffix(begin, pivotPos) \
+            && ctls_dyn_partialInsertionSort_##suffix(pivotPos + 1, end)) \
+        { \
+            return; \
+        } \
+        ctls_dyn_pdqSort_##suffix(begin, pivotPos, badAllowed, leftmost); \
+        begin = pivotPos + 1, leftmost = false; \
+    } \
+} \
+\
+void ctls_dyn_sort_##suffix(struct ctls_DynArray_##suffix* dynArr) \
+{ \
+    if (dynArr->size > 1) \
+    { \
+        ctls_dyn_pdqSort_##suffix(dynArr->data, dynArr->data + dynArr->size, \
+            (unsigned)ctls_dyn_floorLog2(dynArr->size), true); \
+    } \
+} \
+\
+/* Merges the sorted ranges [0, mid) and [mid, size) of `data`, using `buf` to hold the first. */ \
+static void ctls_dyn_merge_##suffix(type* data, size_t mid, size_t size, type* buf) \
+{ \
+    if (!less(data[mid], data[mid - 1])) \
+        return; \
+    memcpy(buf, data, mid * sizeof(type)); \
+    size_t i = 0, j = mid, k = 0; \
+    while (i < mid && j < size) \
+        data[k++] = less(data[j], buf[i]) ? data[j++] : buf[i++]; \
+    memcpy(data + k, buf + i, (mid - i) * sizeof(type)); \
+} \
+\
+static void ctls_dyn_mergeSort_##suffix(type* data, size_t size, type* buf) \
+{ \
+    if (size < CTLS_DYN_SORT_INSERTION_THRESHOLD) \
+    { \
+        ctls_dyn_insertionSort_##suffix(data, data + size); \
+        return; \
+    } \
+    size_t mid = size / 2; \
+    ctls_dyn_mergeSort_##suffix(data, mid, buf); \
+    ctls_dyn_mergeSort_##suffix(data + mid, size - mid, buf); \
+    ctls_dyn_merge_##suffix(data, mid, size, buf); \
+} \
+\
+bool ctls_dyn_stableSort_##suffix(struct ctls_DynArray_##suffix* dynArr) \
+{ \
+    if (dynArr->size < CTLS_DYN_SORT_INSERTION_THRESHOLD) \
+    { \
+        ctls_dyn_insertionSort_##suffix(dynArr->data, dynArr->data + dynArr->size); \
+        return true; \
+    } \
+    size_t bufSize = dynArr->size / 2 * sizeof(type); \
+    type* buf = ctls_allocate(dynArr->allocator, bufSize); \
+    if (!buf) \
+        return false; \
+    ctls_dyn_mergeSort_##suffix(dynArr->data, dynArr->size, buf); \
+    ctls_deallocate(dynArr->allocator, buf, bufSize); \
+    return true; \
+} \
+\
+struct ctls_DynSortTask_##suffix \
+{ \
+    type* data; \
+    size_t size; \
+    type* buf; \
+    unsigned depth; \
+}; \
+\
+/* Each task owns the part of the buffer that lines up with its part of the array, so tasks never share memory. */ \
+static void* ctls_dyn_parallelSortTask_##suffix(void* arg) \
+{ \
+    struct ctls_DynSortTask_##suffix* task = arg; \
+    if (!task->depth || task->size < CTLS_DYN_PARALLEL_SORT_GRAIN) \
+    { \
+        ctls_dyn_mergeSort_##suffix(task->data, task->size, task->buf); \
+        return NULL; \
+    } \
+    size_t mid = task->size / 2; \
+    struct ctls_DynSortTask_##suffix left = {task->data, mid, task->buf, task->depth - 1}; \
+    struct ctls_DynSortTask_##suffix right = {task->data + mid, task->size - mid, task->buf + mid, task->depth - 1}; \
+    pthread_t thread; \
+    bool spawned = !pthread_create(&thread, NULL, ctls_dyn_parallelSortTask_##suffix, &left); \
+    if (!spawned) \
+        ctls_dyn_parallelSortTask_##suffix(&left); \
+    ctls_dyn_parallelSortTask_##suffix(&right); \
+    if (spawned) \
+        pthread_join(thread, NULL); \
+    ctls_dyn_merge_##suffix(task->data, mid, task->size, task->buf); \
+    return NULL; \
+} \
+\
+bool ctls_dyn_parallelSort_##suffix(struct ctls_DynArray_##suffix* dynArr, unsigned threadCount) \
+{ \
+    if (threadCount < 2 || dynArr->size < CTLS_DYN_PARALLEL_SORT_GRAIN) \
+        return ctls_dyn_stableSort_##suffix(dynArr); \
+    size_t bufSize = dynArr->size * sizeof(type); \
+    type* buf = ctls_allocate(dynArr->allocator, bufSize); \
+    if (!buf) \
+        return false; \
+    struct ctls_DynSortTask_##suffix task = {dynArr->data, dynArr->size, buf, \
+        (unsigned)ctls_dyn_floorLog2(threadCount)}; \
+    ctls_dyn_parallelSortTask_##suffix(&task); \
+    ctls_deallocate(dynArr->allocator, buf, bufSize); \
+    return true; \
+} \
+\
+/* The binary searches halve the range without branching on the comparison, which the compiler turns into a */ \
+/* conditional move. */ \
+size_t ctls_dyn_lowerBound_##suffix(const struct ctls_DynArray_##suffix* dynArr, type value) \
+{ \
+    if (!dynArr->size) \
+        return 0; \
+    const type* base = dynArr->data; \
+    for (size_t size = dynArr->size, half; size > 1; size -= half) \
+    { \
+        half = size / 2; \
+        base = less(base[half], value) ? base + half : base; \
+    } \
+    return (size_t)(base - dynArr->data) + (less(*base, value) ? 1 : 0); \
+} \
+\
+size_t ctls_dyn_upperBound_##suffix(const struct ctls_DynArray_##suffix* dynArr, type value) \
+{ \
+    if (!dynArr->size) \
+        return 0; \
+    const type* base = dynArr->data; \
+    for (size_t size = dynArr->size, half; size > 1; size -= half) \
+    { \
+        half = size / 2; \
+        base = less(value, base[half]) ? base : base + half; \
+    } \
+    return (size_t)(base - dynArr->data) + (less(value, *base) ? 0 : 1); \
+} \
+\
+bool ctls_dyn_insertSorted_##suffix(struct ctls_DynArray_##suffix* dynArr, type elem) \
+{ \
+    return ctls_dyn_insert_##suffix(dynArr, &elem, ctls_dyn_upperBound_##suffix(dynArr, elem), 1); \
+}
+
+/**
+ * @brief a convenience function that calls both `CTLS_DYN_ARRAY_SORT_DECL` and `CTLS_DYN_ARRAY_SORT_DEF`.
+ * @param type the name of the type the specialization is for
+ * @param suffix the suffix of the specialization
+ * @param less the ordering of the elements
+ *
+ * **Usage**
+ * @code
+ * #define LESS(a, b) ((a) < (b))
+ *
+ * CTLS_DYN_ARRAY(int, int)
+ * CTLS_DYN_ARRAY_SORT(int, int, LESS)
+ * @endcode
+ */
+#define CTLS_DYN_ARRAY_SORT(type, suffix, less) \
+CTLS_DYN_ARRAY_SORT_DECL(type, suffix) \
+CTLS_DYN_ARRAY_SORT_DEF(type, suffix, less)
+
+/**
+ * @brief Creates a declaration for the radix sort of a specialization of `ctls_DynArray`.
+ * @param type the name of the type the specialization is for
+ * @param suffix the suffix of the specialization
+ *
+ * `bool ctls_dyn_radixSort_##suffix(dynArr)` sorts the elements in ascending order of their keys, preserving the order
+ * of elements with equal keys. It allocates a buffer of `dynArr->size` elements through `dynArr->allocator`, and
+ * returns `false`, leaving `dynArr` unchanged, if that fails.
+ */
+#define CTLS_DYN_ARRAY_RADIX_SORT_DECL(type, suffix) \
+bool ctls_dyn_radixSort_##suffix(struct ctls_DynArray_##suffix* dynArr);
+
+/**
+ * @brief Creates a definition for the radix sort of a specialization of `ctls_DynArray`.
+ * @param type the name of the type the specialization is for
+ * @param suffix the suffix of the specialization
+ * @param keyType an unsigned integer type
+ * @param key the name of a function or function-like macro that returns the key of an element, as a `keyType`.
+ *     Signed keys can be converted with `CTLS_DYN_SIGNED_KEY`.
+ *
+ * The elements are distributed by one byte of their keys at a time, starting from the least significant. A byte that
+ * is the same in every key is skipped, so small keys in a wide `keyType` cost few passes.
+ */
+#define CTLS_DYN_ARRAY_RADIX_SORT_DEF(type, suffix, keyType, key) \
+\
+bool ctls_dyn_radixSort_##suffix(struct ctls_DynArray_##suffix* dynArr) \
+{ \
+    size_t size = dynArr->size; \
+    if (size < 2) \
+        return true; \
+    type* buf = ctls_allocate(dynArr->allocator, size * sizeof(type)); \
+    if (!buf) \
+        return false; \
+    size_t counts[sizeof(keyType)][256] = {{0}}; \
+    for (size_t i = 0; i < size; ++i) \
+    { \
+        keyType k = key(dynArr->data[i]); \
+        for (size_t digit = 0; digit < sizeof(keyType); ++digit) \
+            ++counts[digit][(size_t)(k >> (8 * digit)) & 0xFF]; \
+    } \
+    type *src = dynArr->data, *dest = buf; \
+    for (size_t digit = 0; digit < sizeof(keyType); ++digit) \
+    { \
+        size_t* digitCounts = counts[digit]; \
+        if (digitCounts[(size_t)((keyType)key(src[0]) >> (8 * digit)) & 0xFF] == size) \
+            continue; \
+        for (size_t b = 0, offset = 0; b < 256; ++b) \
+        { \
+            size_t count = digitCounts[b]; \
+            digitCounts[b] = offset, offset += count; \
+        } \
+        for (size_t i = 0; i < size; ++i) \
+            dest[digitCounts[(size_t)((keyType)key(src[i]) >> (8 * digit)) & 0xFF]++] = src[i]; \
+        type* temp = src; \
+        src = dest, dest = temp; \
+    } \
+    if (src != dynArr->data) \
+        memcpy(dynArr->data, src, size * sizeof(type)); \
+    ctls_deallocate(dynArr->allocator, buf, size * sizeof(type)); \
+    return true; \
+}
+
+/**
+ * @brief a convenience function that calls both `CTLS_DYN_ARRAY_RADIX_SORT_DECL` and `CTLS_DYN_ARRAY_RADIX_SORT_DEF`.
+ * @param type the name of the type the specialization is for
+ * @param suffix the suffix of the specialization
+ * @param keyType an unsigned integer type
+ * @param key the name of a function or function-like macro that returns the key of an element, as a `keyType`
+ *
+ * **Usage**
+ * @code
+ * #define KEY(x) CTLS_DYN_SIGNED_KEY(uint64_t, x)
+ *
+ * CTLS_DYN_ARRAY(int64_t, i64)
+ * CTLS_DYN_ARRAY_RADIX_SORT(int64_t, i64, uint64_t, KEY)
+ * @endcode
+ */
+#define CTLS_DYN_ARRAY_RADIX_SORT(type, suffix, keyType, key) \
+CTLS_DYN_ARRAY_RADIX_SORT_DECL(type, suffix) \
+CTLS_DYN_ARRAY_RADIX_SORT_DEF(type, suffix, keyType, key)
+
+#endif
@@ -0,0 +1,99 @@
+#ifndef CUTILS_DATA_STRUCTURES_DYN_GROWTH_H_10162026
+#define CUTILS_DATA_STRUCTURES_DYN_GROWTH_H_10162026
+
+/** @file
+ * @brief Contains the growth policies shared by the dynamic array implementations.
+ *
+ * A growth policy decides the capacity a container grows to once it runs out of room. All policies use integer
+ * arithmetic only, so growing a container never raises a floating-point exception. Every policy grows geometrically,
+ * and jumps straight to the required capacity if a single geometric step would not suffice.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+/** @brief Selects how a container's capacity grows. */
+enum ctls_DynGrowthPolicy
+{
+    /**
+     * @brief grow by a factor of approximately the golden ratio
+     *
+     * By one measure, the golden ratio is the optimal growth factor. It allows reuse of a memory block after only two
+     * reallocations, the theoretical minimum. Of course, whether memory blocks are reused in this way depends on the
+     * amount of contiguous memory available, and how memory allocation is implemented.
+     */
+    CTLS_DYN_GROWTH_GOLDEN,
+    /** @brief double the capacity, minimizing the number of reallocations */
+    CTLS_DYN_GROWTH_DOUBLE,
+    /**
+     * @brief grow by a factor of approximately 1.5, then round the block size up to an allocator size class
+     *
+     * Size classes have four steps per power of two, starting at 16 bytes, which mirrors the bins used by common
+     * `malloc` implementations. The capacity is then chosen so that the whole block is usable, instead of leaving the
+     * allocator's rounding slack unused.
+     */
+    CTLS_DYN_GROWTH_SIZE_CLASS
+};
+
+static inline size_t ctls_dyn_floorLog2(size_t n)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return sizeof(unsigned long long) * 8 - 1 - __builtin_clzll(n);
+#else
+    size_t log = 0;
+    while (n >>= 1)
+        ++log;
+    return log;
+#endif
+}
+
+// Rounds `bytes` up to the nearest size class, saturating at `limit`.
+static inline size_t ctls_dyn_sizeClass(size_t bytes, size_t limit)
+{
+    if (bytes <= 16)
+        return 16;
+    size_t step = (size_t)1 << (ctls_dyn_floorLog2(bytes - 1) - 2);
+    if (bytes > limit - (step - 1))
+        return limit;
+    return (bytes + step - 1) & ~(step - 1);
+}
+
+/**
+ * @brief Computes the capacity a container should grow to.
+ * @param policy the growth policy
+ * @param capacity the container's current capacity
+ * @param required the minimum capacity after growth; must be greater than `capacity`
+ * @param elemSize size of one of the container's elements; must be nonzero
+ * @return the new capacity, which is at least `required`, or zero if a block of `required` elements cannot be
+ *     represented in a `size_t`
+ */
+static inline size_t ctls_dyn_grownCapacity(enum ctls_DynGrowthPolicy policy, size_t capacity, size_t required,
+    size_t elemSize)
+{
+    size_t limit = SIZE_MAX / elemSize, grown;
+    if (required > limit)
+        return 0;
+    switch (policy)
+    {
+    case CTLS_DYN_GROWTH_DOUBLE:
+        grown = capacity > limit / 2 ? limit : 2 * capacity;
+        break;
+    case CTLS_DYN_GROWTH_SIZE_CLASS:
+    {
+        size_t bytes = capacity * elemSize, extra = bytes / 2;
+        bytes = extra > limit * elemSize - bytes ? limit * elemSize : bytes + extra;
+        grown = ctls_dyn_sizeClass(bytes, limit * elemSize) / elemSize;
+        break;
+    }
+    default:
+    {
+        // 1/2 + 1/8 - 1/128 = 0.6171875, which is within 0.001 of the golden ratio's fractional part.
+        size_t extra = (capacity >> 1) + (capacity >> 3) - (capacity >> 7);
+        grown = extra > limit - capacity ? limit : capacity + extra;
+        break;
+    }
+    }
+    return grown < required ? required : grown;
+}
+
+#endif
@@ -0,0 +1,178 @@
+#ifndef CUTILS_DATA_STRUCTURES_DYN_STATS_H_10162026
+#define CUTILS_DATA_STRUCTURES_DYN_STATS_H_10162026
+
+/** @file
+ * @brief Contains optional instrumentation for `ctls_DynArray` and its specializations.
+ *
+ * When `CTLS_DYN_STATS` is defined, both when the library is built and when cutils/data_structures/dyn_array_g.h is
+ * included, dynamic arrays record what they do in a `ctls_DynStats` object, called a site: how often they are
+ * initialized and reallocated, how many bytes reallocations and shifts of their elements touch, how large their blocks
+ * grow, and how much room is left unused when they are reset. Configuring with `-DCUTILS_DYN_STATS=ON` defines it for
+ * the library and for everything linked against it. When it is not defined, the hooks expand to nothing, and dynamic
+ * arrays are exactly as fast as without this file.
+ *
+ * Arrays created through the functions declared in cutils/data_structures/dyn_array.h share a site named
+ * `"ctls_DynArray"`, and each specialization has a site named after its suffix. A thread can instead attribute its
+ * operations to a site of its own choosing, such as one per call site, with `CTLS_DYN_WITH_SITE`:
+ *
+ * @code
+ * CTLS_DYN_STATS_SITE(parseSite, "parser tokens")
+ *
+ * void parse(struct ctls_DynArray_token* tokens, const char* source)
+ * {
+ *     CTLS_DYN_WITH_SITE(parseSite, tokenize(tokens, source));
+ * }
+ * @endcode
+ *
+ * `ctls_dyn_statsReport()` prints every site that has recorded anything, along with a histogram of the sizes arrays had
+ * when they were reset, from which suitable initial capacities can be read off.
+ *
+ * **Probes**
+ *
+ * Independently of `CTLS_DYN_STATS`, every instrumented operation passes through `CTLS_DYN_PROBE(event, dynArr, a, b)`.
+ * Defining `CTLS_DYN_USDT`, or configuring with `-DCUTILS_DYN_USDT=ON`, turns it into a USDT probe from <sys/sdt.h>,
+ * named `cutils:dyn_<event>`, which tools such as `bpftrace` and `perf` can attach to. A program may instead define
+ * `CTLS_DYN_PROBE` itself before including any header of this library to forward the events elsewhere. The events, and
+ * their arguments besides the address of the dynamic array, are:
+ *
+ * - `init`: the initial capacity and the element size
+ * - `realloc`: the old and the new capacity
+ * - `move`: the number of bytes shifted by an insertion or removal, and zero
+ * - `reset`: the size and the capacity at the time of the reset
+ */
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdatomic.h>
+
+/** @brief The number of buckets in `ctls_DynStats::finalSizes`. */
+#define CTLS_DYN_STATS_BUCKETS 32
+
+/** @brief The statistics recorded for a site. Every counter is updated atomically. */
+struct ctls_DynStats
+{
+    /** @brief the name printed by `ctls_dyn_statsReport()` */
+    const char* name;
+    /** @brief number of dynamic arrays initialized */
+    atomic_size_t inits;
+    /** @brief number of times a block was resized, including by shrinking */
+    atomic_size_t reallocations;
+    /** @brief total size of the blocks that were resized, which is how many bytes a reallocation may have to copy */
+    atomic_size_t bytesReallocated;
+    /** @brief total number of bytes shifted to make room for insertions or to close the gaps left by removals */
+    atomic_size_t bytesMoved;
+    /** @brief size in bytes of the largest block any dynamic array has had */
+    atomic_size_t peakCapacityBytes;
+    /** @brief number of dynamic arrays reset */
+    atomic_size_t resets;
+    /** @brief total number of bytes allocated but unused at the time of a reset */
+    atomic_size_t slackBytes;
+    /**
+     * @brief a histogram of sizes at the time of a reset. Bucket 0 counts empty arrays, and bucket *i* > 0 counts those
+     *     with between 2^(*i* - 1) and 2^*i* - 1 elements. The last bucket also counts all larger arrays.
+     */
+    atomic_size_t finalSizes[CTLS_DYN_STATS_BUCKETS];
+    /** @brief the next site that has recorded anything */
+    struct ctls_DynStats* next;
+    /** @brief whether this site has been added to the list that `ctls_dyn_statsSites()` returns */
+    atomic_bool registered;
+};
+
+#ifdef CTLS_DYN_USDT
+#include <sys/sdt.h>
+#define CTLS_DYN_PROBE(event, dynArr, a, b) DTRACE_PROBE3(cutils, dyn_##event, (dynArr), (a), (b))
+#elif !defined(CTLS_DYN_PROBE)
+/** @brief A hook called on every instrumented operation, which does nothing unless overridden. */
+#define CTLS_DYN_PROBE(event, dynArr, a, b) ((void)0)
+#endif
+
+#ifdef CTLS_DYN_STATS
+/** @brief Defines a site with static storage duration, or nothing if `CTLS_DYN_STATS` is not defined. */
+#define CTLS_DYN_STATS_SITE(site, label) static struct ctls_DynStats site = {.name = (label)};
+/**
+ * @brief Attributes everything the current thread does to dynamic arrays while executing a statement to a given site.
+ *
+ * The statement must not leave the enclosing block via `return`, `break`, or `goto`.
+ */
+#define CTLS_DYN_WITH_SITE(site, ...) \
+    do \
+    { \
+        struct ctls_DynStats* ctls_dyn_previousSite = ctls_dyn_setStatsSite(&(site)); \
+        __VA_ARGS__; \
+        ctls_dyn_setStatsSite(ctls_dyn_previousSite); \
+    } while (0)
+#define CTLS_DYN_RECORD(event, ...) ctls_dyn_statsOn##event(__VA_ARGS__)
+#else
+#define CTLS_DYN_STATS_SITE(site, label)
+#define CTLS_DYN_WITH_SITE(site, ...) \
+    do \
+    { \
+        __VA_ARGS__; \
+    } while (0)
+#define CTLS_DYN_RECORD(event, ...) ((void)0)
+#endif
+
+/*
+ * The hooks that dynamic arrays call. `site` is the site to which the operation is attributed unless the current thread
+ * has chosen another.
+ */
+#define CTLS_DYN_ON_INIT(site, dynArr, elemSize) \
+    do \
+    { \
+        CTLS_DYN_RECORD(Init, &(site), (dynArr)->capacity, (elemSize)); \
+        CTLS_DYN_PROBE(init, (dynArr), (dynArr)->capacity, (elemSize)); \
+    } while (0)
+#define CTLS_DYN_ON_REALLOC(site, dynArr, oldCapacity, newCapacity, elemSize) \
+    do \
+    { \
+        CTLS_DYN_RECORD(Realloc, &(site), (oldCapacity), (newCapacity), (elemSize)); \
+        CTLS_DYN_PROBE(realloc, (dynArr), (oldCapacity), (newCapacity)); \
+    } while (0)
+#define CTLS_DYN_ON_MOVE(site, dynArr, bytes) \
+    do \
+    { \
+        CTLS_DYN_RECORD(Move, &(site), (bytes)); \
+        CTLS_DYN_PROBE(move, (dynArr), (bytes), 0); \
+    } while (0)
+#define CTLS_DYN_ON_RESET(site, dynArr, elemSize) \
+    do \
+    { \
+        CTLS_DYN_RECORD(Reset, &(site), (dynArr)->size, (dynArr)->capacity, (elemSize)); \
+        CTLS_DYN_PROBE(reset, (dynArr), (dynArr)->size, (dynArr)->capacity); \
+    } while (0)
+
+/**
+ * @brief Chooses the site to which the current thread's operations on dynamic arrays are attributed.
+ * @param site the chosen site, or `NULL` to attribute each operation to the default site of the dynamic array
+ * @return the previously chosen site
+ */
+struct ctls_DynStats* ctls_dyn_setStatsSite(struct ctls_DynStats* site);
+
+/**
+ * @brief Returns the most recently registered site that has recorded anything.
+ *
+ * The other sites can be reached by following `ctls_DynStats::next`.
+ */
+struct ctls_DynStats* ctls_dyn_statsSites(void);
+
+/**
+ * @brief Prints a summary of every site that has recorded anything.
+ * @param stream the stream printed to
+ *
+ * The summary includes the average slack per reset and, as a suggestion for the initial capacity, the smallest power of
+ * two that would have held at least 90% of the arrays when they were reset. Arrays that are never reset do not
+ * contribute to either.
+ */
+void ctls_dyn_statsReport(FILE* stream);
+
+/*
+ * Recording functions, called through the hooks above. They exist whether or not `CTLS_DYN_STATS` is defined, so that
+ * the library and the programs linked against it can be built with different settings.
+ */
+void ctls_dyn_statsOnInit(struct ctls_DynStats* site, size_t capacity, size_t elemSize);
+void ctls_dyn_statsOnRealloc(struct ctls_DynStats* site, size_t oldCapacity, size_t newCapacity, size_t elemSize);
+void ctls_dyn_statsOnMove(struct ctls_DynStats* site, size_t bytes);
+void ctls_dyn_statsOnReset(struct ctls_DynStats* site, size_t size, size_t capacity, size_t elemSize);
+
+#endif
@@ -0,0 +1,445 @@
+#ifndef CUTILS_DATA_STRUCTURES_HASH_MAP_G_H_10162026
+#define CUTILS_DATA_STRUCTURES_HASH_MAP_G_H_10162026
+
+/** @file
+ * @brief Contains a generic hash map that uses open addressing.
+ *
+ * The macros in this file create specializations of a hash map in the same manner as those in
+ * cutils/data_structures/dyn_array_g.h create specializations of `ctls_DynArray`. Each takes a `keyType`, a
+ * `valueType`, and a `suffix`; the defining macros additionally take `hash` and `eq`:
+ * - `hash(key)` must return a `size_t` hash of `key`. It need not be well distributed, as every hash is mixed before
+ *     use, but equal keys must have equal hashes. `ctls_hmap_hashInt()` and `ctls_hmap_hashBytes()` may be used.
+ * - `eq(a, b)` must return nonzero if the keys `a` and `b` are equal.
+ * Both may be functions or function-like macros.
+ *
+ * @code
+ * #define HASH_ID(id) ctls_hmap_hashInt(id)
+ * #define EQ_ID(a, b) ((a) == (b))
+ * CTLS_HASH_MAP(uint64_t, struct User, user, HASH_ID, EQ_ID)
+ *
+ * void f(void)
+ * {
+ *     struct ctls_HashMap_user users;
+ *     ctls_hmap_init_user(&users);
+ *     ctls_hmap_insert_user(&users, 42, (struct User){"Alice"});
+ *     struct User* alice = ctls_hmap_find_user(&users, 42);
+ *     // ...
+ *     ctls_hmap_reset_user(&users);
+ * }
+ * @endcode
+ *
+ * **Layout**
+ *
+ * A hash map stores its entries inline in a single flat array of `capacity` slots, preceded by one control byte per
+ * slot, all in one block obtained from `allocator`. A control byte is either `CTLS_HMAP_EMPTY`, `CTLS_HMAP_DELETED`,
+ * or, for a slot that holds an entry, the low 7 bits of the entry's hash. Lookups probe a group of 16 control bytes at
+ * a time; with SSE2, a group is compared against the 7 hash bits in two instructions, so keys are only compared for
+ * slots whose control byte already matches. Groups may start at any slot, so the first 16 control bytes are duplicated
+ * after the last one.
+ *
+ * The capacity is zero or a power of two of at least 16, and the map is rehashed once seven eighths of its slots are
+ * used. Removing an entry usually leaves a tombstone, `CTLS_HMAP_DELETED`, behind, which is reclaimed by the next
+ * rehash. As with `ctls_DynArray`, a rehash invalidates pointers to entries.
+ */
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CTLS_HMAP_SSE2 1
+#else
+#define CTLS_HMAP_SSE2 0
+#endif
+
+#include "cutils/data_structures/dyn_growth.h"
+#include "cutils/memory/allocator.h"
+
+/** @brief The number of control bytes probed at once. */
+#define CTLS_HMAP_GROUP_WIDTH 16
+/** @brief The control byte of a slot that has never held an entry since the last rehash. */
+#define CTLS_HMAP_EMPTY ((signed char)-128)
+/** @brief The control byte of a slot whose entry has been removed. */
+#define CTLS_HMAP_DELETED ((signed char)-2)
+
+/** @brief Returns a hash of an integer; suitable as the `hash` argument for integer keys. */
+static inline size_t ctls_hmap_hashInt(uint64_t key)
+{
+    return (size_t)(key ^ key >> 32);
+}
+
+/** @brief Returns the FNV-1a hash of `size` bytes. */
+static inline size_t ctls_hmap_hashBytes(const void* data, size_t size)
+{
+    const unsigned char* bytes = data;
+    uint64_t h = 14695981039346656037u;
+    for (size_t i = 0; i < size; ++i)
+        h = (h ^ bytes[i]) * 1099511628211u;
+    return (size_t)h;
+}
+
+// Spreads the entropy of a user-supplied hash over every bit, so that the slot index and the 7 bits stored in the
+// control byte are independent even for the identity hash.
+static inline size_t ctls_hmap_mix(size_t h)
+{
+    uint64_t x = (uint64_t)h * 0x9E3779B97F4A7C15u;
+    return (size_t)(x ^ x >> 32);
+}
+
+static inline unsigned ctls_hmap_ctz(unsigned mask)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned)__builtin_ctz(mask);
+#else
+    unsigned count = 0;
+    while (!(mask & 1))
+        mask >>= 1, ++count;
+    return count;
+#endif
+}
+
+// Returns the number of leading zeros of a 16-bit group mask.
+static inline unsigned ctls_hmap_clz16(unsigned mask)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned)__builtin_clz(mask << 16);
+#else
+    unsigned count = 0;
+    while (!(mask & 0x8000))
+        mask <<= 1, ++count;
+    return count;
+#endif
+}
+
+// The group functions return a bit mask with bit i set if control byte i of the group starting at `ctrl` matches.
+
+static inline unsigned ctls_hmap_matchByte(const signed char* ctrl, signed char byte)
+{
+#if CTLS_HMAP_SSE2
+    __m128i group = _mm_loadu_si128((const __m128i*)ctrl);
+    return (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(byte)));
+#else
+    unsigned mask = 0;
+    for (unsigned i = 0; i < CTLS_HMAP_GROUP_WIDTH; ++i)
+        mask |= (unsigned)(ctrl[i] == byte) << i;
+    return mask;
+#endif
+}
+
+static inline unsigned ctls_hmap_matchEmpty(const signed char* ctrl)
+{
+    return ctls_hmap_matchByte(ctrl, CTLS_HMAP_EMPTY);
+}
+
+// Empty and deleted slots are exactly those whose control byte is negative.
+static inline unsigned ctls_hmap_matchFree(const signed char* ctrl)
+{
+#if CTLS_HMAP_SSE2
+    return (unsigned)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)ctrl));
+#else
+    unsigned mask = 0;
+    for (unsigned i = 0; i < CTLS_HMAP_GROUP_WIDTH; ++i)
+        mask |= (unsigned)(ctrl[i] < 0) << i;
+    return mask;
+#endif
+}
+
+/**
+ * @brief Creates declarations for a hash map specialization.
+ * @param keyType the type of the keys
+ * @param valueType the type of the values
+ * @param suffix a string appended to each declared identifier
+ *
+ * The following are declared:
+ * - `struct ctls_HashMapEntry_##suffix`, with members `key` and `value`.
+ * - `struct ctls_HashMap_##suffix`, with members `ctrl`, `entries`, `size`, `capacity`, `growthLeft`, and
+ *     `allocator`. Only `size` and `allocator` are meant to be read directly.
+ * - `ctls_hmap_init_##suffix(map)` and `ctls_hmap_initWithAllocator_##suffix(map, allocator)` initialize an empty
+ *     map, which allocates nothing until the first insertion. They return `NULL` if `map` is `NULL` and cannot be
+ *     allocated, and `map` or the allocated map otherwise.
+ * - `ctls_hmap_reset_##suffix(map)` frees the map's memory and zeroes its members out.
+ * - `ctls_hmap_clear_##suffix(map)` removes every entry, but keeps the memory.
+ * - `ctls_hmap_reserve_##suffix(map, n)` makes room for `n` entries without further rehashing, and returns `true` on
+ *     success.
+ * - `ctls_hmap_find_##suffix(map, key)` returns a pointer to the value associated with `key`, or `NULL`.
+ * - `ctls_hmap_contains_##suffix(map, key)` returns whether `key` is in the map.
+ * - `ctls_hmap_insert_##suffix(map, key, value)` associates `value` with `key`, replacing any previous value, and
+ *     returns `true` on success.
+ * - `ctls_hmap_emplace_##suffix(map, key, inserted)` returns a pointer to the value associated with `key`, after
+ *     inserting `key` with an uninitialized value if it was absent, or `NULL` if memory could not be allocated.
+ *     `*inserted` is set to whether `key` was inserted, unless `inserted` is `NULL`.
+ * - `ctls_hmap_erase_##suffix(map, key)` removes `key` and its value, and returns whether `key` was in the map.
+ * - `ctls_hmap_next_##suffix(map, index)` returns the entry at the smallest slot index not less than `*index`, or
+ *     `NULL` if there is none, and sets `*index` past it. Iterating from `*index == 0` visits every entry once, in an
+ *     unspecified order. Entries may be erased during iteration, but not inserted.
+ */
+#define CTLS_HASH_MAP_DECL(keyType, valueType, suffix) \
+\
+struct ctls_HashMapEntry_##suffix \
+{ \
+    keyType key; \
+    valueType value; \
+}; \
+\
+struct ctls_HashMap_##suffix \
+{ \
+    signed char* ctrl; \
+    struct ctls_HashMapEntry_##suffix* entries; \
+    size_t size; \
+    size_t capacity; \
+    size_t growthLeft; \
+    const struct ctls_Allocator* allocator; \
+}; \
+\
+struct ctls_HashMap_##suffix* ctls_hmap_init_##suffix(struct ctls_HashMap_##suffix* map); \
+struct ctls_HashMap_##suffix* ctls_hmap_initWithAllocator_##suffix(struct ctls_HashMap_##suffix* map, \
+    const struct ctls_Allocator* allocator); \
+void ctls_hmap_reset_##suffix(struct ctls_HashMap_##suffix* map); \
+void ctls_hmap_clear_##suffix(struct ctls_HashMap_##suffix* map); \
+bool ctls_hmap_reserve_##suffix(struct ctls_HashMap_##suffix* map, size_t n); \
+valueType* ctls_hmap_find_##suffix(const struct ctls_HashMap_##suffix* map, keyType key); \
+bool ctls_hmap_contains_##suffix(const struct ctls_HashMap_##suffix* map, keyType key); \
+bool ctls_hmap_insert_##suffix(struct ctls_HashMap_##suffix* map, keyType key, valueType value); \
+valueType* ctls_hmap_emplace_##suffix(struct ctls_HashMap_##suffix* map, keyType key, bool* inserted); \
+bool ctls_hmap_erase_##suffix(struct ctls_HashMap_##suffix* map, keyType key); \
+struct ctls_HashMapEntry_##suffix* ctls_hmap_next_##suffix(const struct ctls_HashMap_##suffix* map, size_t* index);
+
+/**
+ * @brief Creates definitions for a hash map specialization.
+ * @param keyType the type of the keys
+ * @param valueType the type of the values
+ * @param suffix a string appended to each declared identifier
+ * @param hash a function or function-like macro that returns a `size_t` hash of a key
+ * @param eq a function or function-like macro that returns nonzero if two keys are equal
+ *
+ * The corresponding declarations can, and should, be included via `CTLS_HASH_MAP_DECL`.
+ */
+#define CTLS_HASH_MAP_DEF(keyType, valueType, suffix, hash, eq) \
+\
+static void ctls_hmap_setCtrl_##suffix(struct ctls_HashMap_##suffix* map, size_t i, signed char c) \
+{ \
+    map->ctrl[i] = c; \
+    if (i < CTLS_HMAP_GROUP_WIDTH) \
+        map->ctrl[map->capacity + i] = c; \
+} \
+\
+/* Returns the index of the first empty or deleted slot in the probe sequence of `h`. There always is one, since */ \
+/* the map is never full. */ \
+static size_t ctls_hmap_findFree_##suffix(const struct ctls_HashMap_##suffix* map, size_t h) \
+{ \
+    size_t mask = map->capacity - 1, pos = (h >> 7) & mask; \
+    for (size_t step = CTLS_HMAP_GROUP_WIDTH;; pos = (pos + step) & mask, step += CTLS_HMAP_GROUP_WIDTH) \
+    { \
+        unsigned match = ctls_hmap_matchFree(map->ctrl + pos); \
+        if (match) \
+            return (pos + ctls_hmap_ctz(match)) & mask; \
+    } \
+} \
+\
+/* Returns the index of the slot that holds `key`, or `SIZE_MAX` if there is none. */ \
+static size_t ctls_hmap_findIndex_##suffix(const struct ctls_HashMap_##suffix* map, keyType key, size_t h) \
+{ \
+    if (!map->capacity) \
+        return SIZE_MAX; \
+    signed char h2 = (signed char)(h & 0x7F); \
+    size_t mask = map->capacity - 1, pos = (h >> 7) & mask; \
+    for (size_t step = CTLS_HMAP_GROUP_WIDTH;; pos = (pos + step) & mask, step += CTLS_HMAP_GROUP_WIDTH) \
+    { \
+        const signed char* group = map->ctrl + pos; \
+        for (unsigned match = ctls_hmap_matchByte(group, h2); match; match &= match - 1) \
+        { \
+            size_t i = (pos + ctls_hmap_ctz(match)) & mask; \
+            if (eq(map->entries[i].key, key)) \
+                return i; \
+        } \
+        if (ctls_hmap_matchEmpty(group)) \
+            return SIZE_MAX; \
+    } \
+} \
+\
+static size_t ctls_hmap_blockSize_##suffix(const struct ctls_HashMap_##suffix* map) \
+{ \
+    return (size_t)((char*)(map->entries + map->capacity) - (char*)map->ctrl); \
+} \
+\
+static bool ctls_hmap_rehash_##suffix(struct ctls_HashMap_##suffix* map, size_t newCapacity) \
+{ \
+    size_t ctrlSize = newCapacity + CTLS_HMAP_GROUP_WIDTH, align = _Alignof(struct ctls_HashMapEntry_##suffix); \
+    size_t entriesOffset = (ctrlSize + align - 1) / align * align; \
+    if (newCapacity > (SIZE_MAX - entriesOffset) / sizeof(struct ctls_HashMapEntry_##suffix)) \
+        return false; \
+    signed char* newCtrl = ctls_allocate(map->allocator, \
+        entriesOffset + newCapacity * sizeof(struct ctls_HashMapEntry_##suffix)); \
+    if (!newCtrl) \
+        return false; \
+    memset(newCtrl, CTLS_HMAP_EMPTY, ctrlSize); \
+    struct ctls_HashMap_##suffix old = *map; \
+    map->ctrl = newCtrl, map->capacity = newCapacity; \
+    map->entries = (struct ctls_HashMapEntry_##suffix*)(void*)(newCtrl + entriesOffset); \
+    map->growthLeft = newCapacity - newCapacity / 8 - map->size; \
+    for (size_t i = 0; i < old.capacity; ++i) \
+    { \
+        if (old.ctrl[i] < 0) \
+            continue; \
+        size_t h = ctls_hmap_mix(hash(old.entries[i].key)), j = ctls_hmap_findFree_##suffix(map, h); \
+        ctls_hmap_setCtrl_##suffix(map, j, old.ctrl[i]); \
+        map->entries[j] = old.entries[i]; \
+    } \
+    if (old.capacity) \
+        ctls_deallocate(map->allocator, old.ctrl, ctls_hmap_blockSize_##suffix(&old)); \
+    return true; \
+} \
+\
+/* Returns the smallest capacity that holds `n` entries without exceeding the maximum load factor, or zero. */ \
+static size_t ctls_hmap_capacityFor_##suffix(size_t n) \
+{ \
+    if (n > SIZE_MAX / 8) \
+        return 0; \
+    size_t required = n + (n + 6) / 7, capacity = CTLS_HMAP_GROUP_WIDTH; \
+    if (required > capacity) \
+    { \
+        capacity = (size_t)1 << ctls_dyn_floorLog2(required); \
+        if (capacity < required && !(capacity <<= 1)) \
+            return 0; \
+    } \
+    return capacity; \
+} \
+\
+struct ctls_HashMap_##suffix* ctls_hmap_initWithAllocator_##suffix(struct ctls_HashMap_##suffix* map, \
+    const struct ctls_Allocator* allocator) \
+{ \
+    if (!map && !(map = malloc(sizeof *map))) \
+        return NULL; \
+    *map = (struct ctls_HashMap_##suffix){.allocator = allocator}; \
+    return map; \
+} \
+\
+struct ctls_HashMap_##suffix* ctls_hmap_init_##suffix(struct ctls_HashMap_##suffix* map) \
+{ \
+    return ctls_hmap_initWithAllocator_##suffix(map, NULL); \
+} \
+\
+void ctls_hmap_reset_##suffix(struct ctls_HashMap_##suffix* map) \
+{ \
+    if (map->capacity) \
+        ctls_deallocate(map->allocator, map->ctrl, ctls_hmap_blockSize_##suffix(map)); \
+    memset(map, 0, sizeof *map); \
+} \
+\
+void ctls_hmap_clear_##suffix(struct ctls_HashMap_##suffix* map) \
+{ \
+    if (!map->capacity) \
+        return; \
+    memset(map->ctrl, CTLS_HMAP_EMPTY, map->capacity + CTLS_HMAP_GROUP_WIDTH); \
+    map->size = 0, map->growthLeft = map->capacity - map->capacity / 8; \
+} \
+\
+bool ctls_hmap_reserve_##suffix(struct ctls_HashMap_##suffix* map, size_t n) \
+{ \
+    if (n <= map->size + map->growthLeft) \
+        return true; \
+    size_t newCapacity = ctls_hmap_capacityFor_##suffix(n); \
+    return newCapacity && ctls_hmap_rehash_##suffix(map, newCapacity); \
+} \
+\
+valueType* ctls_hmap_find_##suffix(const struct ctls_HashMap_##suffix* map, keyType key) \
+{ \
+    size_t i = ctls_hmap_findIndex_##suffix(map, key, ctls_hmap_mix(hash(key))); \
+    return i == SIZE_MAX ? NULL : &map->entries[i].value; \
+} \
+\
+bool ctls_hmap_contains_##suffix(const struct ctls_HashMap_##suffix* map, keyType key) \
+{ \
+    return ctls_hmap_find_##suffix(map, key); \
+} \
+\
+valueType* ctls_hmap_emplace_##suffix(struct ctls_HashMap_##suffix* map, keyType key, bool* inserted) \
+{ \
+    size_t h = ctls_hmap_mix(hash(key)), i = ctls_hmap_findIndex_##suffix(map, key, h); \
+    if (inserted) \
+        *inserted = i == SIZE_MAX; \
+    if (i != SIZE_MAX) \
+        return &map->entries[i].value; \
+    if (map->capacity) \
+        i = ctls_hmap_findFree_##suffix(map, h); \
+    /* Reusing a tombstone never requires a rehash. Otherwise, a map that is mostly tombstones is rehashed in */ \
+    /* place, and one that is mostly entries doubles its capacity. */ \
+    if (!map->capacity || (!map->growthLeft && map->ctrl[i] == CTLS_HMAP_EMPTY)) \
+    { \
+        size_t newCapacity = map->capacity; \
+        if (map->size >= map->capacity / 2) \
+            newCapacity = ctls_hmap_capacityFor_##suffix(map->capacity ? map->capacity : 1); \
+        if (!newCapacity || !ctls_hmap_rehash_##suffix(map, newCapacity)) \
+            return NULL; \
+        i = ctls_hmap_findFree_##suffix(map, h); \
+    } \
+    map->growthLeft -= map->ctrl[i] == CTLS_HMAP_EMPTY; \
+    ctls_hmap_setCtrl_##suffix(map, i, (signed char)(h & 0x7F)); \
+    map->entries[i].key = key; \
+    ++map->size; \
+    return &map->entries[i].value; \
+} \
+\
+bool ctls_hmap_insert_##suffix(struct ctls_HashMap_##suffix* map, keyType key, valueType value) \
+{ \
+    valueType* slot = ctls_hmap_emplace_##suffix(map, key, NULL); \
+    if (slot) \
+        *slot = value; \
+    return slot; \
+} \
+\
+bool ctls_hmap_erase_##suffix(struct ctls_HashMap_##suffix* map, keyType key) \
+{ \
+    size_t i = ctls_hmap_findIndex_##suffix(map, key, ctls_hmap_mix(hash(key))); \
+    if (i == SIZE_MAX) \
+        return false; \
+    /* If no group that contains slot i has ever been full, no probe sequence has continued past slot i, so the */ \
+    /* slot can be marked empty rather than deleted. */ \
+    size_t mask = map->capacity - 1; \
+    unsigned after = ctls_hmap_matchEmpty(map->ctrl + i); \
+    unsigned before = ctls_hmap_matchEmpty(map->ctrl + ((i - CTLS_HMAP_GROUP_WIDTH) & mask)); \
+    bool wasNeverFull = after && before \
+        && ctls_hmap_ctz(after) + ctls_hmap_clz16(before) < CTLS_HMAP_GROUP_WIDTH; \
+    ctls_hmap_setCtrl_##suffix(map, i, wasNeverFull ? CTLS_HMAP_EMPTY : CTLS_HMAP_DELETED); \
+    map->growthLeft += wasNeverFull; \
+    --map->size; \
+    return true; \
+} \
+\
+struct ctls_HashMapEntry_##suffix* ctls_hmap_next_##suffix(const struct ctls_HashMap_##suffix* map, size_t* index) \
+{ \
+    for (size_t i = *index; i < map->capacity; ++i) \
+    { \
+        if (map->ctrl[i] >= 0) \
+        { \
+            *index = i + 1; \
+            return &map->entries[i]; \
+        } \
+    } \
+    *index = map->capacity; \
+    return NULL; \
+}
+
+/**
+ * @brief a convenience function that calls both `CTLS_HASH_MAP_DECL` and `CTLS_HASH_MAP_DEF`.
+ * @param keyType the type of the keys
+ * @param valueType the type of the values
+ * @param suffix a string appended to each declared identifier
+ * @param hash a function or function-like macro that returns a `size_t` hash of a key
+ * @param eq a function or function-like macro that returns nonzero if two keys are equal
+ *
+ * **Usage**
+ * @code
+ * #define HASH_INT(key) ctls_hmap_hashInt(key)
+ * #define EQ_INT(a, b) ((a) == (b))
+ * CTLS_HASH_MAP(int, double, intToDouble, HASH_INT, EQ_INT)
+ * @endcode
+ */
+#define CTLS_HASH_MAP(keyType, valueType, suffix, hash, eq) \
+CTLS_HASH_MAP_DECL(keyType, valueType, suffix) \
+CTLS_HASH_MAP_DEF(keyType, valueType, suffix, hash, eq)
+
+#endif
@@ -0,0 +1,230 @@
+#ifndef CUTILS_DATA_STRUCTURES_HEAP_G_H_10162026
+#define CUTILS_DATA_STRUCTURES_HEAP_G_H_10162026
+
+/** @file
+ * @brief Contains priority queue functions for specializations of `ctls_DynArray`.
+ *
+ * The macros in this file add functions to a specialization created with the macros in
+ * cutils/data_structures/dyn_array_g.h, which keep its elements arranged as a heap. They take the same `type` and
+ * `suffix` arguments, which must name an existing specialization, and a `less` argument like the one taken by
+ * `CTLS_DYN_ARRAY_SORT`: the name of a function or function-like macro such that `less(a, b)` is nonzero if and only if
+ * the element `a` is ordered before the element `b`. The element ordered first is always `dynArr->data[0]`.
+ *
+ * The heap is 4-ary: the children of the element at index *i* are those at indices 4*i* + 1 to 4*i* + 4. Compared to a
+ * binary heap, it is half as deep, so an element sifted towards the root moves half as many times. An element sifted
+ * away from it compares four siblings per level, but they are adjacent in memory, and usually share a cache line.
+ *
+ * **Index tracking**
+ *
+ * Changing the priority of an element, or removing it before it reaches the top, requires knowing where it is in the
+ * heap. `CTLS_HEAP_INDEXED_DEF` takes a further argument, `setIndex`, a function or function-like macro such that
+ * `setIndex(elem, index)` records that the element `elem`, an lvalue, is now at index `index`. It is called whenever an
+ * element is placed in the heap or moved within it, and with an index of `SIZE_MAX` for an element that is removed.
+ * Elements that are pointers can store their index in the object they point to; elements that are values can store it
+ * in a table, keyed by an identifier they contain.
+ *
+ * @code
+ * struct Timer
+ * {
+ *     uint64_t deadline;
+ *     size_t heapIndex;
+ * };
+ *
+ * #define EARLIER(a, b) ((a)->deadline < (b)->deadline)
+ * #define SET_HEAP_INDEX(timer, index) ((timer)->heapIndex = (index))
+ *
+ * CTLS_DYN_ARRAY(struct Timer*, timer)
+ * CTLS_HEAP_INDEXED(struct Timer*, timer, EARLIER, SET_HEAP_INDEX)
+ *
+ * void postpone(struct ctls_DynArray_timer* timers, struct Timer* timer, uint64_t delay)
+ * {
+ *     timer->deadline += delay;
+ *     ctls_heap_update_timer(timers, timer->heapIndex);
+ * }
+ * @endcode
+ *
+ * The array's own mutators, such as `ctls_dyn_append_##suffix`, do not maintain the heap. After using them, call
+ * `ctls_heap_heapify_##suffix`.
+ */
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/** @brief The number of children of each element of a heap. */
+#define CTLS_HEAP_ARITY 4
+
+/** @brief A `setIndex` argument that does nothing, used by `CTLS_HEAP_DEF`. */
+#define CTLS_HEAP_NO_INDEX(elem, index) ((void)0)
+
+/**
+ * @brief Creates declarations for the priority queue functions of a specialization of `ctls_DynArray`.
+ * @param type the name of the type the specialization is for
+ * @param suffix the suffix of the specialization
+ *
+ * The following functions are declared:
+ * - `void ctls_heap_heapify_##suffix(dynArr)` arranges the elements as a heap, in linear time.
+ * - `bool ctls_heap_push_##suffix(dynArr, elem)` adds `elem` to the heap, and returns `true` on success.
+ * - `type ctls_heap_pop_##suffix(dynArr)` removes and returns the element ordered first. `dynArr` must not be empty.
+ * - `type ctls_heap_removeAt_##suffix(dynArr, index)` removes and returns the element at `index`, which must be less
+ *     than `dynArr->size`.
+ * - `void ctls_heap_decreaseKey_##suffix(dynArr, index, elem)` replaces the element at `index` with `elem`, which must
+ *     not be ordered after it.
+ * - `void ctls_heap_update_##suffix(dynArr, index)` restores the heap after the element at `index` was modified in
+ *     place, whether it is now ordered earlier or later.
+ *
+ * Apart from `ctls_heap_heapify_##suffix`, each function requires `dynArr` to be a heap, and takes \f$O(\log n)\f$
+ * time.
+ */
+#define CTLS_HEAP_DECL(type, suffix) \
+\
+void ctls_heap_heapify_##suffix(struct ctls_DynArray_##suffix* dynArr); \
+bool ctls_heap_push_##suffix(struct ctls_DynArray_##suffix* dynArr, type elem); \
+type ctls_heap_pop_##suffix(struct ctls_DynArray_##suffix* dynArr); \
+type ctls_heap_removeAt_##suffix(struct ctls_DynArray_##suffix* dynArr, size_t index); \
+void ctls_heap_decreaseKey_##suffix(struct ctls_DynArray_##suffix* dynArr, size_t index, type elem); \
+void ctls_heap_update_##suffix(struct ctls_DynArray_##suffix* dynArr, size_t index);
+
+/**
+ * @brief Creates definitions for the priority queue functions of a specialization of `ctls_DynArray`, which report
+ *     where elements move.
+ * @param type the name of the type the specialization is for
+ * @param suffix the suffix of the specialization
+ * @param less the ordering of the elements
+ * @param setIndex called as `setIndex(elem, index)` whenever an element is placed at a new index
+ *
+ * The corresponding declarations can, and should, be included via `CTLS_HEAP_DECL`.
+ */
+#define CTLS_HEAP_INDEXED_DEF(type, suffix, less, setIndex) \
+\
+/* Fills the hole at `index` with `elem`, moving the parents ordered after `elem` down into the hole on the way. */ \
+static void ctls_heap_siftUp_##suffix(type* data, size_t index, type elem) \
+{ \
+    while (index) \
+    { \
+        size_t parent = (index - 1) / CTLS_HEAP_ARITY; \
+        if (!less(elem, data[parent])) \
+            break; \
+        data[index] = data[parent]; \
+        setIndex(data[index], index); \
+        index = parent; \
+    } \
+    data[index] = elem; \
+    setIndex(data[index], index); \
+} \
+\
+/* Fills the hole at `index` with `elem`, moving the first child ordered before `elem` up into the hole each time. */ \
+static void ctls_heap_siftDown_##suffix(type* data, size_t size, size_t index, type elem) \
+{ \
+    /* The element at `index` has children if and only if CTLS_HEAP_ARITY * index + 1 < size. */ \
+    while (size > 1 && index <= (size - 2) / CTLS_HEAP_ARITY) \
+    { \
+        size_t child = CTLS_HEAP_ARITY * index + 1, best = child; \
+        size_t end = size - child < CTLS_HEAP_ARITY ? size : child + CTLS_HEAP_ARITY; \
+        for (++child; child < end; ++child) \
+        { \
+            if (less(data[child], data[best])) \
+                best = child; \
+        } \
+        if (!less(data[best], elem)) \
+            break; \
+        data[index] = data[best]; \
+        setIndex(data[index], index); \
+        index = best; \
+    } \
+    data[index] = elem; \
+    setIndex(data[index], index); \
+} \
+\
+void ctls_heap_heapify_##suffix(struct ctls_DynArray_##suffix* dynArr) \
+{ \
+    type* data = dynArr->data; \
+    size_t size = dynArr->size; \
+    for (size_t i = size > 1 ? (size - 2) / CTLS_HEAP_ARITY + 1 : 0; i--;) \
+        ctls_heap_siftDown_##suffix(data, size, i, data[i]); \
+    /* Elements that never moved have not been told their index yet. */ \
+    for (size_t i = 0; i < size; ++i) \
+        setIndex(data[i], i); \
+} \
+\
+bool ctls_heap_push_##suffix(struct ctls_DynArray_##suffix* dynArr, type elem) \
+{ \
+    if (!ctls_dyn_append_##suffix(dynArr, elem)) \
+        return false; \
+    ctls_heap_siftUp_##suffix(dynArr->data, dynArr->size - 1, elem); \
+    return true; \
+} \
+\
+type ctls_heap_removeAt_##suffix(struct ctls_DynArray_##suffix* dynArr, size_t index) \
+{ \
+    type removed = dynArr->data[index], last = dynArr->data[--dynArr->size]; \
+    if (index < dynArr->size) \
+    { \
+        if (less(last, removed)) \
+            ctls_heap_siftUp_##suffix(dynArr->data, index, last); \
+        else \
+            ctls_heap_siftDown_##suffix(dynArr->data, dynArr->size, index, last); \
+    } \
+    setIndex(removed, SIZE_MAX); \
+    return removed; \
+} \
+\
+type ctls_heap_pop_##suffix(struct ctls_DynArray_##suffix* dynArr) \
+{ \
+    return ctls_heap_removeAt_##suffix(dynArr, 0); \
+} \
+\
+void ctls_heap_decreaseKey_##suffix(struct ctls_DynArray_##suffix* dynArr, size_t index, type elem) \
+{ \
+    ctls_heap_siftUp_##suffix(dynArr->data, index, elem); \
+} \
+\
+void ctls_heap_update_##suffix(struct ctls_DynArray_##suffix* dynArr, size_t index) \
+{ \
+    type elem = dynArr->data[index]; \
+    if (index && less(elem, dynArr->data[(index - 1) / CTLS_HEAP_ARITY])) \
+        ctls_heap_siftUp_##suffix(dynArr->data, index, elem); \
+    else \
+        ctls_heap_siftDown_##suffix(dynArr->data, dynArr->size, index, elem); \
+}
+
+/**
+ * @brief Creates definitions for the priority queue functions of a specialization of `ctls_DynArray`.
+ * @param type the name of the type the specialization is for
+ * @param suffix the suffix of the specialization
+ * @param less the ordering of the elements
+ *
+ * The corresponding declarations can, and should, be included via `CTLS_HEAP_DECL`.
+ */
+#define CTLS_HEAP_DEF(type, suffix, less) CTLS_HEAP_INDEXED_DEF(type, suffix, less, CTLS_HEAP_NO_INDEX)
+
+/**
+ * @brief a convenience function that calls both `CTLS_HEAP_DECL` and `CTLS_HEAP_DEF`.
+ * @param type the name of the type the specialization is for
+ * @param suffix the suffix of the specialization
+ * @param less the ordering of the elements
+ *
+ * **Usage**
+ * @code
+ * #define GREATER(a, b) ((a) > (b))
+ *
+ * CTLS_DYN_ARRAY(int, int)
+ * CTLS_HEAP(int, int, GREATER)    // a max-heap
+ * @endcode
+ */
+#define CTLS_HEAP(type, suffix, less) \
+CTLS_HEAP_DECL(type, suffix) \
+CTLS_HEAP_DEF(type, suffix, less)
+
+/**
+ * @brief a convenience function that calls both `CTLS_HEAP_DECL` and `CTLS_HEAP_INDEXED_DEF`.
+ * @param type the name of the type the specialization is for
+ * @param suffix the suffix of the specialization
+ * @param less the ordering of the elements
+ * @param setIndex called as `setIndex(elem, index)` whenever an element is placed at a new index
+ */
+#define CTLS_HEAP_INDEXED(type, suffix, less, setIndex) \
+CTLS_HEAP_DECL(type, suffix) \
+CTLS_HEAP_INDEXED_DEF(type, suffix, less, setIndex)
+
+#endif
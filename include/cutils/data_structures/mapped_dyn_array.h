@@ -0,0 +1,155 @@
+#ifndef CUTILS_DATA_STRUCTURES_MAPPED_DYN_ARRAY_H_10162026
+#define CUTILS_DATA_STRUCTURES_MAPPED_DYN_ARRAY_H_10162026
+
+/** @file
+ * @brief Contains a dynamic array whose elements are stored in a memory-mapped file.
+ *
+ * A mapped dynamic array behaves like a `ctls_DynArray`, except that `ctls_MappedDynArray::data` points into a shared
+ * mapping of a file, rather than into the heap. The operating system pages elements in and out as they are accessed,
+ * so an array may be larger than physical memory, and its contents persist once it is closed.
+ *
+ * The file starts with a header of `CTLS_MDYN_HEADER_SIZE` bytes, which records the element size, the size, and the
+ * capacity of the array, followed by `capacity` elements. Reopening an existing file therefore only maps it, without
+ * reading any elements, and takes constant time regardless of the file's size. The mutators declared in this file keep
+ * the header's size up to date, so the elements a mutator has added survive the process, even if
+ * `ctls_mdyn_close()` is never called. They only survive a crash of the operating system once `ctls_mdyn_sync()` has
+ * returned.
+ *
+ * The file grows with `ftruncate`, and the mapping with `mremap` where available. Growth follows
+ * `ctls_MappedDynArray::growthPolicy`, exactly like that of a `ctls_DynArray`. As with a `ctls_DynArray`, growth may
+ * move `data`, so pointers to elements are invalidated by any mutator that adds elements.
+ *
+ * Unlike those of `ctls_DynArray`, the functions declared in this file do not take an `elemSize` parameter, as the
+ * element size is recorded in the file. Elements are stored as raw bytes, so files are only portable between processes
+ * that agree on the elements' representation.
+ *
+ * A file must not be opened by more than one mapped dynamic array at a time. This file requires a POSIX system.
+ */
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "cutils/data_structures/dyn_growth.h"
+
+/** @brief The number of bytes that precede the first element in the file. */
+#define CTLS_MDYN_HEADER_SIZE 64
+
+/** @brief A dynamic array backed by a memory-mapped file. */
+struct ctls_MappedDynArray
+{
+    /** @brief the first element, which lies `CTLS_MDYN_HEADER_SIZE` bytes into the mapping */
+    void* data;
+    /** @brief number of elements contained in this array */
+    size_t size;
+    /** @brief maximum number of elements that fit in the file until it must be extended */
+    size_t capacity;
+    /** @brief size of one element, as recorded in the file */
+    size_t elemSize;
+    /** @brief how this array's capacity grows once it runs out of room */
+    enum ctls_DynGrowthPolicy growthPolicy;
+    /** @brief the open file */
+    int fd;
+    /** @brief the start of the mapping, where the header lies */
+    void* mapping;
+    /** @brief size of the mapping; the file is at least this large, and larger only if it could not be shrunk */
+    size_t mappingSize;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Initialization and Cleanup
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Opens a mapped dynamic array, creating its file if it does not exist.
+ * @param mapArr pointer to an uninitialized mapped dynamic array, or `NULL`
+ * @param path path of the file that backs the array
+ * @param elemSize size of one of the array's elements; must be nonzero
+ * @param initialCapacity the capacity of the array if the file is created; must be nonzero
+ * @return On success, returns a dynamically allocated mapped dynamic array if `mapArr` was originally `NULL`, `mapArr`
+ *     otherwise. On failure, returns `NULL`.
+ *
+ * If `path` names an empty or nonexistent file, it is extended to hold `initialCapacity` elements, and the array is
+ * empty. Otherwise, the file must have been created by this function with the same `elemSize`, and the array contains
+ * the elements it contained when last modified. The operation fails if the file's header is invalid or records a
+ * different element size, and the file is then left untouched.
+ */
+struct ctls_MappedDynArray* ctls_mdyn_open(struct ctls_MappedDynArray* mapArr, const char* path, size_t elemSize,
+    size_t initialCapacity);
+
+/**
+ * @brief Writes a mapped dynamic array's size to its file, unmaps the file, closes it, and zeroes the array out.
+ * @param mapArr pointer to an open mapped dynamic array
+ * @return `true` if the file was closed without error, `false` if not. Either way, `mapArr` is zeroed out.
+ *
+ * Does not wait for the file to reach the disk; see `ctls_mdyn_sync()`.
+ */
+bool ctls_mdyn_close(struct ctls_MappedDynArray* mapArr);
+
+/**
+ * @brief Writes a mapped dynamic array's size to its file, and waits until the file's contents have reached the disk.
+ * @param mapArr pointer to an open mapped dynamic array
+ * @return `true` if the operation succeeds, `false` if not
+ *
+ * `mapArr->size` is written to the header first, so direct modifications of it, such as decrementing it to remove the
+ * last element, are persisted as well.
+ */
+bool ctls_mdyn_sync(struct ctls_MappedDynArray* mapArr);
+
+/**
+ * @brief Shrinks a mapped dynamic array's file to fit its elements.
+ * @param mapArr pointer to an open mapped dynamic array
+ * @return `true` if the operation succeeds, `false` if not
+ *
+ * If the operation succeeds, `mapArr->capacity` is equal to `mapArr->size`, or to one if the array is empty.
+ */
+bool ctls_mdyn_shrinkToFit(struct ctls_MappedDynArray* mapArr);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Mutators
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Adds an element to the end of a mapped dynamic array.
+ * @param mapArr pointer to an open mapped dynamic array
+ * @param elem pointer to the element that is to be added
+ * @return `true` if the operation succeeds, `false` if not
+ *
+ * The object `elem` points to cannot already be contained in `mapArr`.
+ */
+bool ctls_mdyn_append(struct ctls_MappedDynArray* restrict mapArr, const void* restrict elem);
+
+/**
+ * @brief Inserts the elements of `src` before `mapArr->data + pos`.
+ * @param mapArr pointer to an open mapped dynamic array
+ * @param src pointer to the elements that are to be added; must not point into `mapArr`
+ * @param pos index before which elements are to be added. Must not be greater than `mapArr->size`.
+ * @param srcLen number of elements that are to be added
+ * @return `true` if the operation succeeds, `false` if not
+ *
+ * Behaves like `ctls_dyn_insert()`.
+ */
+bool ctls_mdyn_insert(struct ctls_MappedDynArray* mapArr, const void* src, size_t pos, size_t srcLen);
+
+/**
+ * @brief Inserts the elements of `src` at the end of a mapped dynamic array.
+ * @param mapArr pointer to an open mapped dynamic array
+ * @param src pointer to the elements that are to be added; must not point into `mapArr`
+ * @param srcLen number of elements that are to be added
+ * @return `true` if the operation succeeds, `false` if not
+ *
+ * Equivalent to `ctls_mdyn_insert(mapArr, src, mapArr->size, srcLen)`.
+ */
+bool ctls_mdyn_extend(struct ctls_MappedDynArray* mapArr, const void* src, size_t srcLen);
+
+/**
+ * @brief Removes the elements from a mapped dynamic array at indices \f$i\f$ such that \f$from <= i < to\f$.
+ * @param mapArr pointer to an open mapped dynamic array
+ * @param from first index whose corresponding element is removed
+ * @param to index after the last whose corresponding element is removed; must not be less than `from` or greater than
+ *     `mapArr->size`
+ *
+ * Behaves like `ctls_dyn_remove()`.
+ */
+void ctls_mdyn_remove(struct ctls_MappedDynArray* mapArr, size_t from, size_t to);
+
+#endif
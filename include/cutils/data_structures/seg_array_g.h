@@ -0,0 +1,225 @@
+#ifndef CUTILS_DATA_STRUCTURES_SEG_ARRAY_G_H_10162026
+#define CUTILS_DATA_STRUCTURES_SEG_ARRAY_G_H_10162026
+
+/** @file
+ * @brief Contains a generic segmented array, whose elements never move.
+ *
+ * A `ctls_DynArray` keeps its elements in one block, which it reallocates as it grows. Every reallocation may move the
+ * elements, so pointers to them cannot be kept, and a large reallocation copies the whole array while both the old and
+ * the new block are live. A segmented array instead grows by allocating another segment, leaving the existing ones in
+ * place. Pointers to its elements therefore stay valid until the elements are removed or the array is reset, and no
+ * append ever copies more than the element being appended.
+ *
+ * The first segment holds a power of two, *B*, of elements, and each further segment holds twice as many as the one
+ * before it, so the capacity doubles with every segment, and at most half of it is ever unused. The segment holding a
+ * given index and the index's offset within it follow from the position of the highest set bit of `index + B`, so
+ * `ctls_seg_at_##suffix` takes constant time, and only costs a few more instructions than indexing a plain array. Its
+ * definition is part of the declarations, so that it can be inlined.
+ *
+ * @code
+ * CTLS_SEG_ARRAY(struct Node, node)
+ *
+ * struct Node* newNode(struct ctls_SegArray_node* nodes, struct Node* parent)
+ * {
+ *     // Stays valid as more nodes are appended.
+ *     return ctls_seg_append_node(nodes, (struct Node){.parent = parent});
+ * }
+ * @endcode
+ *
+ * The functions associated with a given specialization are:
+ *
+ * - `ctls_seg_init_##suffix(segArr, initialCapacity)`, `ctls_seg_initWithAllocator_##suffix(segArr, initialCapacity,
+ *     allocator)`, and `ctls_seg_defaultInit_##suffix(segArr)` initialize an empty array whose first segment holds
+ *     `initialCapacity` elements, rounded up to a power of two. They return `NULL` on failure, and, like
+ *     `ctls_dyn_init`, allocate the array itself if `segArr` is `NULL`.
+ * - `ctls_seg_reset_##suffix(segArr)` frees every segment and zeroes the array's members out.
+ * - `ctls_seg_reserve_##suffix(segArr, capacity)` adds segments until the capacity is at least `capacity`, and
+ *     `ctls_seg_shrinkToFit_##suffix(segArr)` frees the segments that hold no elements, except for the first.
+ * - `ctls_seg_at_##suffix(segArr, index)` returns a pointer to the element at `index`, which must be less than the
+ *     capacity.
+ * - `ctls_seg_append_##suffix(segArr, elem)` adds an element to the end of the array, and returns a pointer to it, or
+ *     `NULL` on failure. `ctls_seg_extend_##suffix(segArr, src, srcLen)` adds the elements of `src`, and returns
+ *     whether it succeeded.
+ *
+ * As with `ctls_DynArray`, the last element can be removed by decrementing `size`. Elements cannot be inserted or
+ * removed elsewhere, as that would move the elements after them.
+ */
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <limits.h>
+
+#include "cutils/data_structures/dyn_growth.h"
+#include "cutils/memory/allocator.h"
+
+/** @brief The maximum number of segments in a segmented array, which suffices to index any `size_t`. */
+#define CTLS_SEG_MAX_SEGMENTS (sizeof(size_t) * CHAR_BIT)
+#define CTLS_SEG_DEFAULT_INITIAL_CAPACITY 8
+
+/**
+ * @brief Creates declarations for a specialization of `ctls_SegArray`.
+ * @param type the name of the type to be specialized for
+ * @param suffix a string appended to each declared identifier
+ *
+ * The corresponding implementation is created via `CTLS_SEG_ARRAY_DEF`.
+ */
+#define CTLS_SEG_ARRAY_DECL(type, suffix) \
+\
+struct ctls_SegArray_##suffix \
+{ \
+    type* segments[CTLS_SEG_MAX_SEGMENTS]; \
+    size_t size, capacity, segmentCount; \
+    /* the base-2 logarithm of the first segment's length */ \
+    size_t baseLog2; \
+    const struct ctls_Allocator* allocator; \
+}; \
+\
+struct ctls_SegArray_##suffix* ctls_seg_init_##suffix(struct ctls_SegArray_##suffix* segArr, \
+    size_t initialCapacity); \
+struct ctls_SegArray_##suffix* ctls_seg_initWithAllocator_##suffix(struct ctls_SegArray_##suffix* segArr, \
+    size_t initialCapacity, const struct ctls_Allocator* allocator); \
+struct ctls_SegArray_##suffix* ctls_seg_defaultInit_##suffix(struct ctls_SegArray_##suffix* segArr); \
+void ctls_seg_reset_##suffix(struct ctls_SegArray_##suffix* segArr); \
+bool ctls_seg_reserve_##suffix(struct ctls_SegArray_##suffix* segArr, size_t capacity); \
+void ctls_seg_shrinkToFit_##suffix(struct ctls_SegArray_##suffix* segArr); \
+type* ctls_seg_append_##suffix(struct ctls_SegArray_##suffix* segArr, type elem); \
+bool ctls_seg_extend_##suffix(struct ctls_SegArray_##suffix* segArr, type const* src, size_t srcLen); \
+\
+static inline type* ctls_seg_at_##suffix(const struct ctls_SegArray_##suffix* segArr, size_t index) \
+{ \
+    /* Segment k holds the indices for which index + B lies in [B * 2^k, B * 2^(k + 1)). */ \
+    size_t biased = index + ((size_t)1 << segArr->baseLog2); \
+    size_t segment = ctls_dyn_floorLog2(biased) - segArr->baseLog2; \
+    return segArr->segments[segment] + (biased - ((size_t)1 << (segment + segArr->baseLog2))); \
+}
+
+/**
+ * @brief Creates definitions for a specialization of `ctls_SegArray`.
+ * @param type the name of the type to be specialized for
+ * @param suffix a string appended to each declared identifier
+ *
+ * The corresponding declarations can, and should, be included via `CTLS_SEG_ARRAY_DECL`.
+ */
+#define CTLS_SEG_ARRAY_DEF(type, suffix) \
+\
+static bool ctls_seg_addSegment_##suffix(struct ctls_SegArray_##suffix* segArr) \
+{ \
+    size_t shift = segArr->baseLog2 + segArr->segmentCount; \
+    if (shift >= CTLS_SEG_MAX_SEGMENTS - 1 || ((size_t)1 << shift) > SIZE_MAX / 2 / sizeof(type)) \
+        return false; \
+    size_t length = (size_t)1 << shift; \
+    type* segment = ctls_allocate(segArr->allocator, length * sizeof(type)); \
+    if (!segment) \
+        return false; \
+    segArr->segments[segArr->segmentCount++] = segment; \
+    segArr->capacity += length; \
+    return true; \
+} \
+\
+struct ctls_SegArray_##suffix* ctls_seg_initWithAllocator_##suffix(struct ctls_SegArray_##suffix* segArr, \
+    size_t initialCapacity, const struct ctls_Allocator* allocator) \
+{ \
+    bool segArrOriginallyNull = !segArr; \
+    if (segArrOriginallyNull) \
+        segArr = malloc(sizeof *segArr); \
+    if (!segArr) \
+        return NULL; \
+    memset(segArr, 0, sizeof *segArr); \
+    segArr->allocator = allocator; \
+    segArr->baseLog2 = initialCapacity > 1 ? ctls_dyn_floorLog2(initialCapacity - 1) + 1 : 0; \
+    if (!ctls_seg_addSegment_##suffix(segArr)) \
+    { \
+        if (segArrOriginallyNull) \
+            free(segArr); \
+        return NULL; \
+    } \
+    return segArr; \
+} \
+\
+struct ctls_SegArray_##suffix* ctls_seg_init_##suffix(struct ctls_SegArray_##suffix* segArr, \
+    size_t initialCapacity) \
+{ \
+    return ctls_seg_initWithAllocator_##suffix(segArr, initialCapacity, NULL); \
+} \
+\
+struct ctls_SegArray_##suffix* ctls_seg_defaultInit_##suffix(struct ctls_SegArray_##suffix* segArr) \
+{ \
+    return ctls_seg_init_##suffix(segArr, CTLS_SEG_DEFAULT_INITIAL_CAPACITY); \
+} \
+\
+void ctls_seg_reset_##suffix(struct ctls_SegArray_##suffix* segArr) \
+{ \
+    for (size_t k = 0; k < segArr->segmentCount; ++k) \
+    { \
+        size_t length = (size_t)1 << (segArr->baseLog2 + k); \
+        ctls_deallocate(segArr->allocator, segArr->segments[k], length * sizeof(type)); \
+    } \
+    memset(segArr, 0, sizeof(struct ctls_SegArray_##suffix)); \
+} \
+\
+bool ctls_seg_reserve_##suffix(struct ctls_SegArray_##suffix* segArr, size_t capacity) \
+{ \
+    while (segArr->capacity < capacity) \
+    { \
+        if (!ctls_seg_addSegment_##suffix(segArr)) \
+            return false; \
+    } \
+    return true; \
+} \
+\
+void ctls_seg_shrinkToFit_##suffix(struct ctls_SegArray_##suffix* segArr) \
+{ \
+    while (segArr->segmentCount > 1) \
+    { \
+        size_t length = (size_t)1 << (segArr->baseLog2 + segArr->segmentCount - 1); \
+        if (segArr->capacity - length < segArr->size) \
+            break; \
+        ctls_deallocate(segArr->allocator, segArr->segments[--segArr->segmentCount], length * sizeof(type)); \
+        segArr->segments[segArr->segmentCount] = NULL; \
+        segArr->capacity -= length; \
+    } \
+} \
+\
+type* ctls_seg_append_##suffix(struct ctls_SegArray_##suffix* segArr, type elem) \
+{ \
+    if (segArr->size == segArr->capacity && !ctls_seg_addSegment_##suffix(segArr)) \
+        return NULL; \
+    type* slot = ctls_seg_at_##suffix(segArr, segArr->size++); \
+    *slot = elem; \
+    return slot; \
+} \
+\
+bool ctls_seg_extend_##suffix(struct ctls_SegArray_##suffix* segArr, type const* src, size_t srcLen) \
+{ \
+    if (srcLen > SIZE_MAX - segArr->size || !ctls_seg_reserve_##suffix(segArr, segArr->size + srcLen)) \
+        return false; \
+    /* Copies one segment's worth at a time. The segment that holds index i ends at index 2 * (i + B) - B. */ \
+    while (srcLen) \
+    { \
+        size_t biased = segArr->size + ((size_t)1 << segArr->baseLog2); \
+        size_t segmentEnd = ((size_t)2 << ctls_dyn_floorLog2(biased)) - ((size_t)1 << segArr->baseLog2); \
+        size_t count = segmentEnd - segArr->size < srcLen ? segmentEnd - segArr->size : srcLen; \
+        memcpy(ctls_seg_at_##suffix(segArr, segArr->size), src, count * sizeof(type)); \
+        segArr->size += count, src += count, srcLen -= count; \
+    } \
+    return true; \
+}
+
+/**
+ * @brief a convenience function that calls both `CTLS_SEG_ARRAY_DECL` and `CTLS_SEG_ARRAY_DEF`.
+ * @param type the name of the type to be specialized for
+ * @param suffix a string appended to each declared identifier
+ *
+ * **Usage**
+ * @code
+ * CTLS_SEG_ARRAY(int, int)
+ * @endcode
+ */
+#define CTLS_SEG_ARRAY(type, suffix) \
+CTLS_SEG_ARRAY_DECL(type, suffix) \
+CTLS_SEG_ARRAY_DEF(type, suffix)
+
+#endif
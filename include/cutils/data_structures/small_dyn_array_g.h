@@ -0,0 +1,224 @@
+#ifndef CUTILS_DATA_STRUCTURES_SMALL_DYN_ARRAY_G_H_10162026
+#define CUTILS_DATA_STRUCTURES_SMALL_DYN_ARRAY_G_H_10162026
+
+/** @file
+ * @brief Contains a generic dynamic array with inline storage for a small number of elements.
+ *
+ * A small dynamic array stores up to *N* elements in a buffer embedded in the array itself, and only moves them to a
+ * heap block once it grows past *N*. Arrays that stay small therefore never touch the allocator, and their elements
+ * share a cache line with `size` and `capacity`.
+ *
+ * The macros in this file take the same `type` and `suffix` arguments as those in
+ * cutils/data_structures/dyn_array_g.h, plus the inline capacity `N`, which must be a positive integer constant. The
+ * functions associated with a specialization mirror those of `ctls_DynArray`, with `ctls_dyn` replaced by `ctls_sdyn`:
+ *
+ * @code
+ * CTLS_SMALL_DYN_ARRAY(int, int, 8)
+ *
+ * void f(void)
+ * {
+ *     struct ctls_SmallDynArray_int arr;
+ *     ctls_sdyn_init_int(&arr);
+ *     ctls_sdyn_append_int(&arr, 42);    // no allocation
+ *     // ...
+ *     ctls_sdyn_reset_int(&arr);
+ * }
+ * @endcode
+ *
+ * The invariants of a small dynamic array `dynArr` differ from those of `ctls_DynArray` as follows:
+ * - If `dynArr->data == dynArr->inlineData`, `dynArr->capacity` is *N* and no memory is owned by `dynArr`.
+ * - Otherwise, `dynArr->data` was allocated by `dynArr->allocator` and `dynArr->capacity` is greater than *N*.
+ *
+ * Since `data` may point into the array itself, a small dynamic array must not be copied by assignment or `memcpy`;
+ * use `ctls_sdyn_copy_##suffix` instead. For the same reason, an array whose members have been zeroed out is not
+ * valid, and must be initialized before use.
+ */
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "cutils/data_structures/dyn_growth.h"
+#include "cutils/memory/allocator.h"
+
+/**
+ * @brief Creates declarations for a small dynamic array specialization.
+ * @param type the name of the type to be specialized for
+ * @param suffix a string appended to each declared identifier
+ * @param N the number of elements stored inline
+ *
+ * The corresponding implementation is created via `CTLS_SMALL_DYN_ARRAY_DEF`.
+ */
+#define CTLS_SMALL_DYN_ARRAY_DECL(type, suffix, N) \
+\
+struct ctls_SmallDynArray_##suffix \
+{ \
+    type* data; \
+    size_t size, capacity; \
+    const struct ctls_Allocator* allocator; \
+    enum ctls_DynGrowthPolicy growthPolicy; \
+    type inlineData[N]; \
+}; \
+\
+struct ctls_SmallDynArray_##suffix* ctls_sdyn_init_##suffix(struct ctls_SmallDynArray_##suffix* dynArr); \
+struct ctls_SmallDynArray_##suffix* ctls_sdyn_initWithAllocator_##suffix( \
+    struct ctls_SmallDynArray_##suffix* dynArr, const struct ctls_Allocator* allocator); \
+void ctls_sdyn_reset_##suffix(struct ctls_SmallDynArray_##suffix* dynArr); \
+bool ctls_sdyn_shrinkToFit_##suffix(struct ctls_SmallDynArray_##suffix* dynArr); \
+struct ctls_SmallDynArray_##suffix* ctls_sdyn_copy_##suffix(struct ctls_SmallDynArray_##suffix* restrict dest, \
+    const struct ctls_SmallDynArray_##suffix* restrict src); \
+bool ctls_sdyn_append_##suffix(struct ctls_SmallDynArray_##suffix* dynArr, type elem); \
+bool ctls_sdyn_insert_##suffix(struct ctls_SmallDynArray_##suffix* dynArr, type const* src, size_t pos, \
+    size_t srcLen); \
+bool ctls_sdyn_extend_##suffix(struct ctls_SmallDynArray_##suffix* dynArr, type const* src, size_t srcLen); \
+void ctls_sdyn_remove_##suffix(struct ctls_SmallDynArray_##suffix* dynArr, size_t from, size_t to);
+
+/**
+ * @brief Creates definitions for a small dynamic array specialization.
+ * @param type the name of the type to be specialized for
+ * @param suffix a string appended to each declared identifier
+ * @param N the number of elements stored inline; must match the argument given to `CTLS_SMALL_DYN_ARRAY_DECL`
+ *
+ * `ctls_sdyn_init_##suffix` initializes an empty array that uses its inline buffer and the standard library
+ * allocator; `ctls_sdyn_initWithAllocator_##suffix` chooses the allocator used once the array spills to the heap.
+ * `ctls_sdyn_reset_##suffix` frees any heap block and zeroes out every member but the inline buffer.
+ * `ctls_sdyn_shrinkToFit_##suffix` moves the elements back inline if they fit. The remaining functions behave like
+ * their counterparts in cutils/data_structures/dyn_array.h.
+ */
+#define CTLS_SMALL_DYN_ARRAY_DEF(type, suffix, N) \
+\
+static bool ctls_sdyn_grow_##suffix(struct ctls_SmallDynArray_##suffix* dynArr, size_t srcLen) \
+{ \
+    if (srcLen > SIZE_MAX - dynArr->size) \
+        return false; \
+    size_t newCapacity = ctls_dyn_grownCapacity(dynArr->growthPolicy, dynArr->capacity, dynArr->size + srcLen, \
+        sizeof(type)); \
+    if (!newCapacity) \
+        return false; \
+    type* newData; \
+    if (dynArr->data == dynArr->inlineData) \
+    { \
+        newData = ctls_allocate(dynArr->allocator, newCapacity * sizeof(type)); \
+        if (newData) \
+            memcpy(newData, dynArr->inlineData, dynArr->size * sizeof(type)); \
+    } \
+    else \
+    { \
+        newData = ctls_reallocate(dynArr->allocator, dynArr->data, dynArr->capacity * sizeof(type), \
+            newCapacity * sizeof(type)); \
+    } \
+    if (newData) \
+        dynArr->data = newData, dynArr->capacity = newCapacity; \
+    return newData; \
+} \
+\
+struct ctls_SmallDynArray_##suffix* ctls_sdyn_initWithAllocator_##suffix( \
+    struct ctls_SmallDynArray_##suffix* dynArr, const struct ctls_Allocator* allocator) \
+{ \
+    if (!dynArr && !(dynArr = malloc(sizeof *dynArr))) \
+        return NULL; \
+    dynArr->data = dynArr->inlineData, dynArr->size = 0, dynArr->capacity = (N); \
+    dynArr->allocator = allocator, dynArr->growthPolicy = CTLS_DYN_GROWTH_GOLDEN; \
+    return dynArr; \
+} \
+\
+struct ctls_SmallDynArray_##suffix* ctls_sdyn_init_##suffix(struct ctls_SmallDynArray_##suffix* dynArr) \
+{ \
+    return ctls_sdyn_initWithAllocator_##suffix(dynArr, NULL); \
+} \
+\
+void ctls_sdyn_reset_##suffix(struct ctls_SmallDynArray_##suffix* dynArr) \
+{ \
+    if (dynArr->data != dynArr->inlineData) \
+        ctls_deallocate(dynArr->allocator, dynArr->data, dynArr->capacity * sizeof(type)); \
+    memset(dynArr, 0, offsetof(struct ctls_SmallDynArray_##suffix, inlineData)); \
+} \
+\
+bool ctls_sdyn_shrinkToFit_##suffix(struct ctls_SmallDynArray_##suffix* dynArr) \
+{ \
+    if (dynArr->data == dynArr->inlineData || dynArr->size == dynArr->capacity) \
+        return true; \
+    if (dynArr->size <= (N)) \
+    { \
+        memcpy(dynArr->inlineData, dynArr->data, dynArr->size * sizeof(type)); \
+        ctls_deallocate(dynArr->allocator, dynArr->data, dynArr->capacity * sizeof(type)); \
+        dynArr->data = dynArr->inlineData, dynArr->capacity = (N); \
+        return true; \
+    } \
+    type* newData = ctls_reallocate(dynArr->allocator, dynArr->data, dynArr->capacity * sizeof(type), \
+        dynArr->size * sizeof(type)); \
+    if (newData) \
+        dynArr->data = newData, dynArr->capacity = dynArr->size; \
+    return newData; \
+} \
+\
+struct ctls_SmallDynArray_##suffix* ctls_sdyn_copy_##suffix(struct ctls_SmallDynArray_##suffix* restrict dest, \
+    const struct ctls_SmallDynArray_##suffix* restrict src) \
+{ \
+    bool destOriginallyNull = !dest; \
+    if (!dest || !dest->data) \
+    { \
+        dest = ctls_sdyn_initWithAllocator_##suffix(dest, src->allocator); \
+        if (!dest) \
+            return NULL; \
+    } \
+    dest->size = 0; \
+    if (src->size > dest->capacity && !ctls_sdyn_grow_##suffix(dest, src->size)) \
+    { \
+        if (destOriginallyNull) \
+            free(dest); \
+        return NULL; \
+    } \
+    memcpy(dest->data, src->data, src->size * sizeof(type)); \
+    dest->size = src->size; \
+    return dest; \
+} \
+\
+bool ctls_sdyn_append_##suffix(struct ctls_SmallDynArray_##suffix* dynArr, type elem) \
+{ \
+    if (dynArr->size == dynArr->capacity && !ctls_sdyn_grow_##suffix(dynArr, 1)) \
+        return false; \
+    dynArr->data[dynArr->size++] = elem; \
+    return true; \
+} \
+\
+bool ctls_sdyn_insert_##suffix(struct ctls_SmallDynArray_##suffix* dynArr, type const* src, size_t pos, \
+    size_t srcLen) \
+{ \
+    if (srcLen > dynArr->capacity - dynArr->size && !ctls_sdyn_grow_##suffix(dynArr, srcLen)) \
+        return false; \
+    memmove(dynArr->data + pos + srcLen, dynArr->data + pos, (dynArr->size - pos) * sizeof(type)); \
+    memmove(dynArr->data + pos, src, srcLen * sizeof(type)); \
+    dynArr->size += srcLen; \
+    return true; \
+} \
+\
+bool ctls_sdyn_extend_##suffix(struct ctls_SmallDynArray_##suffix* dynArr, type const* src, size_t srcLen) \
+{ \
+    return ctls_sdyn_insert_##suffix(dynArr, src, dynArr->size, srcLen); \
+} \
+\
+void ctls_sdyn_remove_##suffix(struct ctls_SmallDynArray_##suffix* dynArr, size_t from, size_t to) \
+{ \
+    memmove(dynArr->data + from, dynArr->data + to, (dynArr->size - to) * sizeof(type)); \
+    dynArr->size -= (to - from); \
+}
+
+/**
+ * @brief a convenience function that calls both `CTLS_SMALL_DYN_ARRAY_DECL` and `CTLS_SMALL_DYN_ARRAY_DEF`.
+ * @param type the name of the type to be specialized for
+ * @param suffix a string appended to each declared identifier
+ * @param N the number of elements stored inline
+ *
+ * **Usage**
+ * @code
+ * CTLS_SMALL_DYN_ARRAY(int, int, 8)
+ * @endcode
+ */
+#define CTLS_SMALL_DYN_ARRAY(type, suffix, N) \
+CTLS_SMALL_DYN_ARRAY_DECL(type, suffix, N) \
+CTLS_SMALL_DYN_ARRAY_DEF(type, suffix, N)
+
+#endif
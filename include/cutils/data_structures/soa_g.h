@@ -0,0 +1,282 @@
+#ifndef CUTILS_DATA_STRUCTURES_SOA_G_H_10162026
+#define CUTILS_DATA_STRUCTURES_SOA_G_H_10162026
+
+/** @file
+ * @brief Contains a generator for struct-of-arrays containers.
+ *
+ * A specialization of `ctls_DynArray` for a struct stores whole structs one after another. A loop that reads only one
+ * or two of their members still pulls every other member through the cache. The containers generated by the macros in
+ * this file store each member, or column, in an array of its own instead. A loop over a column then reads nothing but
+ * that column, and compilers can vectorize it as they would a loop over a plain array.
+ *
+ * The members are given as an X-macro: a function-like macro that takes the name of another macro, and invokes it
+ * once per member with the member's type and name. Each generated container also comes with a row struct, which has
+ * the same members, and is used to add and read whole elements at a time.
+ *
+ * @code
+ * #define PARTICLE_FIELDS(X) \
+ *     X(float, x) \
+ *     X(float, y) \
+ *     X(float, vx) \
+ *     X(float, vy) \
+ *     X(uint32_t, id)
+ *
+ * CTLS_SOA(PARTICLE_FIELDS, particle)
+ *
+ * void step(struct ctls_Soa_particle* particles, float dt)
+ * {
+ *     for (size_t i = 0; i < particles->size; ++i)
+ *         particles->x[i] += particles->vx[i] * dt;
+ * }
+ *
+ * void spawn(struct ctls_Soa_particle* particles, uint32_t id)
+ * {
+ *     ctls_soa_append_particle(particles, (struct ctls_SoaRow_particle){.id = id});
+ * }
+ * @endcode
+ *
+ * All columns live in one block of memory, obtained from the container's allocator, and each starts at a multiple of
+ * `CTLS_SOA_ALIGNMENT` bytes. Every column has the same capacity, so the container grows all of them together, under
+ * the same growth policies as `ctls_DynArray`. Since the columns move relative to one another when the capacity
+ * changes, growing copies each column into a new block, rather than reallocating in place.
+ *
+ * The functions associated with a given container correspond to those of a specialization of `ctls_DynArray`:
+ *
+ * - `ctls_soa_init_##suffix(soa, initialCapacity)`, `ctls_soa_initWithAllocator_##suffix(soa, initialCapacity,
+ *     allocator)`, and `ctls_soa_defaultInit_##suffix(soa)` initialize an empty container. They return `NULL` on
+ *     failure, and, like `ctls_dyn_init`, allocate the container itself if `soa` is `NULL`.
+ * - `ctls_soa_reset_##suffix(soa)` frees the columns and zeroes the container's members out.
+ * - `ctls_soa_shrinkToFit_##suffix(soa)` reduces the capacity to the size.
+ * - `ctls_soa_append_##suffix(soa, row)`, `ctls_soa_insert_##suffix(soa, rows, pos, rowCount)`,
+ *     `ctls_soa_extend_##suffix(soa, rows, rowCount)`, and `ctls_soa_remove_##suffix(soa, from, to)` behave like their
+ *     `ctls_dyn_` counterparts, except that the elements are given as row structs and scattered across the columns.
+ * - `ctls_soa_get_##suffix(soa, i)` gathers the element at index `i` into a row struct, and
+ *     `ctls_soa_set_##suffix(soa, i, row)` scatters a row struct into the element at index `i`.
+ */
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "cutils/data_structures/dyn_growth.h"
+#include "cutils/memory/allocator.h"
+
+/** @brief The alignment of every column, in bytes; a cache line, and the width of the widest common vector registers */
+#define CTLS_SOA_ALIGNMENT 64
+#define CTLS_SOA_DEFAULT_INITIAL_CAPACITY 8
+
+/** @brief Rounds `n` up to a multiple of `CTLS_SOA_ALIGNMENT`. */
+static inline size_t ctls_soa_roundUp(size_t n)
+{
+    return (n + (CTLS_SOA_ALIGNMENT - 1)) & ~(size_t)(CTLS_SOA_ALIGNMENT - 1);
+}
+
+// The following X-macro callbacks expand one member of a field list. They refer to the local variables of the
+// functions they are expanded in.
+#define CTLS_SOA_ROW_MEMBER(type, name) type name;
+#define CTLS_SOA_COLUMN_MEMBER(type, name) type* name;
+#define CTLS_SOA_COLUMN_SIZE(type, name) blockSize += ctls_soa_roundUp(capacity * sizeof(type));
+#define CTLS_SOA_MOVE_COLUMN(type, name) \
+    { \
+        type* column = (type*)cursor; \
+        if (soa->size) \
+            memcpy(column, soa->name, soa->size * sizeof(type)); \
+        soa->name = column; \
+        cursor += ctls_soa_roundUp(newCapacity * sizeof(type)); \
+    }
+#define CTLS_SOA_MOVE_TAIL(type, name) memmove(soa->name + dest, soa->name + src, tailLen * sizeof(type));
+#define CTLS_SOA_SCATTER_ROWS(type, name) \
+    for (size_t i = 0; i < rowCount; ++i) \
+        soa->name[pos + i] = rows[i].name;
+#define CTLS_SOA_SCATTER_ROW(type, name) soa->name[i] = row.name;
+#define CTLS_SOA_GATHER_ROW(type, name) row.name = soa->name[i];
+
+/**
+ * @brief Creates declarations for a struct-of-arrays container.
+ * @param fields an X-macro listing the members of the container's elements
+ * @param suffix a string appended to each declared identifier
+ *
+ * The corresponding implementation is created via `CTLS_SOA_DEF`.
+ */
+#define CTLS_SOA_DECL(fields, suffix) \
+\
+struct ctls_SoaRow_##suffix \
+{ \
+    fields(CTLS_SOA_ROW_MEMBER) \
+}; \
+\
+struct ctls_Soa_##suffix \
+{ \
+    fields(CTLS_SOA_COLUMN_MEMBER) \
+    size_t size, capacity; \
+    const struct ctls_Allocator* allocator; \
+    enum ctls_DynGrowthPolicy growthPolicy; \
+    void* block; \
+    size_t blockSize; \
+}; \
+\
+struct ctls_Soa_##suffix* ctls_soa_init_##suffix(struct ctls_Soa_##suffix* soa, size_t initialCapacity); \
+struct ctls_Soa_##suffix* ctls_soa_initWithAllocator_##suffix(struct ctls_Soa_##suffix* soa, size_t initialCapacity, \
+    const struct ctls_Allocator* allocator); \
+struct ctls_Soa_##suffix* ctls_soa_defaultInit_##suffix(struct ctls_Soa_##suffix* soa); \
+void ctls_soa_reset_##suffix(struct ctls_Soa_##suffix* soa); \
+bool ctls_soa_shrinkToFit_##suffix(struct ctls_Soa_##suffix* soa); \
+bool ctls_soa_append_##suffix(struct ctls_Soa_##suffix* soa, struct ctls_SoaRow_##suffix row); \
+bool ctls_soa_insert_##suffix(struct ctls_Soa_##suffix* soa, const struct ctls_SoaRow_##suffix* rows, size_t pos, \
+    size_t rowCount); \
+bool ctls_soa_extend_##suffix(struct ctls_Soa_##suffix* soa, const struct ctls_SoaRow_##suffix* rows, \
+    size_t rowCount); \
+void ctls_soa_remove_##suffix(struct ctls_Soa_##suffix* soa, size_t from, size_t to); \
+struct ctls_SoaRow_##suffix ctls_soa_get_##suffix(const struct ctls_Soa_##suffix* soa, size_t i); \
+void ctls_soa_set_##suffix(struct ctls_Soa_##suffix* soa, size_t i, struct ctls_SoaRow_##suffix row);
+
+/**
+ * @brief Creates definitions for a struct-of-arrays container.
+ * @param fields an X-macro listing the members of the container's elements
+ * @param suffix a string appended to each declared identifier
+ *
+ * The corresponding declarations can, and should, be included via `CTLS_SOA_DECL`.
+ */
+#define CTLS_SOA_DEF(fields, suffix) \
+\
+/* Returns the size of a block that holds columns of `capacity` elements, including the slack needed to align the */ \
+/* first, or zero if the size cannot be represented. */ \
+static size_t ctls_soa_blockSize_##suffix(size_t capacity) \
+{ \
+    if (capacity > (SIZE_MAX / 2) / sizeof(struct ctls_SoaRow_##suffix)) \
+        return 0; \
+    size_t blockSize = CTLS_SOA_ALIGNMENT - 1; \
+    fields(CTLS_SOA_COLUMN_SIZE) \
+    return blockSize; \
+} \
+\
+static bool ctls_soa_reallocColumns_##suffix(struct ctls_Soa_##suffix* soa, size_t newCapacity) \
+{ \
+    size_t newBlockSize = ctls_soa_blockSize_##suffix(newCapacity); \
+    char* newBlock = newBlockSize ? ctls_allocate(soa->allocator, newBlockSize) : NULL; \
+    if (!newBlock) \
+        return false; \
+    char* cursor = (char*)(((uintptr_t)newBlock + (CTLS_SOA_ALIGNMENT - 1)) \
+        & ~(uintptr_t)(CTLS_SOA_ALIGNMENT - 1)); \
+    fields(CTLS_SOA_MOVE_COLUMN) \
+    if (soa->block) \
+        ctls_deallocate(soa->allocator, soa->block, soa->blockSize); \
+    soa->block = newBlock, soa->blockSize = newBlockSize, soa->capacity = newCapacity; \
+    return true; \
+} \
+\
+static bool ctls_soa_grow_##suffix(struct ctls_Soa_##suffix* soa, size_t rowCount) \
+{ \
+    if (rowCount > SIZE_MAX - soa->size) \
+        return false; \
+    size_t newCapacity = ctls_dyn_grownCapacity(soa->growthPolicy, soa->capacity, soa->size + rowCount, \
+        sizeof(struct ctls_SoaRow_##suffix)); \
+    return newCapacity && ctls_soa_reallocColumns_##suffix(soa, newCapacity); \
+} \
+\
+struct ctls_Soa_##suffix* ctls_soa_initWithAllocator_##suffix(struct ctls_Soa_##suffix* soa, size_t initialCapacity, \
+    const struct ctls_Allocator* allocator) \
+{ \
+    bool soaOriginallyNull = !soa; \
+    if (soaOriginallyNull) \
+        soa = malloc(sizeof *soa); \
+    if (soa) \
+    { \
+        memset(soa, 0, sizeof *soa); \
+        soa->allocator = allocator, soa->growthPolicy = CTLS_DYN_GROWTH_GOLDEN; \
+        if (!ctls_soa_reallocColumns_##suffix(soa, initialCapacity)) \
+        { \
+            if (soaOriginallyNull) \
+                free(soa); \
+            soa = NULL; \
+        } \
+    } \
+    return soa; \
+} \
+\
+struct ctls_Soa_##suffix* ctls_soa_init_##suffix(struct ctls_Soa_##suffix* soa, size_t initialCapacity) \
+{ \
+    return ctls_soa_initWithAllocator_##suffix(soa, initialCapacity, NULL); \
+} \
+\
+struct ctls_Soa_##suffix* ctls_soa_defaultInit_##suffix(struct ctls_Soa_##suffix* soa) \
+{ \
+    return ctls_soa_init_##suffix(soa, CTLS_SOA_DEFAULT_INITIAL_CAPACITY); \
+} \
+\
+void ctls_soa_reset_##suffix(struct ctls_Soa_##suffix* soa) \
+{ \
+    ctls_deallocate(soa->allocator, soa->block, soa->blockSize); \
+    memset(soa, 0, sizeof *soa); \
+} \
+\
+bool ctls_soa_shrinkToFit_##suffix(struct ctls_Soa_##suffix* soa) \
+{ \
+    return !soa->size || soa->size == soa->capacity || ctls_soa_reallocColumns_##suffix(soa, soa->size); \
+} \
+\
+bool ctls_soa_append_##suffix(struct ctls_Soa_##suffix* soa, struct ctls_SoaRow_##suffix row) \
+{ \
+    if (soa->size == soa->capacity && !ctls_soa_grow_##suffix(soa, 1)) \
+        return false; \
+    size_t i = soa->size++; \
+    fields(CTLS_SOA_SCATTER_ROW) \
+    return true; \
+} \
+\
+bool ctls_soa_insert_##suffix(struct ctls_Soa_##suffix* soa, const struct ctls_SoaRow_##suffix* rows, size_t pos, \
+    size_t rowCount) \
+{ \
+    if (rowCount > soa->capacity - soa->size && !ctls_soa_grow_##suffix(soa, rowCount)) \
+        return false; \
+    size_t dest = pos + rowCount, src = pos, tailLen = soa->size - pos; \
+    fields(CTLS_SOA_MOVE_TAIL) \
+    fields(CTLS_SOA_SCATTER_ROWS) \
+    soa->size += rowCount; \
+    return true; \
+} \
+\
+bool ctls_soa_extend_##suffix(struct ctls_Soa_##suffix* soa, const struct ctls_SoaRow_##suffix* rows, \
+    size_t rowCount) \
+{ \
+    return ctls_soa_insert_##suffix(soa, rows, soa->size, rowCount); \
+} \
+\
+void ctls_soa_remove_##suffix(struct ctls_Soa_##suffix* soa, size_t from, size_t to) \
+{ \
+    size_t dest = from, src = to, tailLen = soa->size - to; \
+    fields(CTLS_SOA_MOVE_TAIL) \
+    soa->size -= to - from; \
+} \
+\
+struct ctls_SoaRow_##suffix ctls_soa_get_##suffix(const struct ctls_Soa_##suffix* soa, size_t i) \
+{ \
+    struct ctls_SoaRow_##suffix row; \
+    fields(CTLS_SOA_GATHER_ROW) \
+    return row; \
+} \
+\
+void ctls_soa_set_##suffix(struct ctls_Soa_##suffix* soa, size_t i, struct ctls_SoaRow_##suffix row) \
+{ \
+    fields(CTLS_SOA_SCATTER_ROW) \
+}
+
+/**
+ * @brief a convenience function that calls both `CTLS_SOA_DECL` and `CTLS_SOA_DEF`.
+ * @param fields an X-macro listing the members of the container's elements
+ * @param suffix a string appended to each declared identifier
+ *
+ * **Usage**
+ * @code
+ * #define POINT_FIELDS(X) X(double, x) X(double, y)
+ *
+ * CTLS_SOA(POINT_FIELDS, point)
+ * @endcode
+ */
+#define CTLS_SOA(fields, suffix) \
+CTLS_SOA_DECL(fields, suffix) \
+CTLS_SOA_DEF(fields, suffix)
+
+#endif
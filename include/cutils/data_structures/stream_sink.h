@@ -0,0 +1,136 @@
+#ifndef CUTILS_DATA_STRUCTURES_STREAM_SINK_H_10162026
+#define CUTILS_DATA_STRUCTURES_STREAM_SINK_H_10162026
+
+/** @file
+ * @brief Contains a double-buffered sink that streams the elements appended to it into a file.
+ *
+ * A `ctls_StreamSink` owns two `ctls_DynArray` buffers of equal capacity and a background thread. The producer appends
+ * elements to the active buffer. Once it is full, the buffer is handed to the background thread, which writes it to
+ * the file with `pwrite` and empties it, while the producer carries on appending to the other buffer. The producer
+ * therefore only waits for the disk if it fills a buffer before the previous one has been written, which applies
+ * backpressure instead of letting memory grow without bound. `ctls_StreamSink::stalls` counts how often that happened.
+ *
+ * @code
+ * struct ctls_StreamSink sink;
+ * if (!ctls_sink_open(&sink, "telemetry.bin", sizeof(struct Record), 1 << 16, false))
+ *     return false;
+ * while (running)
+ *     ctls_sink_append(&sink, &(struct Record){now(), readSensor()});
+ * return ctls_sink_close(&sink);
+ * @endcode
+ *
+ * Elements are written as raw bytes, in the order they were appended, without a header. The capacity of the buffers
+ * bounds both the memory used and the size of each write; larger buffers mean fewer, larger writes, but a longer wait
+ * whenever the producer does stall.
+ *
+ * A durable sink opens its file with `O_DSYNC`, so each write returns only once its elements have reached the disk.
+ * This is where the background thread pays off most, since the producer keeps appending while the thread waits for the
+ * disk, even on a single core.
+ *
+ * Only one thread may act on a sink at a time, apart from its own background thread; producers that share a sink need
+ * a lock of their own. Once a write has failed, every later call to a function declared in this file reports the
+ * error, and elements appended from then on are discarded. This file requires a POSIX system.
+ */
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#include "cutils/data_structures/dyn_array.h"
+
+/** @brief A double-buffered sink that writes elements to a file from a background thread. */
+struct ctls_StreamSink
+{
+    /** @brief the two buffers, one of which is `ctls_StreamSink::active` */
+    struct ctls_DynArray buffers[2];
+    /** @brief the buffer the producer appends to */
+    struct ctls_DynArray* active;
+    /** @brief the buffer being written by the background thread, or `NULL` if there is none */
+    struct ctls_DynArray* pending;
+    /** @brief size of one element */
+    size_t elemSize;
+    /** @brief the file the elements are written to */
+    int fd;
+    /** @brief number of bytes written to the file so far; only up to date after `ctls_sink_flush()` */
+    uint64_t written;
+    /** @brief number of times the producer had to wait for the background thread to finish writing */
+    size_t stalls;
+    /** @brief whether a write has failed; atomic so that the producer can check it without locking the mutex */
+    atomic_bool failed;
+    /** @brief whether the background thread is to exit once `ctls_StreamSink::pending` has been written */
+    bool stopping;
+    /** @brief the background thread */
+    pthread_t thread;
+    /** @brief guards `ctls_StreamSink::pending`, `ctls_StreamSink::written`, and `ctls_StreamSink::stopping` */
+    pthread_mutex_t mutex;
+    /** @brief signaled when a buffer is handed to the background thread, or it is to stop */
+    pthread_cond_t bufferReady;
+    /** @brief signaled when the background thread has finished writing a buffer */
+    pthread_cond_t bufferFree;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Initialization and Cleanup
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Opens a sink that writes to a file, and starts its background thread.
+ * @param sink pointer to an uninitialized sink, or `NULL`
+ * @param path path of the file that is to be written; an existing file is truncated
+ * @param elemSize size of one element; must be nonzero
+ * @param bufferCapacity number of elements each of the two buffers holds; must be nonzero
+ * @param durable whether each buffer must reach the disk before the background thread moves on to the next one
+ * @return On success, returns a dynamically allocated sink if `sink` was originally `NULL`, `sink` otherwise. On
+ *     failure, returns `NULL`.
+ */
+struct ctls_StreamSink* ctls_sink_open(struct ctls_StreamSink* sink, const char* path, size_t elemSize,
+    size_t bufferCapacity, bool durable);
+
+/**
+ * @brief Writes any remaining elements, stops the background thread, closes the file, and zeroes the sink out.
+ * @param sink pointer to an open sink
+ * @return `true` if every element appended was written and the file was closed without error, `false` if not. Either
+ *     way, `sink` is zeroed out.
+ *
+ * Unless the sink is durable, does not wait for the file to reach the disk. A sink allocated by `ctls_sink_open()`
+ * must still be freed with `free`.
+ */
+bool ctls_sink_close(struct ctls_StreamSink* sink);
+
+/**
+ * @brief Hands the active buffer to the background thread, and waits until every element appended so far is written.
+ * @param sink pointer to an open sink
+ * @return `true` if every element appended so far was written, `false` if not
+ */
+bool ctls_sink_flush(struct ctls_StreamSink* sink);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Mutators
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Adds an element to the end of a sink's stream.
+ * @param sink pointer to an open sink
+ * @param elem pointer to the element that is to be added
+ * @return `false` if a write has failed, in which case `elem` is discarded, `true` otherwise
+ *
+ * If the active buffer is full, it is handed to the background thread first, which may require waiting for the
+ * previous buffer to be written.
+ */
+bool ctls_sink_append(struct ctls_StreamSink* restrict sink, const void* restrict elem);
+
+/**
+ * @brief Adds `srcLen` elements to the end of a sink's stream.
+ * @param sink pointer to an open sink
+ * @param src pointer to the elements that are to be added
+ * @param srcLen number of elements that are to be added
+ * @return `false` if a write has failed, in which case the elements are discarded, `true` otherwise
+ *
+ * Any number of elements may be added at once. They are copied into the buffers a buffer at a time, handing each one
+ * to the background thread as it fills up.
+ */
+bool ctls_sink_extend(struct ctls_StreamSink* restrict sink, const void* restrict src, size_t srcLen);
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef CUTILS_MEMORY_ALIGNED_H_10162026
+#define CUTILS_MEMORY_ALIGNED_H_10162026
+
+/** @file
+ * @brief Contains allocators that guarantee a given alignment, and one that backs large blocks with huge pages.
+ *
+ * `malloc` only aligns blocks for the most demanding scalar type, typically to 16 bytes. The allocators returned by
+ * `ctls_alignedAllocator()` align every block, including those returned when a block is resized, to any power of two
+ * up to `CTLS_MAX_ALIGNMENT`, such as the 64 bytes of a cache line or of an AVX-512 register. They are stateless and
+ * live for the whole program, so they can be attached to any number of containers.
+ *
+ * `ctls_hugePageAllocator` aligns smaller blocks to 64 bytes, but maps blocks of at least `CTLS_HUGE_PAGE_SIZE` bytes
+ * directly from the operating system, aligned to and rounded up to a multiple of `CTLS_HUGE_PAGE_SIZE`, and asks for
+ * them to be backed by transparent huge pages. A single TLB entry then covers 2 MiB rather than 4 KiB, which greatly
+ * reduces TLB misses when a large array is accessed at random. Whether the request is honored depends on the system's
+ * configuration; on Linux, transparent huge pages must be enabled in either `always` or `madvise` mode. On systems
+ * without `mmap`, large blocks are merely aligned.
+ *
+ * @code
+ * struct ctls_DynArray samples;
+ * ctls_dyn_initWithAllocator(&samples, 1 << 28, sizeof(double), &ctls_hugePageAllocator);
+ * @endcode
+ */
+
+#include <stddef.h>
+
+#include "cutils/memory/allocator.h"
+
+/** @brief The largest alignment `ctls_alignedAllocator()` supports, in bytes */
+#define CTLS_MAX_ALIGNMENT 4096
+/** @brief The size of a huge page, and the size from which `ctls_hugePageAllocator` maps blocks from the system */
+#define CTLS_HUGE_PAGE_SIZE ((size_t)2 << 20)
+
+/**
+ * @brief Returns an allocator whose blocks are aligned to a given boundary.
+ * @param alignment the alignment, in bytes. Must be a power of two no greater than `CTLS_MAX_ALIGNMENT`.
+ * @return a pointer to an allocator with static storage duration, or `NULL` if `alignment` is not supported
+ *
+ * Alignments smaller than that of `max_align_t` are raised to it.
+ */
+const struct ctls_Allocator* ctls_alignedAllocator(size_t alignment);
+
+/** @brief An allocator that backs blocks of at least `CTLS_HUGE_PAGE_SIZE` bytes with transparent huge pages. */
+extern const struct ctls_Allocator ctls_hugePageAllocator;
+
+#endif
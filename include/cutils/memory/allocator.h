@@ -0,0 +1,84 @@
+#ifndef CUTILS_MEMORY_ALLOCATOR_H_10162026
+#define CUTILS_MEMORY_ALLOCATOR_H_10162026
+
+/** @file
+ * @brief Contains a pluggable allocator interface.
+ *
+ * A `ctls_Allocator` is a table of function pointers and an opaque state pointer. Containers that accept an allocator
+ * route every allocation, reallocation, and deallocation of their storage through it. A null allocator pointer always
+ * denotes the standard library allocator (`malloc`, `realloc`, and `free`), so a zeroed-out container still behaves
+ * as it did before allocators were introduced.
+ *
+ * Unlike `realloc` and `free`, `ctls_Allocator::reallocate` and `ctls_Allocator::deallocate` are told the size of the
+ * block they act on. This lets allocators such as those declared in cutils/memory/arena.h, cutils/memory/pool.h, and
+ * cutils/memory/bump.h avoid storing a header in front of every block.
+ */
+
+#include <stddef.h>
+#include <stdlib.h>
+
+/** @brief A table of allocation functions. */
+struct ctls_Allocator
+{
+    /**
+     * @brief Allocates a block of at least `size` bytes, suitably aligned for any object type.
+     *
+     * Returns `NULL` on failure.
+     */
+    void* (*allocate)(void* state, size_t size);
+    /**
+     * @brief Resizes `block` from `oldSize` to `newSize` bytes, preserving the first `min(oldSize, newSize)` bytes.
+     *
+     * If `block` is `NULL`, behaves like `ctls_Allocator::allocate`. Returns `NULL` on failure, in which case `block`
+     * is left untouched.
+     */
+    void* (*reallocate)(void* state, void* block, size_t oldSize, size_t newSize);
+    /** @brief Releases `block`, which is `size` bytes wide. Does nothing if `block` is `NULL`. */
+    void (*deallocate)(void* state, void* block, size_t size);
+    /** @brief passed as the first argument to each of the above functions */
+    void* state;
+};
+
+/** @brief An allocator that forwards to `malloc`, `realloc`, and `free`. Equivalent to a null allocator pointer. */
+extern const struct ctls_Allocator ctls_mallocAllocator;
+
+/**
+ * @brief Allocates memory through an allocator.
+ * @param allocator pointer to an allocator, or `NULL` for the standard library allocator
+ * @param size number of bytes to allocate
+ * @return a pointer to the allocated block on success, `NULL` on failure
+ */
+static inline void* ctls_allocate(const struct ctls_Allocator* allocator, size_t size)
+{
+    return allocator ? allocator->allocate(allocator->state, size) : malloc(size);
+}
+
+/**
+ * @brief Resizes memory through an allocator.
+ * @param allocator pointer to an allocator, or `NULL` for the standard library allocator
+ * @param block pointer to a block obtained from `allocator`, or `NULL`
+ * @param oldSize size of `block` in bytes; ignored if `block` is `NULL`
+ * @param newSize requested size in bytes
+ * @return a pointer to the resized block on success, `NULL` on failure
+ */
+static inline void* ctls_reallocate(const struct ctls_Allocator* allocator, void* block, size_t oldSize,
+    size_t newSize)
+{
+    return allocator ? allocator->reallocate(allocator->state, block, oldSize, newSize) : realloc(block, newSize);
+}
+
+/**
+ * @brief Frees memory through an allocator.
+ * @param allocator pointer to an allocator, or `NULL` for the standard library allocator
+ * @param block pointer to a block obtained from `allocator`, or `NULL`
+ * @param size size of `block` in bytes
+ */
+static inline void ctls_deallocate(const struct ctls_Allocator* allocator, void* block, size_t size)
+{
+    if (allocator)
+        allocator->deallocate(allocator->state, block, size);
+    else
+        free(block);
+}
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef CUTILS_MEMORY_ARENA_H_10162026
+#define CUTILS_MEMORY_ARENA_H_10162026
+
+/** @file
+ * @brief Contains an arena allocator.
+ *
+ * An arena hands out memory from a list of large chunks by advancing a cursor. Individual deallocations are free, and
+ * only reclaim memory if they release the most recent allocation. All of an arena's allocations are released at once
+ * by `ctls_arena_rewind()`, which takes constant time and keeps the chunks for reuse, or by `ctls_arena_reset()`,
+ * which returns the chunks to the system.
+ *
+ * `ctls_Arena::allocator` can be passed to any function that accepts a `ctls_Allocator`. Since its state points to the
+ * arena itself, an arena must not be moved after it has been initialized.
+ */
+
+#include <stddef.h>
+
+#include "cutils/memory/allocator.h"
+
+/** @brief The chunk size used by `ctls_arena_defaultInit()`. */
+#define CTLS_ARENA_DEFAULT_CHUNK_SIZE 65536
+
+struct ctls_ArenaChunk;
+
+/** @brief An arena allocator. */
+struct ctls_Arena
+{
+    /** @brief an allocator that allocates from this arena */
+    struct ctls_Allocator allocator;
+    /** @brief the first chunk in this arena's chunk list */
+    struct ctls_ArenaChunk* first;
+    /** @brief the chunk currently being allocated from */
+    struct ctls_ArenaChunk* current;
+    /** @brief number of bytes of the current chunk that are in use */
+    size_t used;
+    /** @brief offset of the most recent allocation within the current chunk */
+    size_t lastOffset;
+    /** @brief minimum size of a newly allocated chunk */
+    size_t chunkSize;
+};
+
+/**
+ * @brief Initializes an arena.
+ * @param arena pointer to an uninitialized arena, or `NULL`
+ * @param chunkSize minimum size of each chunk, in bytes; must be nonzero
+ * @return On success, returns a dynamically allocated arena if `arena` was originally `NULL`, `arena` otherwise. On
+ *     failure, returns `NULL`.
+ *
+ * The first chunk is allocated immediately. Allocations larger than `chunkSize` receive a chunk of their own.
+ */
+struct ctls_Arena* ctls_arena_init(struct ctls_Arena* arena, size_t chunkSize);
+
+/**
+ * @brief Initializes an arena with a chunk size of `CTLS_ARENA_DEFAULT_CHUNK_SIZE`.
+ * @param arena pointer to an uninitialized arena, or `NULL`
+ * @return On success, returns a dynamically allocated arena if `arena` was originally `NULL`, `arena` otherwise. On
+ *     failure, returns `NULL`.
+ */
+struct ctls_Arena* ctls_arena_defaultInit(struct ctls_Arena* arena);
+
+/**
+ * @brief Frees every chunk held by an arena and zeroes its members out.
+ * @param arena pointer to an initialized arena
+ */
+void ctls_arena_reset(struct ctls_Arena* arena);
+
+/**
+ * @brief Releases every allocation made from an arena in constant time.
+ * @param arena pointer to an initialized arena
+ *
+ * The arena's chunks are retained and reused by subsequent allocations.
+ */
+void ctls_arena_rewind(struct ctls_Arena* arena);
+
+/**
+ * @brief Allocates memory from an arena.
+ * @param arena pointer to an initialized arena
+ * @param size number of bytes to allocate
+ * @return a pointer to a block suitably aligned for any object type on success, `NULL` on failure
+ */
+void* ctls_arena_allocate(struct ctls_Arena* arena, size_t size);
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef CUTILS_MEMORY_BUMP_H_10162026
+#define CUTILS_MEMORY_BUMP_H_10162026
+
+/** @file
+ * @brief Contains a bump allocator over a caller-supplied buffer.
+ *
+ * A bump allocator never calls into the system. It carves allocations out of a single buffer owned by the caller,
+ * which may for instance live on the stack, and fails once the buffer is exhausted. Deallocating or resizing the most
+ * recent allocation is done in place; every other deallocation is a no-op. `ctls_bump_rewind()` releases all
+ * allocations in constant time.
+ *
+ * `ctls_Bump::allocator` can be passed to any function that accepts a `ctls_Allocator`. Since its state points to the
+ * bump allocator itself, a bump allocator must not be moved after it has been initialized.
+ */
+
+#include <stddef.h>
+
+#include "cutils/memory/allocator.h"
+
+/** @brief A bump allocator. */
+struct ctls_Bump
+{
+    /** @brief an allocator that allocates from this bump allocator's buffer */
+    struct ctls_Allocator allocator;
+    /** @brief the first suitably aligned byte of the buffer */
+    unsigned char* buffer;
+    /** @brief number of usable bytes in `ctls_Bump::buffer` */
+    size_t capacity;
+    /** @brief number of bytes of `ctls_Bump::buffer` that are in use */
+    size_t used;
+    /** @brief offset of the most recent allocation within `ctls_Bump::buffer` */
+    size_t lastOffset;
+};
+
+/**
+ * @brief Initializes a bump allocator.
+ * @param bump pointer to an uninitialized bump allocator
+ * @param buffer memory to allocate from; must outlive every allocation made from `bump`
+ * @param size size of `buffer`, in bytes
+ * @return `bump`
+ *
+ * Bytes at the start of `buffer` that precede the first suitably aligned address are not used.
+ */
+struct ctls_Bump* ctls_bump_init(struct ctls_Bump* bump, void* buffer, size_t size);
+
+/**
+ * @brief Releases every allocation made from a bump allocator in constant time.
+ * @param bump pointer to an initialized bump allocator
+ */
+void ctls_bump_rewind(struct ctls_Bump* bump);
+
+/**
+ * @brief Allocates memory from a bump allocator.
+ * @param bump pointer to an initialized bump allocator
+ * @param size number of bytes to allocate
+ * @return a pointer to a block suitably aligned for any object type on success, `NULL` if the buffer is exhausted
+ */
+void* ctls_bump_allocate(struct ctls_Bump* bump, size_t size);
+
+#endif
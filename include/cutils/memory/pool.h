@@ -0,0 +1,82 @@
+#ifndef CUTILS_MEMORY_POOL_H_10162026
+#define CUTILS_MEMORY_POOL_H_10162026
+
+/** @file
+ * @brief Contains a fixed-size pool allocator.
+ *
+ * A pool hands out blocks of a single size. Freed blocks are kept on a free list and reused by later allocations, so
+ * both allocation and deallocation take constant time. Requests larger than the pool's block size fail. Reallocations
+ * within the block size succeed in place, which makes a pool a good fit for many small dynamic arrays whose capacity
+ * is known to stay below a fixed bound.
+ *
+ * `ctls_Pool::allocator` can be passed to any function that accepts a `ctls_Allocator`. Since its state points to the
+ * pool itself, a pool must not be moved after it has been initialized.
+ */
+
+#include <stddef.h>
+
+#include "cutils/memory/allocator.h"
+
+struct ctls_PoolChunk;
+
+/** @brief A fixed-size pool allocator. */
+struct ctls_Pool
+{
+    /** @brief an allocator that allocates from this pool */
+    struct ctls_Allocator allocator;
+    /** @brief the first chunk in this pool's chunk list */
+    struct ctls_PoolChunk* first;
+    /** @brief the chunk that fresh blocks are currently being carved from */
+    struct ctls_PoolChunk* current;
+    /** @brief number of blocks of the current chunk that have been carved */
+    size_t used;
+    /** @brief singly linked list of freed blocks */
+    void* freeList;
+    /** @brief size of each block, in bytes */
+    size_t blockSize;
+    /** @brief number of blocks in each chunk */
+    size_t blocksPerChunk;
+};
+
+/**
+ * @brief Initializes a pool.
+ * @param pool pointer to an uninitialized pool, or `NULL`
+ * @param blockSize size of each block, in bytes; must be nonzero
+ * @param blocksPerChunk number of blocks obtained from the system at a time; must be nonzero
+ * @return On success, returns a dynamically allocated pool if `pool` was originally `NULL`, `pool` otherwise. On
+ *     failure, returns `NULL`.
+ *
+ * `blockSize` is rounded up so that every block is suitably aligned for any object type. The first chunk is
+ * allocated immediately.
+ */
+struct ctls_Pool* ctls_pool_init(struct ctls_Pool* pool, size_t blockSize, size_t blocksPerChunk);
+
+/**
+ * @brief Frees every chunk held by a pool and zeroes its members out.
+ * @param pool pointer to an initialized pool
+ */
+void ctls_pool_reset(struct ctls_Pool* pool);
+
+/**
+ * @brief Releases every block allocated from a pool in constant time.
+ * @param pool pointer to an initialized pool
+ *
+ * The pool's chunks are retained and reused by subsequent allocations.
+ */
+void ctls_pool_rewind(struct ctls_Pool* pool);
+
+/**
+ * @brief Allocates a block from a pool.
+ * @param pool pointer to an initialized pool
+ * @return a pointer to a block of `pool->blockSize` bytes on success, `NULL` on failure
+ */
+void* ctls_pool_allocate(struct ctls_Pool* pool);
+
+/**
+ * @brief Returns a block to a pool.
+ * @param pool pointer to an initialized pool
+ * @param block pointer to a block allocated from `pool`, or `NULL`
+ */
+void ctls_pool_deallocate(struct ctls_Pool* pool, void* block);
+
+#endif
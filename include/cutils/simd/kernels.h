@@ -0,0 +1,127 @@
+#ifndef CUTILS_SIMD_KERNELS_H_10162026
+#define CUTILS_SIMD_KERNELS_H_10162026
+
+/** @file
+ * @brief Contains vectorized search, fill, and reduction kernels over contiguous arrays.
+ *
+ * Each kernel exists for `int32_t`, `int64_t`, `float`, and `double` elements, identified by the suffixes `i32`,
+ * `i64`, `f32`, and `f64`. On x86 processors, every call is dispatched at runtime to an SSE2 or AVX2 implementation,
+ * depending on what the processor supports; on other processors, a scalar implementation is used. The dispatch level
+ * is detected on first use, and can be inspected and lowered with `ctls_simd_level()` and `ctls_simd_setLevel()`.
+ *
+ * The following hold for every kernel:
+ * - `data` may be unaligned.
+ * - Elements are compared with `==`, so a NaN is never found, and `-0.0` and `0.0` compare equal.
+ * - The order in which floating-point elements are added is unspecified, so `ctls_simd_sum_f32()`,
+ *     `ctls_simd_sumWide_f32()`, and `ctls_simd_sum_f64()` may differ from a sequential sum in the last few bits.
+ * - The results of `ctls_simd_min_*()` and `ctls_simd_max_*()` are unspecified if `data` contains a NaN.
+ * - Integer sums wrap around on overflow.
+ *
+ * The bitwise kernels, identified by the suffix `u64`, operate on arrays of 64-bit words, such as the words of a
+ * `ctls_BitArray`. On processors with AVX2, `ctls_simd_popcount_u64()` counts the bits of four words at a time with
+ * byte-wise table lookups, and falls back on the `POPCNT` instruction for the remaining words. A `dest` and a `src` may
+ * be the same array, but must not otherwise overlap.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/** @brief Instruction set levels a kernel can be dispatched to. */
+enum ctls_SimdLevel
+{
+    /** @brief plain C loops */
+    CTLS_SIMD_SCALAR,
+    /** @brief 128-bit SSE2 vectors */
+    CTLS_SIMD_SSE2,
+    /** @brief 256-bit AVX2 vectors */
+    CTLS_SIMD_AVX2
+};
+
+/** @brief Returns the level kernels are currently dispatched to. */
+enum ctls_SimdLevel ctls_simd_level(void);
+
+/**
+ * @brief Sets the level kernels are dispatched to.
+ * @param level the requested level
+ * @return the level actually used, which is the lower of `level` and the highest level supported by the processor
+ *
+ * Mainly useful for benchmarking and testing the lower levels on a processor that supports higher ones.
+ */
+enum ctls_SimdLevel ctls_simd_setLevel(enum ctls_SimdLevel level);
+
+/**
+ * @brief Returns `true` if the first `size` bytes of `a` and `b` are equal.
+ *
+ * Equivalent to `memcmp(a, b, size) == 0`, which the C library already vectorizes.
+ */
+bool ctls_simd_equal(const void* a, const void* b, size_t size);
+
+/** @brief Returns the index of the first element of `data` equal to `value`, or `n` if there is none. */
+size_t ctls_simd_find_i32(const int32_t* data, size_t n, int32_t value);
+/** @brief Returns the number of elements of `data` equal to `value`. */
+size_t ctls_simd_count_i32(const int32_t* data, size_t n, int32_t value);
+/** @brief Assigns `value` to each of the `n` elements of `data`. */
+void ctls_simd_fill_i32(int32_t* data, size_t n, int32_t value);
+/** @brief Returns the sum of the `n` elements of `data`, computed in 64-bit arithmetic. */
+int64_t ctls_simd_sum_i32(const int32_t* data, size_t n);
+/** @brief Returns the smallest of the `n` elements of `data`. `n` must be nonzero. */
+int32_t ctls_simd_min_i32(const int32_t* data, size_t n);
+/** @brief Returns the largest of the `n` elements of `data`. `n` must be nonzero. */
+int32_t ctls_simd_max_i32(const int32_t* data, size_t n);
+
+/** @brief Returns the index of the first element of `data` equal to `value`, or `n` if there is none. */
+size_t ctls_simd_find_i64(const int64_t* data, size_t n, int64_t value);
+/** @brief Returns the number of elements of `data` equal to `value`. */
+size_t ctls_simd_count_i64(const int64_t* data, size_t n, int64_t value);
+/** @brief Assigns `value` to each of the `n` elements of `data`. */
+void ctls_simd_fill_i64(int64_t* data, size_t n, int64_t value);
+/** @brief Returns the sum of the `n` elements of `data`. */
+int64_t ctls_simd_sum_i64(const int64_t* data, size_t n);
+/** @brief Returns the smallest of the `n` elements of `data`. `n` must be nonzero. */
+int64_t ctls_simd_min_i64(const int64_t* data, size_t n);
+/** @brief Returns the largest of the `n` elements of `data`. `n` must be nonzero. */
+int64_t ctls_simd_max_i64(const int64_t* data, size_t n);
+
+/** @brief Returns the index of the first element of `data` equal to `value`, or `n` if there is none. */
+size_t ctls_simd_find_f32(const float* data, size_t n, float value);
+/** @brief Returns the number of elements of `data` equal to `value`. */
+size_t ctls_simd_count_f32(const float* data, size_t n, float value);
+/** @brief Assigns `value` to each of the `n` elements of `data`. */
+void ctls_simd_fill_f32(float* data, size_t n, float value);
+/** @brief Returns the sum of the `n` elements of `data`. */
+float ctls_simd_sum_f32(const float* data, size_t n);
+/** @brief Returns the sum of the `n` elements of `data`, computed in double precision. */
+double ctls_simd_sumWide_f32(const float* data, size_t n);
+/** @brief Returns the smallest of the `n` elements of `data`. `n` must be nonzero. */
+float ctls_simd_min_f32(const float* data, size_t n);
+/** @brief Returns the largest of the `n` elements of `data`. `n` must be nonzero. */
+float ctls_simd_max_f32(const float* data, size_t n);
+
+/** @brief Returns the index of the first element of `data` equal to `value`, or `n` if there is none. */
+size_t ctls_simd_find_f64(const double* data, size_t n, double value);
+/** @brief Returns the number of elements of `data` equal to `value`. */
+size_t ctls_simd_count_f64(const double* data, size_t n, double value);
+/** @brief Assigns `value` to each of the `n` elements of `data`. */
+void ctls_simd_fill_f64(double* data, size_t n, double value);
+/** @brief Returns the sum of the `n` elements of `data`. */
+double ctls_simd_sum_f64(const double* data, size_t n);
+/** @brief Returns the smallest of the `n` elements of `data`. `n` must be nonzero. */
+double ctls_simd_min_f64(const double* data, size_t n);
+/** @brief Returns the largest of the `n` elements of `data`. `n` must be nonzero. */
+double ctls_simd_max_f64(const double* data, size_t n);
+
+/** @brief Returns the number of set bits in the `n` words of `data`. */
+size_t ctls_simd_popcount_u64(const uint64_t* data, size_t n);
+/** @brief Returns the index of the first nonzero word of `data`, or `n` if there is none. */
+size_t ctls_simd_findNonzero_u64(const uint64_t* data, size_t n);
+/** @brief Assigns `dest[i] & src[i]` to each of the `n` words of `dest`. */
+void ctls_simd_and_u64(uint64_t* dest, const uint64_t* src, size_t n);
+/** @brief Assigns `dest[i] | src[i]` to each of the `n` words of `dest`. */
+void ctls_simd_or_u64(uint64_t* dest, const uint64_t* src, size_t n);
+/** @brief Assigns `dest[i] ^ src[i]` to each of the `n` words of `dest`. */
+void ctls_simd_xor_u64(uint64_t* dest, const uint64_t* src, size_t n);
+/** @brief Assigns `dest[i] & ~src[i]` to each of the `n` words of `dest`. */
+void ctls_simd_andNot_u64(uint64_t* dest, const uint64_t* src, size_t n);
+
+#endif
@@ -0,0 +1,250 @@
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "cutils/data_structures/bit_array.h"
+#include "cutils/data_structures/dyn_growth.h"
+#include "cutils/memory/allocator.h"
+#include "cutils/simd/kernels.h"
+
+#define DEFAULT_INITIAL_CAPACITY 64
+#define WORD_BITS CTLS_BIT_WORD_BITS
+
+static size_t wordCount(size_t bits)
+{
+    return bits / WORD_BITS + (bits % WORD_BITS != 0);
+}
+
+// Returns a word whose lowest `len` bits are set, for `len` between 1 and `WORD_BITS`.
+static uint64_t lowMask(size_t len)
+{
+    return len < WORD_BITS ? ((uint64_t)1 << len) - 1 : UINT64_MAX;
+}
+
+static size_t countTrailingZeros(uint64_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (size_t)__builtin_ctzll(word);
+#else
+    size_t count = 0;
+    for (; !(word & 1); word >>= 1)
+        ++count;
+    return count;
+#endif
+}
+
+// Reallocates `bitArr->words` to `newWords` words, and zeroes those that are new, so that every bit at or beyond
+// `bitArr->size` stays zero.
+static bool reallocWords(struct ctls_BitArray* bitArr, size_t newWords)
+{
+    size_t oldWords = bitArr->capacity / WORD_BITS;
+    uint64_t* words = ctls_reallocate(bitArr->allocator, bitArr->words, oldWords * sizeof(uint64_t),
+        newWords * sizeof(uint64_t));
+    if (!words)
+        return false;
+    if (newWords > oldWords)
+        memset(words + oldWords, 0, (newWords - oldWords) * sizeof(uint64_t));
+    bitArr->words = words, bitArr->capacity = newWords * WORD_BITS;
+    return true;
+}
+
+static bool reserve(struct ctls_BitArray* bitArr, size_t required)
+{
+    if (required <= bitArr->capacity)
+        return true;
+    size_t newWords = ctls_dyn_grownCapacity(bitArr->growthPolicy, bitArr->capacity / WORD_BITS, wordCount(required),
+        sizeof(uint64_t));
+    // The capacity in bits must be representable too.
+    return newWords && newWords <= SIZE_MAX / WORD_BITS && reallocWords(bitArr, newWords);
+}
+
+// Assigns `value` to the bits at indices [from, to), a word at a time.
+static void assignRange(uint64_t* words, size_t from, size_t to, bool value)
+{
+    while (from < to)
+    {
+        size_t shift = from % WORD_BITS, len = to - from < WORD_BITS - shift ? to - from : WORD_BITS - shift;
+        uint64_t mask = lowMask(len) << shift;
+        words[from / WORD_BITS] = value ? words[from / WORD_BITS] | mask : words[from / WORD_BITS] & ~mask;
+        from += len;
+    }
+}
+
+// Returns the `len` bits starting at index `pos` in the lowest bits of a word, for `len` between 1 and `WORD_BITS`.
+static uint64_t loadBits(const uint64_t* words, size_t pos, size_t len)
+{
+    size_t word = pos / WORD_BITS, shift = pos % WORD_BITS;
+    uint64_t bits = words[word] >> shift;
+    if (shift && shift + len > WORD_BITS)
+        bits |= words[word + 1] << (WORD_BITS - shift);
+    return bits & lowMask(len);
+}
+
+// Stores the lowest `len` bits of `bits` at index `pos`, leaving the surrounding bits untouched.
+static void storeBits(uint64_t* words, size_t pos, uint64_t bits, size_t len)
+{
+    size_t word = pos / WORD_BITS, shift = pos % WORD_BITS;
+    uint64_t mask = lowMask(len);
+    words[word] = (words[word] & ~(mask << shift)) | bits << shift;
+    if (shift && shift + len > WORD_BITS)
+        words[word + 1] = (words[word + 1] & ~(mask >> (WORD_BITS - shift))) | bits >> (WORD_BITS - shift);
+}
+
+// Copies `len` bits a word at a time, front to back, so the ranges may overlap as long as `dstPos` is not after
+// `srcPos`.
+static void copyBits(uint64_t* dst, size_t dstPos, const uint64_t* src, size_t srcPos, size_t len)
+{
+    for (size_t chunk; len; dstPos += chunk, srcPos += chunk, len -= chunk)
+    {
+        chunk = len < WORD_BITS ? len : WORD_BITS;
+        storeBits(dst, dstPos, loadBits(src, srcPos, chunk), chunk);
+    }
+}
+
+struct ctls_BitArray* ctls_bit_init(struct ctls_BitArray* bitArr, size_t initialCapacity)
+{
+    return ctls_bit_initWithAllocator(bitArr, initialCapacity, NULL);
+}
+
+struct ctls_BitArray* ctls_bit_initWithAllocator(struct ctls_BitArray* bitArr, size_t initialCapacity,
+    const struct ctls_Allocator* allocator)
+{
+    bool bitArrOriginallyNull = !bitArr;
+    if (bitArrOriginallyNull)
+        bitArr = malloc(sizeof(struct ctls_BitArray));
+    if (bitArr)
+    {
+        *bitArr = (struct ctls_BitArray){NULL, 0, 0, allocator, CTLS_DYN_GROWTH_GOLDEN};
+        if (!reallocWords(bitArr, wordCount(initialCapacity)))
+        {
+            if (bitArrOriginallyNull)
+                free(bitArr);
+            bitArr = NULL;
+        }
+    }
+    return bitArr;
+}
+
+struct ctls_BitArray* ctls_bit_defaultInit(struct ctls_BitArray* bitArr)
+{
+    return ctls_bit_init(bitArr, DEFAULT_INITIAL_CAPACITY);
+}
+
+void ctls_bit_reset(struct ctls_BitArray* bitArr)
+{
+    ctls_deallocate(bitArr->allocator, bitArr->words, bitArr->capacity / WORD_BITS * sizeof(uint64_t));
+    memset(bitArr, 0, sizeof(struct ctls_BitArray));
+}
+
+bool ctls_bit_shrinkToFit(struct ctls_BitArray* bitArr)
+{
+    return !bitArr->size || reallocWords(bitArr, wordCount(bitArr->size));
+}
+
+struct ctls_BitArray* ctls_bit_copy(struct ctls_BitArray* restrict dest, const struct ctls_BitArray* restrict src)
+{
+    if (!dest || !dest->words)
+    {
+        dest = ctls_bit_initWithAllocator(dest, src->capacity, src->allocator);
+        if (!dest)
+            return NULL;
+    }
+    else if (!reallocWords(dest, src->capacity / WORD_BITS))
+        return NULL;
+    // Copying every word, rather than those that hold bits, carries the zeroes beyond the size over too.
+    memcpy(dest->words, src->words, src->capacity / WORD_BITS * sizeof(uint64_t));
+    dest->size = src->size;
+    return dest;
+}
+
+bool ctls_bit_append(struct ctls_BitArray* bitArr, bool value)
+{
+    if (bitArr->size == bitArr->capacity && !reserve(bitArr, bitArr->size + 1))
+        return false;
+    bitArr->words[bitArr->size / WORD_BITS] |= (uint64_t)value << bitArr->size % WORD_BITS;
+    ++bitArr->size;
+    return true;
+}
+
+bool ctls_bit_extend(struct ctls_BitArray* bitArr, const uint64_t* src, size_t srcLen)
+{
+    if (srcLen > SIZE_MAX - bitArr->size || !reserve(bitArr, bitArr->size + srcLen))
+        return false;
+    copyBits(bitArr->words, bitArr->size, src, 0, srcLen);
+    bitArr->size += srcLen;
+    return true;
+}
+
+bool ctls_bit_resize(struct ctls_BitArray* bitArr, size_t size, bool value)
+{
+    if (size > bitArr->size)
+    {
+        if (!reserve(bitArr, size))
+            return false;
+        // The new bits are already zero.
+        if (value)
+            assignRange(bitArr->words, bitArr->size, size, true);
+    }
+    else
+        assignRange(bitArr->words, size, bitArr->size, false);
+    bitArr->size = size;
+    return true;
+}
+
+void ctls_bit_remove(struct ctls_BitArray* bitArr, size_t from, size_t to)
+{
+    size_t newSize = bitArr->size - (to - from);
+    copyBits(bitArr->words, from, bitArr->words, to, bitArr->size - to);
+    assignRange(bitArr->words, newSize, bitArr->size, false);
+    bitArr->size = newSize;
+}
+
+size_t ctls_bit_popcount(const struct ctls_BitArray* bitArr)
+{
+    return ctls_simd_popcount_u64(bitArr->words, wordCount(bitArr->size));
+}
+
+size_t ctls_bit_findFirstSet(const struct ctls_BitArray* bitArr, size_t from)
+{
+    if (from >= bitArr->size)
+        return bitArr->size;
+    size_t word = from / WORD_BITS, words = wordCount(bitArr->size);
+    uint64_t bits = bitArr->words[word] & UINT64_MAX << from % WORD_BITS;
+    if (!bits)
+    {
+        // Set bits are often close together, so the next word is checked before a search is dispatched to a kernel.
+        if (++word == words)
+            return bitArr->size;
+        if (!(bits = bitArr->words[word]))
+        {
+            word += 1 + ctls_simd_findNonzero_u64(bitArr->words + word + 1, words - word - 1);
+            if (word == words)
+                return bitArr->size;
+            bits = bitArr->words[word];
+        }
+    }
+    // The bits beyond the size are zero, so a set bit always lies within it.
+    return word * WORD_BITS + countTrailingZeros(bits);
+}
+
+void ctls_bit_and(struct ctls_BitArray* dest, const struct ctls_BitArray* src)
+{
+    ctls_simd_and_u64(dest->words, src->words, wordCount(dest->size));
+}
+
+void ctls_bit_or(struct ctls_BitArray* dest, const struct ctls_BitArray* src)
+{
+    ctls_simd_or_u64(dest->words, src->words, wordCount(dest->size));
+}
+
+void ctls_bit_xor(struct ctls_BitArray* dest, const struct ctls_BitArray* src)
+{
+    ctls_simd_xor_u64(dest->words, src->words, wordCount(dest->size));
+}
+
+void ctls_bit_andNot(struct ctls_BitArray* dest, const struct ctls_BitArray* src)
+{
+    ctls_simd_andNot_u64(dest->words, src->words, wordCount(dest->size));
+}
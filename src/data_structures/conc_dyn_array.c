@@ -0,0 +1,190 @@
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdatomic.h>
+
+#include "cutils/data_structures/conc_dyn_array.h"
+#include "cutils/data_structures/dyn_array.h"
+#include "cutils/data_structures/dyn_growth.h"
+#include "cutils/memory/allocator.h"
+
+#define DEFAULT_INITIAL_CAPACITY 64
+
+// Segment k starts at index `(2^k - 1) << firstSegmentShift`, so the segment an index belongs to follows from the
+// position of the highest set bit of `(index >> firstSegmentShift) + 1`.
+static size_t segmentOf(const struct ctls_ConcDynArray* concArr, size_t index)
+{
+    return ctls_dyn_floorLog2((index >> concArr->firstSegmentShift) + 1);
+}
+
+static size_t segmentStart(const struct ctls_ConcDynArray* concArr, size_t segment)
+{
+    return (((size_t)1 << segment) - 1) << concArr->firstSegmentShift;
+}
+
+static size_t segmentCapacity(const struct ctls_ConcDynArray* concArr, size_t segment)
+{
+    return (size_t)1 << (concArr->firstSegmentShift + segment);
+}
+
+// Makes sure segment `segment` exists. If several threads get here at once, each allocates a segment, and all but the
+// one that publishes its segment first free theirs again.
+static bool ensureSegment(struct ctls_ConcDynArray* concArr, size_t segment, size_t elemSize)
+{
+    if (atomic_load_explicit(&concArr->segments[segment], memory_order_acquire))
+        return true;
+    size_t capacity = segmentCapacity(concArr, segment);
+    if (capacity > SIZE_MAX / elemSize)
+        return false;
+    void* newSegment = ctls_allocate(concArr->allocator, capacity * elemSize);
+    if (!newSegment)
+        return false;
+    void* expected = NULL;
+    if (!atomic_compare_exchange_strong_explicit(&concArr->segments[segment], &expected, newSegment,
+        memory_order_acq_rel, memory_order_acquire))
+    {
+        ctls_deallocate(concArr->allocator, newSegment, capacity * elemSize);
+    }
+    return true;
+}
+
+struct ctls_ConcDynArray* ctls_cdyn_init(struct ctls_ConcDynArray* concArr, size_t initialCapacity, size_t elemSize)
+{
+    return ctls_cdyn_initWithAllocator(concArr, initialCapacity, elemSize, NULL);
+}
+
+struct ctls_ConcDynArray* ctls_cdyn_initWithAllocator(struct ctls_ConcDynArray* concArr, size_t initialCapacity,
+    size_t elemSize, const struct ctls_Allocator* allocator)
+{
+    size_t firstSegmentShift = ctls_dyn_floorLog2(initialCapacity);
+    if ((size_t)1 << firstSegmentShift < initialCapacity && ++firstSegmentShift == CTLS_CDYN_MAX_SEGMENTS)
+        return NULL;
+    bool concArrOriginallyNull = !concArr;
+    if (concArrOriginallyNull)
+        concArr = malloc(sizeof(struct ctls_ConcDynArray));
+    if (concArr)
+    {
+        for (size_t i = 0; i < CTLS_CDYN_MAX_SEGMENTS; ++i)
+            atomic_init(&concArr->segments[i], NULL);
+        atomic_init(&concArr->size, 0);
+        concArr->firstSegmentShift = firstSegmentShift, concArr->allocator = allocator;
+        if (!ensureSegment(concArr, 0, elemSize))
+        {
+            if (concArrOriginallyNull)
+                free(concArr);
+            concArr = NULL;
+        }
+    }
+    return concArr;
+}
+
+struct ctls_ConcDynArray* ctls_cdyn_defaultInit(struct ctls_ConcDynArray* concArr, size_t elemSize)
+{
+    return ctls_cdyn_init(concArr, DEFAULT_INITIAL_CAPACITY, elemSize);
+}
+
+void ctls_cdyn_reset(struct ctls_ConcDynArray* concArr, size_t elemSize)
+{
+    for (size_t i = 0; i < CTLS_CDYN_MAX_SEGMENTS; ++i)
+    {
+        void* segment = atomic_load_explicit(&concArr->segments[i], memory_order_relaxed);
+        if (segment)
+            ctls_deallocate(concArr->allocator, segment, segmentCapacity(concArr, i) * elemSize);
+    }
+    memset(concArr, 0, sizeof(struct ctls_ConcDynArray));
+}
+
+struct ctls_DynArray* ctls_cdyn_flatten(struct ctls_DynArray* restrict dest,
+    const struct ctls_ConcDynArray* restrict src, size_t elemSize)
+{
+    size_t size = ctls_cdyn_size(src);
+    bool destOriginallyNull = !dest;
+    if (!dest || !dest->data)
+    {
+        dest = ctls_dyn_initWithAllocator(dest, size ? size : 1, elemSize, src->allocator);
+        if (!dest)
+            return NULL;
+    }
+    dest->size = 0;
+    for (size_t i = 0, length; i < size; i += length)
+    {
+        const void* span = ctls_cdyn_span(src, i, elemSize, &length);
+        if (length > size - i)
+            length = size - i;
+        if (!ctls_dyn_extend(dest, span, length, elemSize))
+        {
+            if (destOriginallyNull)
+            {
+                ctls_dyn_reset(dest, elemSize);
+                free(dest);
+            }
+            return NULL;
+        }
+    }
+    return dest;
+}
+
+void* ctls_cdyn_at(const struct ctls_ConcDynArray* concArr, size_t index, size_t elemSize)
+{
+    size_t length;
+    return ctls_cdyn_span(concArr, index, elemSize, &length);
+}
+
+void* ctls_cdyn_span(const struct ctls_ConcDynArray* concArr, size_t index, size_t elemSize, size_t* length)
+{
+    size_t segment = segmentOf(concArr, index), offset = index - segmentStart(concArr, segment);
+    *length = segmentCapacity(concArr, segment) - offset;
+    char* data = atomic_load_explicit(&concArr->segments[segment], memory_order_acquire);
+    return data + offset * elemSize;
+}
+
+bool ctls_cdyn_reserveRange(struct ctls_ConcDynArray* concArr, size_t count, size_t elemSize, size_t* first)
+{
+    // Segments are published with their own release and acquire operations, so the counter itself needs no ordering.
+    size_t size = atomic_load_explicit(&concArr->size, memory_order_relaxed);
+    do
+    {
+        if (count > SIZE_MAX - size)
+            return false;
+        if (count)
+        {
+            for (size_t i = segmentOf(concArr, size), last = segmentOf(concArr, size + count - 1); i <= last; ++i)
+            {
+                if (!ensureSegment(concArr, i, elemSize))
+                    return false;
+            }
+        }
+    } while (!atomic_compare_exchange_weak_explicit(&concArr->size, &size, size + count, memory_order_relaxed,
+        memory_order_relaxed));
+    *first = size;
+    return true;
+}
+
+bool ctls_cdyn_append(struct ctls_ConcDynArray* restrict concArr, const void* restrict elem, size_t elemSize)
+{
+    size_t index;
+    if (!ctls_cdyn_reserveRange(concArr, 1, elemSize, &index))
+        return false;
+    memcpy(ctls_cdyn_at(concArr, index, elemSize), elem, elemSize);
+    return true;
+}
+
+bool ctls_cdyn_extend(struct ctls_ConcDynArray* restrict concArr, const void* restrict src, size_t srcLen,
+    size_t elemSize)
+{
+    size_t first;
+    if (!ctls_cdyn_reserveRange(concArr, srcLen, elemSize, &first))
+        return false;
+    const char* source = src;
+    for (size_t i = first, length; i < first + srcLen; i += length)
+    {
+        void* span = ctls_cdyn_span(concArr, i, elemSize, &length);
+        if (length > first + srcLen - i)
+            length = first + srcLen - i;
+        memcpy(span, source, length * elemSize);
+        source += length * elemSize;
+    }
+    return true;
+}
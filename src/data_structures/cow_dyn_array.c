@@ -0,0 +1,214 @@
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdatomic.h>
+
+#include "cutils/data_structures/cow_dyn_array.h"
+#include "cutils/data_structures/dyn_growth.h"
+#include "cutils/memory/allocator.h"
+
+// Returns the size of a block holding `capacity` elements, or zero if it cannot be represented.
+static size_t blockSize(size_t capacity, size_t elemSize)
+{
+    size_t header = offsetof(struct ctls_CowBlock, data);
+    return capacity > (SIZE_MAX - header) / elemSize ? 0 : header + capacity * elemSize;
+}
+
+static struct ctls_CowBlock* newBlock(const struct ctls_Allocator* allocator, size_t capacity, size_t elemSize)
+{
+    size_t size = blockSize(capacity, elemSize);
+    struct ctls_CowBlock* block = size ? ctls_allocate(allocator, size) : NULL;
+    if (block)
+    {
+        atomic_init(&block->refs, 1);
+        block->size = 0, block->capacity = capacity, block->allocator = allocator;
+    }
+    return block;
+}
+
+// Replaces the `removed` elements at `pos` with `added` uninitialized ones. If `cowArr`'s block is shared, the elements
+// that remain are copied straight into their final positions in a block of its own, so no element is copied twice.
+static bool reshape(struct ctls_CowDynArray* cowArr, size_t pos, size_t removed, size_t added, size_t elemSize)
+{
+    struct ctls_CowBlock* block = cowArr->block;
+    if (added > SIZE_MAX - block->size)
+        return false;
+    size_t newSize = block->size - removed + added, tail = block->size - pos - removed, capacity = block->capacity;
+    if (newSize > capacity && !(capacity = ctls_dyn_grownCapacity(cowArr->growthPolicy, capacity, newSize, elemSize)))
+        return false;
+    // Every other reference has been released, with release semantics, so nobody else can be reading the block.
+    if (atomic_load_explicit(&block->refs, memory_order_acquire) == 1)
+    {
+        if (capacity != block->capacity)
+        {
+            size_t newBlockSize = blockSize(capacity, elemSize);
+            struct ctls_CowBlock* grown = newBlockSize ? ctls_reallocate(block->allocator, block,
+                blockSize(block->capacity, elemSize), newBlockSize) : NULL;
+            if (!grown)
+                return false;
+            block = cowArr->block = grown;
+            block->capacity = capacity;
+        }
+        char* data = (char*)block->data;
+        memmove(data + (pos + added) * elemSize, data + (pos + removed) * elemSize, tail * elemSize);
+    }
+    else
+    {
+        struct ctls_CowBlock* copy = newBlock(block->allocator, capacity, elemSize);
+        if (!copy)
+            return false;
+        const char* src = (const char*)block->data;
+        char* data = (char*)copy->data;
+        memcpy(data, src, pos * elemSize);
+        memcpy(data + (pos + added) * elemSize, src + (pos + removed) * elemSize, tail * elemSize);
+        ctls_cow_release(block, elemSize);
+        block = cowArr->block = copy;
+    }
+    block->size = newSize;
+    return true;
+}
+
+struct ctls_CowDynArray* ctls_cow_init(struct ctls_CowDynArray* cowArr, size_t initialCapacity, size_t elemSize)
+{
+    return ctls_cow_initWithAllocator(cowArr, initialCapacity, elemSize, NULL);
+}
+
+struct ctls_CowDynArray* ctls_cow_initWithAllocator(struct ctls_CowDynArray* cowArr, size_t initialCapacity,
+    size_t elemSize, const struct ctls_Allocator* allocator)
+{
+    bool cowArrOriginallyNull = !cowArr;
+    if (cowArrOriginallyNull)
+        cowArr = malloc(sizeof(struct ctls_CowDynArray));
+    if (cowArr)
+    {
+        struct ctls_CowBlock* block = newBlock(allocator, initialCapacity, elemSize);
+        if (block)
+            *cowArr = (struct ctls_CowDynArray){block, CTLS_DYN_GROWTH_GOLDEN};
+        else
+        {
+            if (cowArrOriginallyNull)
+                free(cowArr);
+            cowArr = NULL;
+        }
+    }
+    return cowArr;
+}
+
+void ctls_cow_reset(struct ctls_CowDynArray* cowArr, size_t elemSize)
+{
+    ctls_cow_release(cowArr->block, elemSize);
+    memset(cowArr, 0, sizeof(struct ctls_CowDynArray));
+}
+
+struct ctls_CowDynArray* ctls_cow_copy(struct ctls_CowDynArray* dest, const struct ctls_CowDynArray* src)
+{
+    if (!dest && !(dest = malloc(sizeof(struct ctls_CowDynArray))))
+        return NULL;
+    *dest = (struct ctls_CowDynArray){(struct ctls_CowBlock*)ctls_cow_snapshot(src), src->growthPolicy};
+    return dest;
+}
+
+const struct ctls_CowBlock* ctls_cow_snapshot(const struct ctls_CowDynArray* cowArr)
+{
+    // The caller already holds a reference, so the block cannot be freed concurrently, and no ordering is needed.
+    atomic_fetch_add_explicit(&cowArr->block->refs, 1, memory_order_relaxed);
+    return cowArr->block;
+}
+
+void ctls_cow_release(const struct ctls_CowBlock* snapshot, size_t elemSize)
+{
+    struct ctls_CowBlock* block = (struct ctls_CowBlock*)snapshot;
+    if (block && atomic_fetch_sub_explicit(&block->refs, 1, memory_order_acq_rel) == 1)
+        ctls_deallocate(block->allocator, block, blockSize(block->capacity, elemSize));
+}
+
+// Tells the processor that this is a spin-wait loop, which saves power and, on a hyper-threaded core, lets the other
+// hardware thread, which may be the reader being waited for, run faster.
+static void spinPause(void)
+{
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_ia32_pause();
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+// A reader announces itself in the current epoch's counter before loading `current`, and only leaves once it holds a
+// reference. After swapping in a new version, the writer moves readers on to the other epoch's counter, and waits for
+// the old one to drain. New readers never delay the writer, as they count themselves in the new epoch.
+//
+// A reader that reads the epoch and then stalls may announce itself in a counter the writer has already drained. It
+// therefore reads the epoch again after announcing itself, and starts over if it has changed parity. If it has not, the
+// next publish that moves readers off this parity has yet to drain the counter, and has to wait for the reader. Every
+// version the reader can load is released after that publish, so its reference count cannot reach zero while the
+// reader is about to increment it.
+
+void ctls_cow_publish(struct ctls_CowSlot* slot, const struct ctls_CowDynArray* cowArr, size_t elemSize)
+{
+    struct ctls_CowBlock* version = (struct ctls_CowBlock*)ctls_cow_snapshot(cowArr);
+    struct ctls_CowBlock* previous = atomic_exchange(&slot->current, version);
+    size_t oldEpoch = atomic_fetch_add(&slot->epoch, 1) & 1;
+    while (atomic_load(&slot->readers[oldEpoch]))
+        spinPause();
+    ctls_cow_release(previous, elemSize);
+}
+
+const struct ctls_CowBlock* ctls_cow_acquire(struct ctls_CowSlot* slot)
+{
+    size_t epoch = atomic_load(&slot->epoch) & 1;
+    atomic_fetch_add(&slot->readers[epoch], 1);
+    for (size_t reread; (reread = atomic_load(&slot->epoch) & 1) != epoch; epoch = reread)
+    {
+        // A publish has drained, or is draining, the counter this reader announced itself in.
+        atomic_fetch_sub_explicit(&slot->readers[epoch], 1, memory_order_release);
+        atomic_fetch_add(&slot->readers[reread], 1);
+    }
+    struct ctls_CowBlock* current = atomic_load(&slot->current);
+    if (current)
+        atomic_fetch_add_explicit(&current->refs, 1, memory_order_relaxed);
+    atomic_fetch_sub_explicit(&slot->readers[epoch], 1, memory_order_release);
+    return current;
+}
+
+void ctls_cow_resetSlot(struct ctls_CowSlot* slot, size_t elemSize)
+{
+    ctls_cow_release(atomic_load_explicit(&slot->current, memory_order_relaxed), elemSize);
+    atomic_store_explicit(&slot->current, NULL, memory_order_relaxed);
+    atomic_store_explicit(&slot->epoch, 0, memory_order_relaxed);
+    atomic_store_explicit(&slot->readers[0], 0, memory_order_relaxed);
+    atomic_store_explicit(&slot->readers[1], 0, memory_order_relaxed);
+}
+
+void* ctls_cow_mutableData(struct ctls_CowDynArray* cowArr, size_t elemSize)
+{
+    return reshape(cowArr, cowArr->block->size, 0, 0, elemSize) ? cowArr->block->data : NULL;
+}
+
+bool ctls_cow_append(struct ctls_CowDynArray* restrict cowArr, const void* restrict elem, size_t elemSize)
+{
+    size_t size = cowArr->block->size;
+    if (!reshape(cowArr, size, 0, 1, elemSize))
+        return false;
+    memcpy((char*)cowArr->block->data + size * elemSize, elem, elemSize);
+    return true;
+}
+
+bool ctls_cow_insert(struct ctls_CowDynArray* cowArr, const void* src, size_t pos, size_t srcLen, size_t elemSize)
+{
+    if (!reshape(cowArr, pos, 0, srcLen, elemSize))
+        return false;
+    memcpy((char*)cowArr->block->data + pos * elemSize, src, srcLen * elemSize);
+    return true;
+}
+
+bool ctls_cow_extend(struct ctls_CowDynArray* cowArr, const void* src, size_t srcLen, size_t elemSize)
+{
+    return ctls_cow_insert(cowArr, src, cowArr->block->size, srcLen, elemSize);
+}
+
+bool ctls_cow_remove(struct ctls_CowDynArray* cowArr, size_t from, size_t to, size_t elemSize)
+{
+    return reshape(cowArr, from, to - from, 0, elemSize);
+}
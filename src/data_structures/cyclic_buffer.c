@@ -0,0 +1,155 @@
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdatomic.h>
+
+#include "cutils/data_structures/cyclic_buffer.h"
+#include "cutils/data_structures/dyn_growth.h"
+#include "cutils/memory/allocator.h"
+
+// Each counter is only ever written by one side, which can therefore read its own counter without ordering. Reading
+// the other side's counter is an acquire, which pairs with the release that publishes the elements or slots it covers.
+
+struct ctls_CyclicBuffer* ctls_cbuf_init(struct ctls_CyclicBuffer* buf, size_t capacity, size_t elemSize)
+{
+    return ctls_cbuf_initWithAllocator(buf, capacity, elemSize, NULL);
+}
+
+struct ctls_CyclicBuffer* ctls_cbuf_initWithAllocator(struct ctls_CyclicBuffer* buf, size_t capacity,
+    size_t elemSize, const struct ctls_Allocator* allocator)
+{
+    size_t roundedCapacity = (size_t)1 << ctls_dyn_floorLog2(capacity);
+    if (roundedCapacity < capacity && !(roundedCapacity <<= 1))
+        return NULL;
+    if (roundedCapacity > SIZE_MAX / elemSize)
+        return NULL;
+    bool bufOriginallyNull = !buf;
+    if (bufOriginallyNull)
+        buf = aligned_alloc(_Alignof(struct ctls_CyclicBuffer), sizeof(struct ctls_CyclicBuffer));
+    if (buf)
+    {
+        void* newData = ctls_allocate(allocator, roundedCapacity * elemSize);
+        if (newData)
+        {
+            buf->data = newData, buf->capacity = roundedCapacity, buf->allocator = allocator;
+            atomic_init(&buf->right, 0);
+            atomic_init(&buf->left, 0);
+            buf->cachedLeft = buf->cachedRight = 0;
+        }
+        else
+        {
+            if (bufOriginallyNull)
+                free(buf);
+            buf = NULL;
+        }
+    }
+    return buf;
+}
+
+void ctls_cbuf_reset(struct ctls_CyclicBuffer* buf, size_t elemSize)
+{
+    ctls_deallocate(buf->allocator, buf->data, buf->capacity * elemSize);
+    memset(buf, 0, sizeof(struct ctls_CyclicBuffer));
+}
+
+bool ctls_cbuf_push(struct ctls_CyclicBuffer* restrict buf, const void* restrict elem, size_t elemSize)
+{
+    size_t right = atomic_load_explicit(&buf->right, memory_order_relaxed);
+    if (right - buf->cachedLeft == buf->capacity)
+    {
+        buf->cachedLeft = atomic_load_explicit(&buf->left, memory_order_acquire);
+        if (right - buf->cachedLeft == buf->capacity)
+            return false;
+    }
+    memcpy((char*)buf->data + (right & (buf->capacity - 1)) * elemSize, elem, elemSize);
+    atomic_store_explicit(&buf->right, right + 1, memory_order_release);
+    return true;
+}
+
+size_t ctls_cbuf_pushMany(struct ctls_CyclicBuffer* restrict buf, const void* restrict src, size_t srcLen,
+    size_t elemSize)
+{
+    const char* source = src;
+    size_t pushed = 0;
+    // The free slots wrap around at most once, so two spans always suffice.
+    for (int i = 0; i < 2 && pushed < srcLen; ++i)
+    {
+        size_t length;
+        void* span = ctls_cbuf_writeSpan(buf, elemSize, &length);
+        if (length > srcLen - pushed)
+            length = srcLen - pushed;
+        if (!length)
+            break;
+        memcpy(span, source + pushed * elemSize, length * elemSize);
+        ctls_cbuf_commitWrite(buf, length);
+        pushed += length;
+    }
+    return pushed;
+}
+
+void* ctls_cbuf_writeSpan(struct ctls_CyclicBuffer* buf, size_t elemSize, size_t* length)
+{
+    size_t right = atomic_load_explicit(&buf->right, memory_order_relaxed), offset = right & (buf->capacity - 1);
+    buf->cachedLeft = atomic_load_explicit(&buf->left, memory_order_acquire);
+    size_t vacant = buf->capacity - (right - buf->cachedLeft), contiguous = buf->capacity - offset;
+    *length = vacant < contiguous ? vacant : contiguous;
+    return (char*)buf->data + offset * elemSize;
+}
+
+void ctls_cbuf_commitWrite(struct ctls_CyclicBuffer* buf, size_t count)
+{
+    size_t right = atomic_load_explicit(&buf->right, memory_order_relaxed);
+    atomic_store_explicit(&buf->right, right + count, memory_order_release);
+}
+
+bool ctls_cbuf_pop(struct ctls_CyclicBuffer* restrict buf, void* restrict elem, size_t elemSize)
+{
+    size_t left = atomic_load_explicit(&buf->left, memory_order_relaxed);
+    if (left == buf->cachedRight)
+    {
+        buf->cachedRight = atomic_load_explicit(&buf->right, memory_order_acquire);
+        if (left == buf->cachedRight)
+            return false;
+    }
+    if (elem)
+        memcpy(elem, (char*)buf->data + (left & (buf->capacity - 1)) * elemSize, elemSize);
+    atomic_store_explicit(&buf->left, left + 1, memory_order_release);
+    return true;
+}
+
+size_t ctls_cbuf_popMany(struct ctls_CyclicBuffer* restrict buf, void* restrict dest, size_t destLen,
+    size_t elemSize)
+{
+    char* destination = dest;
+    size_t popped = 0;
+    for (int i = 0; i < 2 && popped < destLen; ++i)
+    {
+        size_t length;
+        const void* span = ctls_cbuf_readSpan(buf, elemSize, &length);
+        if (length > destLen - popped)
+            length = destLen - popped;
+        if (!length)
+            break;
+        memcpy(destination + popped * elemSize, span, length * elemSize);
+        ctls_cbuf_commitRead(buf, length);
+        popped += length;
+    }
+    return popped;
+}
+
+void* ctls_cbuf_readSpan(struct ctls_CyclicBuffer* buf, size_t elemSize, size_t* length)
+{
+    size_t left = atomic_load_explicit(&buf->left, memory_order_relaxed), offset = left & (buf->capacity - 1);
+    buf->cachedRight = atomic_load_explicit(&buf->right, memory_order_acquire);
+    size_t available = buf->cachedRight - left, contiguous = buf->capacity - offset;
+    *length = available < contiguous ? available : contiguous;
+    return (char*)buf->data + offset * elemSize;
+}
+
+void ctls_cbuf_commitRead(struct ctls_CyclicBuffer* buf, size_t count)
+{
+    size_t left = atomic_load_explicit(&buf->left, memory_order_relaxed);
+    atomic_store_explicit(&buf->left, left + count, memory_order_release);
+}
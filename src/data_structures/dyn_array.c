@@ -1,36 +1,63 @@
+// This file defines the out-of-line functions that the inline versions in dyn_array.h fall back on.
+#define CTLS_DYN_NO_INLINE
+
 #include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
-#include <math.h>
+#include <stdint.h>
 
 #include "cutils/data_structures/dyn_array.h"
-#include "cutils/math/constants.h"
+#include "cutils/data_structures/dyn_growth.h"
+#include "cutils/data_structures/dyn_stats.h"
+#include "cutils/memory/aligned.h"
+#include "cutils/memory/allocator.h"
 
-// By one measure, the golden ratio is the optimal growth factor. It allows reuse of a memory block after only two
-// reallocations, the theoretical minimum. Of course, whether memory blocks are reused in this way depends on the amount
-// of contiguous memory available, and how memory allocation is implemented.
-#define GROWTH_FACTOR CTLS_PHI
 #define DEFAULT_INITIAL_CAPACITY 8
 
+CTLS_DYN_STATS_SITE(site, "ctls_DynArray")
+
 static bool reallocData(struct ctls_DynArray* dynArr, size_t newCapacity, size_t elemSize)
 {
-    void* newData = realloc(dynArr->data, newCapacity * elemSize);
+    void* newData = ctls_reallocate(dynArr->allocator, dynArr->data, dynArr->capacity * elemSize,
+        newCapacity * elemSize);
     if (newData)
+    {
+        CTLS_DYN_ON_REALLOC(site, dynArr, dynArr->capacity, newCapacity, elemSize);
         dynArr->data = newData, dynArr->capacity = newCapacity;
+    }
     return newData;
 }
 
+// Only called once `dynArr` has run out of room, so that the common case does not pay for a function call.
+static bool grow(struct ctls_DynArray* dynArr, size_t srcLen, size_t elemSize)
+{
+    if (srcLen > SIZE_MAX - dynArr->size)
+        return false;
+    size_t newCapacity = ctls_dyn_grownCapacity(dynArr->growthPolicy, dynArr->capacity, dynArr->size + srcLen,
+        elemSize);
+    return newCapacity && reallocData(dynArr, newCapacity, elemSize);
+}
+
 struct ctls_DynArray* ctls_dyn_init(struct ctls_DynArray* dynArr, size_t initialCapacity, size_t elemSize)
+{
+    return ctls_dyn_initWithAllocator(dynArr, initialCapacity, elemSize, NULL);
+}
+
+struct ctls_DynArray* ctls_dyn_initWithAllocator(struct ctls_DynArray* dynArr, size_t initialCapacity,
+    size_t elemSize, const struct ctls_Allocator* allocator)
 {
     bool dynArrOriginallyNull = !dynArr;
     if (dynArrOriginallyNull)
         dynArr = malloc(sizeof(struct ctls_DynArray));
     if (dynArr)
     {
-        void* newData = malloc(initialCapacity * elemSize);
+        void* newData = ctls_allocate(allocator, initialCapacity * elemSize);
         if (newData)
-            *dynArr = (struct ctls_DynArray){newData, 0, initialCapacity};
+        {
+            *dynArr = (struct ctls_DynArray){newData, 0, initialCapacity, allocator, CTLS_DYN_GROWTH_GOLDEN};
+            CTLS_DYN_ON_INIT(site, dynArr, elemSize);
+        }
         else
         {
             if (dynArrOriginallyNull)
@@ -46,9 +73,17 @@ struct ctls_DynArray* ctls_dyn_defaultInit(struct ctls_DynArray* dynArr, size_t
     return ctls_dyn_init(dynArr, DEFAULT_INITIAL_CAPACITY, elemSize);
 }
 
+struct ctls_DynArray* ctls_dyn_initAligned(struct ctls_DynArray* dynArr, size_t initialCapacity, size_t elemSize,
+    size_t alignment)
+{
+    const struct ctls_Allocator* allocator = ctls_alignedAllocator(alignment);
+    return allocator ? ctls_dyn_initWithAllocator(dynArr, initialCapacity, elemSize, allocator) : NULL;
+}
+
 void ctls_dyn_reset(struct ctls_DynArray* dynArr, size_t elemSize)
 {
-    free(dynArr->data);
+    CTLS_DYN_ON_RESET(site, dynArr, elemSize);
+    ctls_deallocate(dynArr->allocator, dynArr->data, dynArr->capacity * elemSize);
     memset(dynArr, 0, sizeof(struct ctls_DynArray));
 }
 
@@ -60,10 +95,9 @@ bool ctls_dyn_shrinkToFit(struct ctls_DynArray* dynArr, size_t elemSize)
 struct ctls_DynArray* ctls_dyn_copy(struct ctls_DynArray* restrict dest, const struct ctls_DynArray* restrict src,
     size_t elemSize)
 {
-    bool destOriginallyNull = !dest;
     if (!dest || !dest->data)
     {
-        dest = ctls_dyn_init(dest, src->capacity, elemSize);
+        dest = ctls_dyn_initWithAllocator(dest, src->capacity, elemSize, src->allocator);
         if (!dest)
             return NULL;
     }
@@ -76,12 +110,8 @@ struct ctls_DynArray* ctls_dyn_copy(struct ctls_DynArray* restrict dest, const s
 
 bool ctls_dyn_append(struct ctls_DynArray* restrict dynArr, const void* restrict elem, size_t elemSize)
 {
-    if (dynArr->size == dynArr->capacity)
-    {
-        size_t newCapacity = round(GROWTH_FACTOR * dynArr->capacity);
-        if (newCapacity < dynArr->capacity || !reallocData(dynArr, newCapacity, elemSize))
-            return false;
-    }
+    if (dynArr->size == dynArr->capacity && !grow(dynArr, 1, elemSize))
+        return false;
     memcpy((char*)dynArr->data + elemSize * dynArr->size, elem, elemSize);
     ++dynArr->size;
     return true;
@@ -89,16 +119,11 @@ bool ctls_dyn_append(struct ctls_DynArray* restrict dynArr, const void* restrict
 
 bool ctls_dyn_insert(struct ctls_DynArray* dynArr, const void* src, size_t pos, size_t srcLen, size_t elemSize)
 {
-    size_t n = dynArr->capacity;
-    for (; n < dynArr->size + srcLen; n = round(GROWTH_FACTOR * n))
-    {
-        if (n < dynArr->capacity)
-            return false;
-    }
-    if (!reallocData(dynArr, n, elemSize))
+    if (srcLen > dynArr->capacity - dynArr->size && !grow(dynArr, srcLen, elemSize))
         return false;
     char* data = dynArr->data;
     size_t scaledPos = pos * elemSize, scaledSrcLen = srcLen * elemSize;
+    CTLS_DYN_ON_MOVE(site, dynArr, dynArr->size * elemSize - scaledPos);
     memmove(data + scaledPos + scaledSrcLen, data + scaledPos, dynArr->size * elemSize - scaledPos);
     memmove(data + scaledPos, src, scaledSrcLen);
     dynArr->size += srcLen;
@@ -113,6 +138,56 @@ bool ctls_dyn_extend(struct ctls_DynArray* dynArr, const void* src, size_t srcLe
 void ctls_dyn_remove(struct ctls_DynArray* dynArr, size_t from, size_t to, size_t elemSize)
 {
     size_t scaledFrom = from * elemSize, scaledTo = to * elemSize;
+    CTLS_DYN_ON_MOVE(site, dynArr, dynArr->size * elemSize - scaledTo);
     memmove((char*)dynArr->data + scaledFrom, (char*)dynArr->data + scaledTo, dynArr->size * elemSize - scaledTo);
     dynArr->size -= (to - from);
 }
+
+void ctls_dyn_removeRanges(struct ctls_DynArray* dynArr, const size_t* bounds, size_t rangeCount, size_t elemSize)
+{
+    if (!rangeCount)
+        return;
+    char* data = dynArr->data;
+    // `kept` trails behind the read position by the number of elements removed so far. The elements between the end
+    // of one range and the start of the next are moved down in one go.
+    size_t kept = bounds[0];
+    for (size_t i = 0; i < rangeCount; ++i)
+    {
+        size_t to = bounds[2 * i + 1], next = i + 1 < rangeCount ? bounds[2 * i + 2] : dynArr->size;
+        memmove(data + kept * elemSize, data + to * elemSize, (next - to) * elemSize);
+        kept += next - to;
+    }
+    CTLS_DYN_ON_MOVE(site, dynArr, (kept - bounds[0]) * elemSize);
+    dynArr->size = kept;
+}
+
+size_t ctls_dyn_eraseIf(struct ctls_DynArray* dynArr, bool (*pred)(const void* elem, void* ctx), void* ctx,
+    size_t elemSize)
+{
+    char* data = dynArr->data;
+    // Elements before the first one to be removed stay where they are.
+    size_t first = 0;
+    while (first < dynArr->size && !pred(data + first * elemSize, ctx))
+        ++first;
+    size_t kept = first, runStart = first + 1;
+    for (size_t i = runStart; i <= dynArr->size; ++i)
+    {
+        // A run of remaining elements ends either at an element that is to be removed, or at the end of the array.
+        if (i < dynArr->size && !pred(data + i * elemSize, ctx))
+            continue;
+        if (kept != runStart)
+            memmove(data + kept * elemSize, data + runStart * elemSize, (i - runStart) * elemSize);
+        kept += i - runStart;
+        runStart = i + 1;
+    }
+    CTLS_DYN_ON_MOVE(site, dynArr, (kept - first) * elemSize);
+    size_t removed = dynArr->size - kept;
+    dynArr->size = kept;
+    return removed;
+}
+
+void ctls_dyn_swapRemove(struct ctls_DynArray* dynArr, size_t pos, size_t elemSize)
+{
+    if (pos != --dynArr->size)
+        memcpy((char*)dynArr->data + pos * elemSize, (char*)dynArr->data + dynArr->size * elemSize, elemSize);
+}
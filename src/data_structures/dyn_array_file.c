@@ -0,0 +1,205 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "cutils/data_structures/dyn_array.h"
+#include "cutils/data_structures/dyn_array_file.h"
+#include "cutils/memory/aligned.h"
+
+#define MAGIC "CTLSDYNA"
+#define VERSION 1
+// Written in the writer's byte order, so a reader of the opposite byte order sees 0x04030201.
+#define BYTE_ORDER_MARK 0x01020304u
+#define TEMPORARY_SUFFIX ".tmp"
+
+struct Header
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrderMark;
+    uint64_t elemSize;
+    uint64_t size;
+    uint64_t alignment;
+    // Offset of the first element from the start of the file; a multiple of `alignment`.
+    uint64_t dataOffset;
+    uint64_t checksum;
+    // Checksum of every preceding member.
+    uint64_t headerChecksum;
+};
+
+_Static_assert(sizeof(struct Header) == CTLS_DYN_FILE_HEADER_SIZE, "header is not CTLS_DYN_FILE_HEADER_SIZE bytes");
+
+#define PRIME1 0x9E3779B97F4A7C15u
+#define PRIME2 0xBF58476D1CE4E5B9u
+#define LANES 4
+
+static uint64_t rotl(uint64_t x, int bits)
+{
+    return x << bits | x >> (64 - bits);
+}
+
+static uint64_t mixWord(uint64_t h, uint64_t word)
+{
+    return rotl(h ^ word * PRIME1, 31) * PRIME2;
+}
+
+// A 64-bit multiply-rotate hash. Words are fed to four independent lanes, so that the multiplications overlap and the
+// checksum of a large file is bounded by memory bandwidth rather than by multiplication latency.
+static uint64_t checksum(const void* bytes, size_t len)
+{
+    const unsigned char* p = bytes;
+    uint64_t lanes[LANES] = {PRIME1, PRIME2, ~PRIME1, ~PRIME2}, word;
+    size_t i = 0;
+    for (; len - i >= LANES * sizeof word; i += LANES * sizeof word)
+    {
+        for (size_t lane = 0; lane < LANES; ++lane)
+        {
+            memcpy(&word, p + i + lane * sizeof word, sizeof word);
+            lanes[lane] = mixWord(lanes[lane], word);
+        }
+    }
+    for (; len - i >= sizeof word; i += sizeof word)
+    {
+        memcpy(&word, p + i, sizeof word);
+        lanes[0] = mixWord(lanes[0], word);
+    }
+    word = 0;
+    if (len > i)
+        memcpy(&word, p + i, len - i);
+    uint64_t h = mixWord(lanes[0], word) ^ rotl(lanes[1], 17) ^ rotl(lanes[2], 29) ^ rotl(lanes[3], 43) ^ len;
+    h ^= h >> 33, h *= PRIME2, h ^= h >> 29, h *= PRIME1, h ^= h >> 32;
+    return h;
+}
+
+static uint64_t headerChecksum(const struct Header* h)
+{
+    return checksum(h, offsetof(struct Header, headerChecksum));
+}
+
+// Writes every byte described by `iov`, resuming after partial writes.
+static bool writeAll(int fd, struct iovec* iov, int count)
+{
+    while (count)
+    {
+        ssize_t written = writev(fd, iov, count);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+        for (; count && (size_t)written >= iov->iov_len; ++iov, --count)
+            written -= iov->iov_len;
+        if (count)
+            iov->iov_base = (char*)iov->iov_base + written, iov->iov_len -= (size_t)written;
+    }
+    return true;
+}
+
+bool ctls_dyn_save(const struct ctls_DynArray* dynArr, const char* path, size_t elemSize, size_t alignment)
+{
+    static const char padding[CTLS_MAX_ALIGNMENT];
+    if (!alignment)
+        alignment = CTLS_DYN_FILE_HEADER_SIZE;
+    if (alignment & (alignment - 1) || alignment > CTLS_MAX_ALIGNMENT)
+        return false;
+    size_t dataOffset = alignment > CTLS_DYN_FILE_HEADER_SIZE ? alignment : CTLS_DYN_FILE_HEADER_SIZE;
+    size_t dataSize = dynArr->size * elemSize;
+    struct Header h = {.version = VERSION, .byteOrderMark = BYTE_ORDER_MARK, .elemSize = elemSize,
+        .size = dynArr->size, .alignment = alignment, .dataOffset = dataOffset,
+        .checksum = checksum(dynArr->data, dataSize)};
+    memcpy(h.magic, MAGIC, sizeof h.magic);
+    h.headerChecksum = headerChecksum(&h);
+
+    size_t pathLen = strlen(path);
+    char* temporaryPath = malloc(pathLen + sizeof TEMPORARY_SUFFIX);
+    if (!temporaryPath)
+        return false;
+    memcpy(temporaryPath, path, pathLen);
+    memcpy(temporaryPath + pathLen, TEMPORARY_SUFFIX, sizeof TEMPORARY_SUFFIX);
+    int fd = open(temporaryPath, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+    bool success = fd != -1;
+    if (success)
+    {
+        struct iovec iov[] = {
+            {&h, sizeof h},
+            {(void*)padding, dataOffset - sizeof h},
+            {dynArr->data, dataSize},
+        };
+        success = writeAll(fd, iov, sizeof iov / sizeof *iov) && !fsync(fd);
+        success = !close(fd) && success;
+        success = success && !rename(temporaryPath, path);
+        if (!success)
+            unlink(temporaryPath);
+    }
+    free(temporaryPath);
+    return success;
+}
+
+// Checks that a header describes a file of `fileSize` bytes written by this version of the library.
+static bool validHeader(const struct Header* h, size_t fileSize, size_t elemSize)
+{
+    if (memcmp(h->magic, MAGIC, sizeof h->magic) || h->version != VERSION || h->byteOrderMark != BYTE_ORDER_MARK
+        || h->headerChecksum != headerChecksum(h) || h->elemSize != elemSize || !elemSize)
+    {
+        return false;
+    }
+    if (!h->alignment || h->alignment & (h->alignment - 1) || h->dataOffset % h->alignment
+        || h->dataOffset < CTLS_DYN_FILE_HEADER_SIZE || h->dataOffset > fileSize)
+    {
+        return false;
+    }
+    return h->size <= (fileSize - h->dataOffset) / elemSize;
+}
+
+struct ctls_DynArrayView* ctls_dyn_openView(struct ctls_DynArrayView* view, const char* path, size_t elemSize)
+{
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd == -1)
+        return NULL;
+    struct stat st;
+    void* mapping = MAP_FAILED;
+    size_t mappingSize = 0;
+    if (!fstat(fd, &st) && st.st_size >= CTLS_DYN_FILE_HEADER_SIZE && (uint64_t)st.st_size <= SIZE_MAX)
+    {
+        mappingSize = (size_t)st.st_size;
+        mapping = mmap(NULL, mappingSize, PROT_READ, MAP_SHARED, fd, 0);
+    }
+    // The mapping outlives the descriptor.
+    close(fd);
+    if (mapping == MAP_FAILED)
+        return NULL;
+
+    const struct Header* h = mapping;
+    bool viewOriginallyNull = !view;
+    if (!validHeader(h, mappingSize, elemSize) || (viewOriginallyNull && !(view = malloc(sizeof *view))))
+    {
+        munmap(mapping, mappingSize);
+        return NULL;
+    }
+    *view = (struct ctls_DynArrayView){(const char*)mapping + h->dataOffset, h->size, elemSize, mapping, mappingSize};
+    return view;
+}
+
+bool ctls_dyn_verifyView(const struct ctls_DynArrayView* view)
+{
+    const struct Header* h = view->mapping;
+    return checksum(view->data, view->size * view->elemSize) == h->checksum;
+}
+
+void ctls_dyn_closeView(struct ctls_DynArrayView* view)
+{
+    munmap(view->mapping, view->mappingSize);
+    memset(view, 0, sizeof(struct ctls_DynArrayView));
+}
@@ -0,0 +1,106 @@
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdatomic.h>
+
+#include "cutils/data_structures/dyn_growth.h"
+#include "cutils/data_structures/dyn_stats.h"
+
+static _Thread_local struct ctls_DynStats* chosenSite;
+static _Atomic(struct ctls_DynStats*) sites;
+
+// Resolves the site an operation is attributed to, and makes sure it is listed the first time it records anything.
+static struct ctls_DynStats* resolve(struct ctls_DynStats* site)
+{
+    if (chosenSite)
+        site = chosenSite;
+    if (!atomic_load_explicit(&site->registered, memory_order_acquire)
+        && !atomic_exchange_explicit(&site->registered, true, memory_order_acq_rel))
+    {
+        site->next = atomic_load_explicit(&sites, memory_order_relaxed);
+        while (!atomic_compare_exchange_weak_explicit(&sites, &site->next, site, memory_order_release,
+            memory_order_relaxed))
+            ;
+    }
+    return site;
+}
+
+static void add(atomic_size_t* counter, size_t n)
+{
+    atomic_fetch_add_explicit(counter, n, memory_order_relaxed);
+}
+
+static void raiseTo(atomic_size_t* counter, size_t n)
+{
+    size_t current = atomic_load_explicit(counter, memory_order_relaxed);
+    while (current < n && !atomic_compare_exchange_weak_explicit(counter, &current, n, memory_order_relaxed,
+        memory_order_relaxed))
+        ;
+}
+
+struct ctls_DynStats* ctls_dyn_setStatsSite(struct ctls_DynStats* site)
+{
+    struct ctls_DynStats* previous = chosenSite;
+    chosenSite = site;
+    return previous;
+}
+
+struct ctls_DynStats* ctls_dyn_statsSites(void)
+{
+    return atomic_load_explicit(&sites, memory_order_acquire);
+}
+
+void ctls_dyn_statsOnInit(struct ctls_DynStats* site, size_t capacity, size_t elemSize)
+{
+    site = resolve(site);
+    add(&site->inits, 1);
+    raiseTo(&site->peakCapacityBytes, capacity * elemSize);
+}
+
+void ctls_dyn_statsOnRealloc(struct ctls_DynStats* site, size_t oldCapacity, size_t newCapacity, size_t elemSize)
+{
+    site = resolve(site);
+    add(&site->reallocations, 1);
+    add(&site->bytesReallocated, oldCapacity * elemSize);
+    raiseTo(&site->peakCapacityBytes, newCapacity * elemSize);
+}
+
+void ctls_dyn_statsOnMove(struct ctls_DynStats* site, size_t bytes)
+{
+    if (bytes)
+        add(&resolve(site)->bytesMoved, bytes);
+}
+
+void ctls_dyn_statsOnReset(struct ctls_DynStats* site, size_t size, size_t capacity, size_t elemSize)
+{
+    site = resolve(site);
+    add(&site->resets, 1);
+    add(&site->slackBytes, (capacity - size) * elemSize);
+    size_t bucket = size ? ctls_dyn_floorLog2(size) + 1 : 0;
+    add(&site->finalSizes[bucket < CTLS_DYN_STATS_BUCKETS ? bucket : CTLS_DYN_STATS_BUCKETS - 1], 1);
+}
+
+#define LOAD(site, counter) atomic_load_explicit(&(site)->counter, memory_order_relaxed)
+
+void ctls_dyn_statsReport(FILE* stream)
+{
+    fprintf(stream, "%-24s %10s %10s %16s %16s %16s %10s %12s %12s\n", "site", "inits", "reallocs", "bytes_realloced",
+        "bytes_moved", "peak_cap_bytes", "resets", "avg_slack", "suggested_cap");
+    for (struct ctls_DynStats* site = ctls_dyn_statsSites(); site; site = site->next)
+    {
+        size_t resets = LOAD(site, resets), suggested = 0;
+        // The suggestion is the upper bound of the bucket in which 90% of the resets have been counted.
+        for (size_t i = 0, counted = 0; resets && i < CTLS_DYN_STATS_BUCKETS; ++i)
+        {
+            counted += LOAD(site, finalSizes[i]);
+            if (counted * 10 >= resets * 9)
+            {
+                suggested = i ? (size_t)1 << i : 0;
+                break;
+            }
+        }
+        fprintf(stream, "%-24s %10zu %10zu %16zu %16zu %16zu %10zu %12zu %12zu\n", site->name, LOAD(site, inits),
+            LOAD(site, reallocations), LOAD(site, bytesReallocated), LOAD(site, bytesMoved),
+            LOAD(site, peakCapacityBytes), resets, resets ? LOAD(site, slackBytes) / resets : 0, suggested);
+    }
+}
@@ -0,0 +1,203 @@
+// mremap is a Linux extension. Elsewhere, growth falls back to mapping the file anew.
+#define _GNU_SOURCE
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "cutils/data_structures/mapped_dyn_array.h"
+#include "cutils/data_structures/dyn_growth.h"
+
+#define MAGIC "CTLSMDYN"
+#define VERSION 1
+
+struct Header
+{
+    char magic[8];
+    uint64_t version;
+    uint64_t elemSize;
+    uint64_t size;
+    uint64_t capacity;
+};
+
+_Static_assert(sizeof(struct Header) <= CTLS_MDYN_HEADER_SIZE, "header does not fit in CTLS_MDYN_HEADER_SIZE bytes");
+
+static struct Header* header(const struct ctls_MappedDynArray* mapArr)
+{
+    return mapArr->mapping;
+}
+
+// Returns the size of a file holding `capacity` elements, or zero if it cannot be represented.
+static size_t fileSize(size_t capacity, size_t elemSize)
+{
+    if (capacity > (SIZE_MAX - CTLS_MDYN_HEADER_SIZE) / elemSize || capacity * elemSize + CTLS_MDYN_HEADER_SIZE >
+        (uint64_t)INT64_MAX)
+    {
+        return 0;
+    }
+    return capacity * elemSize + CTLS_MDYN_HEADER_SIZE;
+}
+
+static void* mapFile(int fd, size_t size)
+{
+    void* mapping = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    return mapping == MAP_FAILED ? NULL : mapping;
+}
+
+// Maps an existing file after checking that its header is consistent with its size and `elemSize`.
+static bool mapExisting(struct ctls_MappedDynArray* mapArr, off_t size)
+{
+    struct Header h;
+    if ((uint64_t)size < CTLS_MDYN_HEADER_SIZE || pread(mapArr->fd, &h, sizeof h, 0) != (ssize_t)sizeof h)
+        return false;
+    if (memcmp(h.magic, MAGIC, sizeof h.magic) || h.version != VERSION || h.elemSize != mapArr->elemSize
+        || h.capacity > SIZE_MAX || h.size > h.capacity)
+    {
+        return false;
+    }
+    size_t mappingSize = fileSize(h.capacity, mapArr->elemSize);
+    if (!mappingSize || mappingSize > (uint64_t)size || !(mapArr->mapping = mapFile(mapArr->fd, mappingSize)))
+        return false;
+    mapArr->size = h.size, mapArr->capacity = h.capacity, mapArr->mappingSize = mappingSize;
+    return true;
+}
+
+static bool mapNew(struct ctls_MappedDynArray* mapArr, size_t capacity)
+{
+    size_t mappingSize = fileSize(capacity, mapArr->elemSize);
+    if (!mappingSize || ftruncate(mapArr->fd, (off_t)mappingSize) || !(mapArr->mapping = mapFile(mapArr->fd,
+        mappingSize)))
+    {
+        return false;
+    }
+    struct Header* h = header(mapArr);
+    memcpy(h->magic, MAGIC, sizeof h->magic);
+    h->version = VERSION, h->elemSize = mapArr->elemSize, h->size = 0, h->capacity = capacity;
+    mapArr->size = 0, mapArr->capacity = capacity, mapArr->mappingSize = mappingSize;
+    return true;
+}
+
+// Resizes the file and the mapping to hold `newCapacity` elements. The file grows before the mapping does, and shrinks
+// after, so no part of the mapping ever lies past the end of the file. The file may be left larger than the mapping.
+static bool resize(struct ctls_MappedDynArray* mapArr, size_t newCapacity)
+{
+    size_t newMappingSize = fileSize(newCapacity, mapArr->elemSize);
+    if (!newMappingSize)
+        return false;
+    if (newMappingSize > mapArr->mappingSize && ftruncate(mapArr->fd, (off_t)newMappingSize))
+        return false;
+#ifdef MREMAP_MAYMOVE
+    void* newMapping = mremap(mapArr->mapping, mapArr->mappingSize, newMappingSize, MREMAP_MAYMOVE);
+    if (newMapping == MAP_FAILED)
+        return false;
+#else
+    // Every shared mapping of a file sees the same pages, so mapping it anew copies nothing.
+    void* newMapping = mapFile(mapArr->fd, newMappingSize);
+    if (!newMapping)
+        return false;
+    munmap(mapArr->mapping, mapArr->mappingSize);
+#endif
+    // If the file cannot be shrunk, it merely keeps some unused space past the end of the mapping, which reopening it
+    // tolerates. `mappingSize` must still be that of the mapping, which `mremap` has already shrunk.
+    if (newMappingSize < mapArr->mappingSize)
+        (void)ftruncate(mapArr->fd, (off_t)newMappingSize);
+    mapArr->mapping = newMapping, mapArr->mappingSize = newMappingSize;
+    mapArr->data = (char*)newMapping + CTLS_MDYN_HEADER_SIZE, mapArr->capacity = newCapacity;
+    header(mapArr)->capacity = newCapacity;
+    return true;
+}
+
+static bool grow(struct ctls_MappedDynArray* mapArr, size_t srcLen)
+{
+    if (srcLen > SIZE_MAX - mapArr->size)
+        return false;
+    size_t newCapacity = ctls_dyn_grownCapacity(mapArr->growthPolicy, mapArr->capacity, mapArr->size + srcLen,
+        mapArr->elemSize);
+    return newCapacity && resize(mapArr, newCapacity);
+}
+
+struct ctls_MappedDynArray* ctls_mdyn_open(struct ctls_MappedDynArray* mapArr, const char* path, size_t elemSize,
+    size_t initialCapacity)
+{
+    bool mapArrOriginallyNull = !mapArr;
+    if (mapArrOriginallyNull)
+        mapArr = malloc(sizeof(struct ctls_MappedDynArray));
+    if (!mapArr)
+        return NULL;
+    *mapArr = (struct ctls_MappedDynArray){.elemSize = elemSize, .growthPolicy = CTLS_DYN_GROWTH_GOLDEN};
+    struct stat st;
+    if ((mapArr->fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0666)) != -1 && !fstat(mapArr->fd, &st)
+        && (st.st_size ? mapExisting(mapArr, st.st_size) : mapNew(mapArr, initialCapacity)))
+    {
+        mapArr->data = (char*)mapArr->mapping + CTLS_MDYN_HEADER_SIZE;
+        return mapArr;
+    }
+    if (mapArr->fd != -1)
+        close(mapArr->fd);
+    if (mapArrOriginallyNull)
+        free(mapArr);
+    return NULL;
+}
+
+bool ctls_mdyn_close(struct ctls_MappedDynArray* mapArr)
+{
+    header(mapArr)->size = mapArr->size;
+    bool success = !munmap(mapArr->mapping, mapArr->mappingSize);
+    success = !close(mapArr->fd) && success;
+    memset(mapArr, 0, sizeof(struct ctls_MappedDynArray));
+    return success;
+}
+
+bool ctls_mdyn_sync(struct ctls_MappedDynArray* mapArr)
+{
+    header(mapArr)->size = mapArr->size;
+    return !msync(mapArr->mapping, mapArr->mappingSize, MS_SYNC) && !fsync(mapArr->fd);
+}
+
+bool ctls_mdyn_shrinkToFit(struct ctls_MappedDynArray* mapArr)
+{
+    size_t newCapacity = mapArr->size ? mapArr->size : 1;
+    return newCapacity == mapArr->capacity || resize(mapArr, newCapacity);
+}
+
+bool ctls_mdyn_append(struct ctls_MappedDynArray* restrict mapArr, const void* restrict elem)
+{
+    if (mapArr->size == mapArr->capacity && !grow(mapArr, 1))
+        return false;
+    memcpy((char*)mapArr->data + mapArr->elemSize * mapArr->size, elem, mapArr->elemSize);
+    header(mapArr)->size = ++mapArr->size;
+    return true;
+}
+
+bool ctls_mdyn_insert(struct ctls_MappedDynArray* mapArr, const void* src, size_t pos, size_t srcLen)
+{
+    if (srcLen > mapArr->capacity - mapArr->size && !grow(mapArr, srcLen))
+        return false;
+    char* data = mapArr->data;
+    size_t scaledPos = pos * mapArr->elemSize, scaledSrcLen = srcLen * mapArr->elemSize;
+    memmove(data + scaledPos + scaledSrcLen, data + scaledPos, mapArr->size * mapArr->elemSize - scaledPos);
+    memcpy(data + scaledPos, src, scaledSrcLen);
+    mapArr->size += srcLen;
+    header(mapArr)->size = mapArr->size;
+    return true;
+}
+
+bool ctls_mdyn_extend(struct ctls_MappedDynArray* mapArr, const void* src, size_t srcLen)
+{
+    return ctls_mdyn_insert(mapArr, src, mapArr->size, srcLen);
+}
+
+void ctls_mdyn_remove(struct ctls_MappedDynArray* mapArr, size_t from, size_t to)
+{
+    size_t scaledFrom = from * mapArr->elemSize, scaledTo = to * mapArr->elemSize;
+    memmove((char*)mapArr->data + scaledFrom, (char*)mapArr->data + scaledTo,
+        mapArr->size * mapArr->elemSize - scaledTo);
+    mapArr->size -= (to - from);
+    header(mapArr)->size = mapArr->size;
+}
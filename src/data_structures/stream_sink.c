@@ -0,0 +1,190 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "cutils/data_structures/dyn_array.h"
+#include "cutils/data_structures/stream_sink.h"
+
+// Writes `len` bytes at `offset`, resuming after partial writes.
+static bool writeAll(int fd, const char* bytes, size_t len, uint64_t offset)
+{
+    while (len)
+    {
+        ssize_t written = pwrite(fd, bytes, len, (off_t)offset);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+        bytes += written, len -= (size_t)written, offset += (uint64_t)written;
+    }
+    return true;
+}
+
+// The background thread. Only it touches `sink->pending` between the hand-over and `sink->pending` being reset, so the
+// buffer is written without holding the mutex.
+static void* flushBuffers(void* arg)
+{
+    struct ctls_StreamSink* sink = arg;
+    pthread_mutex_lock(&sink->mutex);
+    for (;;)
+    {
+        while (!sink->pending && !sink->stopping)
+            pthread_cond_wait(&sink->bufferReady, &sink->mutex);
+        struct ctls_DynArray* buffer = sink->pending;
+        if (!buffer)
+            break;
+        // Read while the mutex is held. Only this thread modifies `sink->written`, so it stays valid after unlocking.
+        uint64_t offset = sink->written;
+        size_t len = buffer->size * sink->elemSize;
+        bool failed = atomic_load_explicit(&sink->failed, memory_order_relaxed);
+        pthread_mutex_unlock(&sink->mutex);
+
+        bool success = !failed && writeAll(sink->fd, buffer->data, len, offset);
+        buffer->size = 0;
+
+        pthread_mutex_lock(&sink->mutex);
+        if (success)
+            sink->written += len;
+        else
+            atomic_store_explicit(&sink->failed, true, memory_order_relaxed);
+        sink->pending = NULL;
+        pthread_cond_broadcast(&sink->bufferFree);
+    }
+    pthread_mutex_unlock(&sink->mutex);
+    return NULL;
+}
+
+// Hands the active buffer to the background thread, once it has finished with the other one, and makes the other one
+// active.
+static bool handOver(struct ctls_StreamSink* sink)
+{
+    pthread_mutex_lock(&sink->mutex);
+    if (sink->pending)
+    {
+        ++sink->stalls;
+        do
+            pthread_cond_wait(&sink->bufferFree, &sink->mutex);
+        while (sink->pending);
+    }
+    sink->pending = sink->active;
+    sink->active = sink->active == &sink->buffers[0] ? &sink->buffers[1] : &sink->buffers[0];
+    bool failed = atomic_load_explicit(&sink->failed, memory_order_relaxed);
+    pthread_cond_signal(&sink->bufferReady);
+    pthread_mutex_unlock(&sink->mutex);
+    return !failed;
+}
+
+struct ctls_StreamSink* ctls_sink_open(struct ctls_StreamSink* sink, const char* path, size_t elemSize,
+    size_t bufferCapacity, bool durable)
+{
+    bool sinkOriginallyNull = !sink;
+    if (sinkOriginallyNull && !(sink = malloc(sizeof(struct ctls_StreamSink))))
+        return NULL;
+    memset(sink, 0, sizeof(struct ctls_StreamSink));
+    atomic_init(&sink->failed, false);
+    sink->elemSize = elemSize;
+    sink->active = &sink->buffers[0];
+    sink->fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC | (durable ? O_DSYNC : 0), 0666);
+    bool mutexInitialized = false, readyInitialized = false, freeInitialized = false;
+    if (sink->fd != -1 && ctls_dyn_init(&sink->buffers[0], bufferCapacity, elemSize)
+        && ctls_dyn_init(&sink->buffers[1], bufferCapacity, elemSize))
+    {
+        mutexInitialized = !pthread_mutex_init(&sink->mutex, NULL);
+        readyInitialized = mutexInitialized && !pthread_cond_init(&sink->bufferReady, NULL);
+        freeInitialized = readyInitialized && !pthread_cond_init(&sink->bufferFree, NULL);
+        if (freeInitialized && !pthread_create(&sink->thread, NULL, flushBuffers, sink))
+            return sink;
+    }
+
+    // Only what was created is destroyed.
+    if (freeInitialized)
+        pthread_cond_destroy(&sink->bufferFree);
+    if (readyInitialized)
+        pthread_cond_destroy(&sink->bufferReady);
+    if (mutexInitialized)
+        pthread_mutex_destroy(&sink->mutex);
+    for (size_t i = 0; i < 2; ++i)
+    {
+        if (sink->buffers[i].data)
+            ctls_dyn_reset(&sink->buffers[i], elemSize);
+    }
+    if (sink->fd != -1)
+        close(sink->fd);
+    if (sinkOriginallyNull)
+        free(sink);
+    return NULL;
+}
+
+bool ctls_sink_close(struct ctls_StreamSink* sink)
+{
+    bool success = ctls_sink_flush(sink);
+    pthread_mutex_lock(&sink->mutex);
+    sink->stopping = true;
+    pthread_cond_signal(&sink->bufferReady);
+    pthread_mutex_unlock(&sink->mutex);
+    pthread_join(sink->thread, NULL);
+
+    pthread_cond_destroy(&sink->bufferFree);
+    pthread_cond_destroy(&sink->bufferReady);
+    pthread_mutex_destroy(&sink->mutex);
+    ctls_dyn_reset(&sink->buffers[0], sink->elemSize);
+    ctls_dyn_reset(&sink->buffers[1], sink->elemSize);
+    success = !close(sink->fd) && success;
+    memset(sink, 0, sizeof(struct ctls_StreamSink));
+    return success;
+}
+
+bool ctls_sink_flush(struct ctls_StreamSink* sink)
+{
+    if (sink->active->size)
+        handOver(sink);
+    pthread_mutex_lock(&sink->mutex);
+    while (sink->pending)
+        pthread_cond_wait(&sink->bufferFree, &sink->mutex);
+    bool failed = atomic_load_explicit(&sink->failed, memory_order_relaxed);
+    pthread_mutex_unlock(&sink->mutex);
+    return !failed;
+}
+
+bool ctls_sink_append(struct ctls_StreamSink* restrict sink, const void* restrict elem)
+{
+    // Once a write has failed, the stream has a gap, so nothing more is buffered.
+    if (atomic_load_explicit(&sink->failed, memory_order_relaxed))
+        return false;
+    if (sink->active->size == sink->active->capacity && !handOver(sink))
+        return false;
+    // The buffer has room, so this never reallocates.
+    return ctls_dyn_append(sink->active, elem, sink->elemSize);
+}
+
+bool ctls_sink_extend(struct ctls_StreamSink* restrict sink, const void* restrict src, size_t srcLen)
+{
+    if (atomic_load_explicit(&sink->failed, memory_order_relaxed))
+        return false;
+    const char* bytes = src;
+    while (srcLen)
+    {
+        struct ctls_DynArray* active = sink->active;
+        if (active->size == active->capacity)
+        {
+            if (!handOver(sink))
+                return false;
+            active = sink->active;
+        }
+        size_t chunk = active->capacity - active->size < srcLen ? active->capacity - active->size : srcLen;
+        ctls_dyn_extend(active, bytes, chunk, sink->elemSize);
+        bytes += chunk * sink->elemSize, srcLen -= chunk;
+    }
+    return true;
+}
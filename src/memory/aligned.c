@@ -0,0 +1,168 @@
+// MAP_ANONYMOUS, MADV_HUGEPAGE, and mremap are extensions to POSIX.
+#define _GNU_SOURCE
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "cutils/memory/aligned.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#define HAVE_MMAP 1
+#else
+#define HAVE_MMAP 0
+#endif
+
+// Each aligned allocator's state points to its alignment, so that one set of functions serves all of them.
+static const size_t alignments[] = {16, 32, 64, 128, 256, 512, 1024, 2048, 4096};
+
+_Static_assert(_Alignof(max_align_t) <= 16, "the smallest supported alignment is below that of max_align_t");
+
+static size_t roundUp(size_t size, size_t alignment)
+{
+    return (size + alignment - 1) & ~(alignment - 1);
+}
+
+static void* alignedAllocate(void* state, size_t size)
+{
+    size_t alignment = *(const size_t*)state;
+    if (size > SIZE_MAX - alignment)
+        return NULL;
+    // aligned_alloc requires the size to be a multiple of the alignment.
+    return aligned_alloc(alignment, size ? roundUp(size, alignment) : alignment);
+}
+
+// realloc may move a block to an address with weaker alignment, so a block is always moved by hand.
+static void* alignedReallocate(void* state, void* block, size_t oldSize, size_t newSize)
+{
+    size_t alignment = *(const size_t*)state;
+    // Larger sizes round up to zero, which would pass for the size of an empty block.
+    if (newSize > SIZE_MAX - alignment)
+        return NULL;
+    if (block && roundUp(oldSize, alignment) == roundUp(newSize, alignment))
+        return block;
+    void* newBlock = alignedAllocate(state, newSize);
+    if (newBlock && block)
+    {
+        memcpy(newBlock, block, oldSize < newSize ? oldSize : newSize);
+        free(block);
+    }
+    return newBlock;
+}
+
+static void alignedDeallocate(void* state, void* block, size_t size)
+{
+    (void)state, (void)size;
+    free(block);
+}
+
+#define ALIGNED_ALLOCATOR(i) {alignedAllocate, alignedReallocate, alignedDeallocate, (void*)&alignments[i]}
+
+static const struct ctls_Allocator alignedAllocators[] = {ALIGNED_ALLOCATOR(0), ALIGNED_ALLOCATOR(1),
+    ALIGNED_ALLOCATOR(2), ALIGNED_ALLOCATOR(3), ALIGNED_ALLOCATOR(4), ALIGNED_ALLOCATOR(5), ALIGNED_ALLOCATOR(6),
+    ALIGNED_ALLOCATOR(7), ALIGNED_ALLOCATOR(8)};
+
+const struct ctls_Allocator* ctls_alignedAllocator(size_t alignment)
+{
+    if (!alignment || alignment & (alignment - 1) || alignment > CTLS_MAX_ALIGNMENT)
+        return NULL;
+    size_t i = 0;
+    while (alignments[i] < alignment)
+        ++i;
+    return &alignedAllocators[i];
+}
+
+// The huge page allocator aligns small blocks like the 64-byte aligned allocator does.
+#define SMALL_STATE ((void*)&alignments[2])
+
+#if HAVE_MMAP
+
+// Maps `size` bytes, which must be a multiple of CTLS_HUGE_PAGE_SIZE, at an address that is too. mmap only aligns to
+// the base page size, so one extra huge page is mapped and the excess is trimmed from both ends.
+static void* mapHuge(size_t size)
+{
+    if (size > SIZE_MAX - CTLS_HUGE_PAGE_SIZE)
+        return NULL;
+    char* raw = mmap(NULL, size + CTLS_HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED)
+        return NULL;
+    char* aligned = (char*)roundUp((uintptr_t)raw, CTLS_HUGE_PAGE_SIZE);
+    if (aligned != raw)
+        munmap(raw, (size_t)(aligned - raw));
+    if (aligned + size != raw + size + CTLS_HUGE_PAGE_SIZE)
+        munmap(aligned + size, (size_t)(raw + CTLS_HUGE_PAGE_SIZE - aligned));
+#ifdef MADV_HUGEPAGE
+    madvise(aligned, size, MADV_HUGEPAGE);
+#endif
+    return aligned;
+}
+
+static void* hugeAllocate(void* state, size_t size)
+{
+    (void)state;
+    if (size < CTLS_HUGE_PAGE_SIZE)
+        return alignedAllocate(SMALL_STATE, size);
+    size_t mappedSize = roundUp(size, CTLS_HUGE_PAGE_SIZE);
+    return mappedSize ? mapHuge(mappedSize) : NULL;
+}
+
+static void hugeDeallocate(void* state, void* block, size_t size)
+{
+    (void)state;
+    if (!block)
+        return;
+    if (size < CTLS_HUGE_PAGE_SIZE)
+        free(block);
+    else
+        munmap(block, roundUp(size, CTLS_HUGE_PAGE_SIZE));
+}
+
+static void* hugeReallocate(void* state, void* block, size_t oldSize, size_t newSize)
+{
+    if (!block)
+        return hugeAllocate(state, newSize);
+    if (oldSize < CTLS_HUGE_PAGE_SIZE && newSize < CTLS_HUGE_PAGE_SIZE)
+        return alignedReallocate(SMALL_STATE, block, oldSize, newSize);
+    if (oldSize >= CTLS_HUGE_PAGE_SIZE && newSize >= CTLS_HUGE_PAGE_SIZE)
+    {
+        size_t oldMappedSize = roundUp(oldSize, CTLS_HUGE_PAGE_SIZE);
+        size_t newMappedSize = roundUp(newSize, CTLS_HUGE_PAGE_SIZE);
+        // Sizes within a huge page of SIZE_MAX round up to zero, which would otherwise pass for shrinking the block.
+        if (!newMappedSize)
+            return NULL;
+        if (newMappedSize <= oldMappedSize)
+        {
+            if (newMappedSize < oldMappedSize)
+                munmap((char*)block + newMappedSize, oldMappedSize - newMappedSize);
+            return block;
+        }
+#ifdef MREMAP_MAYMOVE
+        // Growing in place keeps the block aligned to a huge page; moving it might not, so that is left to the
+        // general case below. `newMappedSize` is nonzero and greater than `oldMappedSize` here.
+        if (mremap(block, oldMappedSize, newMappedSize, 0) != MAP_FAILED)
+        {
+#ifdef MADV_HUGEPAGE
+            madvise(block, newMappedSize, MADV_HUGEPAGE);
+#endif
+            return block;
+        }
+#endif
+    }
+    void* newBlock = hugeAllocate(state, newSize);
+    if (newBlock)
+    {
+        memcpy(newBlock, block, oldSize < newSize ? oldSize : newSize);
+        hugeDeallocate(state, block, oldSize);
+    }
+    return newBlock;
+}
+
+const struct ctls_Allocator ctls_hugePageAllocator = {hugeAllocate, hugeReallocate, hugeDeallocate, NULL};
+
+#else
+
+const struct ctls_Allocator ctls_hugePageAllocator = ALIGNED_ALLOCATOR(2);
+
+#endif
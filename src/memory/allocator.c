@@ -0,0 +1,24 @@
+#include <stddef.h>
+#include <stdlib.h>
+
+#include "cutils/memory/allocator.h"
+
+static void* mallocAllocate(void* state, size_t size)
+{
+    (void)state;
+    return malloc(size);
+}
+
+static void* mallocReallocate(void* state, void* block, size_t oldSize, size_t newSize)
+{
+    (void)state, (void)oldSize;
+    return realloc(block, newSize);
+}
+
+static void mallocDeallocate(void* state, void* block, size_t size)
+{
+    (void)state, (void)size;
+    free(block);
+}
+
+const struct ctls_Allocator ctls_mallocAllocator = {mallocAllocate, mallocReallocate, mallocDeallocate, NULL};
@@ -0,0 +1,139 @@
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "cutils/memory/arena.h"
+
+#define ALIGNMENT _Alignof(max_align_t)
+
+struct ctls_ArenaChunk
+{
+    struct ctls_ArenaChunk* next;
+    size_t capacity;
+    _Alignas(max_align_t) unsigned char data[];
+};
+
+// The largest size that can be aligned and added to the header of a chunk without overflowing.
+#define MAX_SIZE ((size_t)-1 - sizeof(struct ctls_ArenaChunk) - ALIGNMENT)
+
+static size_t alignUp(size_t size)
+{
+    return (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+}
+
+static struct ctls_ArenaChunk* newChunk(size_t capacity)
+{
+    struct ctls_ArenaChunk* chunk = capacity <= MAX_SIZE ? malloc(sizeof(struct ctls_ArenaChunk) + capacity) : NULL;
+    if (chunk)
+        chunk->next = NULL, chunk->capacity = capacity;
+    return chunk;
+}
+
+// Makes the chunk after the current one, or a new chunk inserted there, current. Chunks that are too small are kept in
+// the list so that they can be reused after the next rewind.
+static bool advance(struct ctls_Arena* arena, size_t size)
+{
+    struct ctls_ArenaChunk* next = arena->current->next;
+    if (!next || next->capacity < size)
+    {
+        struct ctls_ArenaChunk* chunk = newChunk(size > arena->chunkSize ? size : arena->chunkSize);
+        if (!chunk)
+            return false;
+        chunk->next = next;
+        arena->current->next = chunk;
+        next = chunk;
+    }
+    arena->current = next, arena->used = 0;
+    return true;
+}
+
+void* ctls_arena_allocate(struct ctls_Arena* arena, size_t size)
+{
+    if (size > MAX_SIZE)
+        return NULL;
+    size = size ? alignUp(size) : ALIGNMENT;
+    if (arena->current->capacity - arena->used < size && !advance(arena, size))
+        return NULL;
+    arena->lastOffset = arena->used;
+    arena->used += size;
+    return arena->current->data + arena->lastOffset;
+}
+
+static void* arenaAllocate(void* state, size_t size)
+{
+    return ctls_arena_allocate(state, size);
+}
+
+static void* arenaReallocate(void* state, void* block, size_t oldSize, size_t newSize)
+{
+    struct ctls_Arena* arena = state;
+    if (!block)
+        return ctls_arena_allocate(arena, newSize);
+    // Larger sizes would wrap to zero when aligned, and pass for fitting in place.
+    if (newSize > MAX_SIZE)
+        return NULL;
+    if (block == arena->current->data + arena->lastOffset
+        && alignUp(newSize) <= arena->current->capacity - arena->lastOffset)
+    {
+        arena->used = arena->lastOffset + alignUp(newSize);
+        return block;
+    }
+    if (newSize <= oldSize)
+        return block;
+    void* newBlock = ctls_arena_allocate(arena, newSize);
+    if (newBlock)
+        memcpy(newBlock, block, oldSize);
+    return newBlock;
+}
+
+static void arenaDeallocate(void* state, void* block, size_t size)
+{
+    (void)size;
+    struct ctls_Arena* arena = state;
+    if (block && block == arena->current->data + arena->lastOffset)
+        arena->used = arena->lastOffset;
+}
+
+struct ctls_Arena* ctls_arena_init(struct ctls_Arena* arena, size_t chunkSize)
+{
+    bool arenaOriginallyNull = !arena;
+    if (arenaOriginallyNull)
+        arena = malloc(sizeof(struct ctls_Arena));
+    if (arena)
+    {
+        struct ctls_ArenaChunk* chunk = newChunk(chunkSize);
+        if (chunk)
+        {
+            *arena = (struct ctls_Arena){{arenaAllocate, arenaReallocate, arenaDeallocate, arena}, chunk, chunk, 0, 0,
+                chunkSize};
+        }
+        else
+        {
+            if (arenaOriginallyNull)
+                free(arena);
+            arena = NULL;
+        }
+    }
+    return arena;
+}
+
+struct ctls_Arena* ctls_arena_defaultInit(struct ctls_Arena* arena)
+{
+    return ctls_arena_init(arena, CTLS_ARENA_DEFAULT_CHUNK_SIZE);
+}
+
+void ctls_arena_reset(struct ctls_Arena* arena)
+{
+    for (struct ctls_ArenaChunk* chunk = arena->first, * next; chunk; chunk = next)
+    {
+        next = chunk->next;
+        free(chunk);
+    }
+    memset(arena, 0, sizeof(struct ctls_Arena));
+}
+
+void ctls_arena_rewind(struct ctls_Arena* arena)
+{
+    arena->current = arena->first, arena->used = 0, arena->lastOffset = 0;
+}
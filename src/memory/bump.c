@@ -0,0 +1,72 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "cutils/memory/bump.h"
+
+#define ALIGNMENT _Alignof(max_align_t)
+
+static size_t alignUp(size_t size)
+{
+    return (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+}
+
+void* ctls_bump_allocate(struct ctls_Bump* bump, size_t size)
+{
+    if (size > bump->capacity - bump->used)
+        return NULL;
+    size = size ? alignUp(size) : ALIGNMENT;
+    if (size > bump->capacity - bump->used)
+        return NULL;
+    bump->lastOffset = bump->used;
+    bump->used += size;
+    return bump->buffer + bump->lastOffset;
+}
+
+static void* bumpAllocate(void* state, size_t size)
+{
+    return ctls_bump_allocate(state, size);
+}
+
+static void* bumpReallocate(void* state, void* block, size_t oldSize, size_t newSize)
+{
+    struct ctls_Bump* bump = state;
+    if (!block)
+        return ctls_bump_allocate(bump, newSize);
+    if (block == bump->buffer + bump->lastOffset && newSize <= bump->capacity - bump->lastOffset)
+    {
+        bump->used = bump->lastOffset + alignUp(newSize);
+        if (bump->used > bump->capacity)
+            bump->used = bump->capacity;
+        return block;
+    }
+    if (newSize <= oldSize)
+        return block;
+    void* newBlock = ctls_bump_allocate(bump, newSize);
+    if (newBlock)
+        memcpy(newBlock, block, oldSize);
+    return newBlock;
+}
+
+static void bumpDeallocate(void* state, void* block, size_t size)
+{
+    (void)size;
+    struct ctls_Bump* bump = state;
+    if (block && block == bump->buffer + bump->lastOffset)
+        bump->used = bump->lastOffset;
+}
+
+struct ctls_Bump* ctls_bump_init(struct ctls_Bump* bump, void* buffer, size_t size)
+{
+    size_t padding = alignUp((uintptr_t)buffer) - (uintptr_t)buffer;
+    if (padding > size)
+        padding = size;
+    *bump = (struct ctls_Bump){{bumpAllocate, bumpReallocate, bumpDeallocate, bump}, (unsigned char*)buffer + padding,
+        size - padding, 0, 0};
+    return bump;
+}
+
+void ctls_bump_rewind(struct ctls_Bump* bump)
+{
+    bump->used = 0, bump->lastOffset = 0;
+}
@@ -0,0 +1,110 @@
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "cutils/memory/pool.h"
+
+#define ALIGNMENT _Alignof(max_align_t)
+
+struct ctls_PoolChunk
+{
+    struct ctls_PoolChunk* next;
+    _Alignas(max_align_t) unsigned char data[];
+};
+
+static struct ctls_PoolChunk* newChunk(const struct ctls_Pool* pool)
+{
+    // A block size of zero means that rounding it up overflowed.
+    if (!pool->blockSize || pool->blocksPerChunk > ((size_t)-1 - sizeof(struct ctls_PoolChunk)) / pool->blockSize)
+        return NULL;
+    struct ctls_PoolChunk* chunk = malloc(sizeof(struct ctls_PoolChunk) + pool->blockSize * pool->blocksPerChunk);
+    if (chunk)
+        chunk->next = NULL;
+    return chunk;
+}
+
+void* ctls_pool_allocate(struct ctls_Pool* pool)
+{
+    void* block = pool->freeList;
+    if (block)
+    {
+        memcpy(&pool->freeList, block, sizeof(void*));
+        return block;
+    }
+    if (pool->used == pool->blocksPerChunk)
+    {
+        if (!pool->current->next && !(pool->current->next = newChunk(pool)))
+            return NULL;
+        pool->current = pool->current->next, pool->used = 0;
+    }
+    return pool->current->data + pool->blockSize * pool->used++;
+}
+
+void ctls_pool_deallocate(struct ctls_Pool* pool, void* block)
+{
+    if (block)
+    {
+        memcpy(block, &pool->freeList, sizeof(void*));
+        pool->freeList = block;
+    }
+}
+
+static void* poolAllocate(void* state, size_t size)
+{
+    struct ctls_Pool* pool = state;
+    return size <= pool->blockSize ? ctls_pool_allocate(pool) : NULL;
+}
+
+static void* poolReallocate(void* state, void* block, size_t oldSize, size_t newSize)
+{
+    (void)oldSize;
+    struct ctls_Pool* pool = state;
+    if (newSize > pool->blockSize)
+        return NULL;
+    return block ? block : ctls_pool_allocate(pool);
+}
+
+static void poolDeallocate(void* state, void* block, size_t size)
+{
+    (void)size;
+    ctls_pool_deallocate(state, block);
+}
+
+struct ctls_Pool* ctls_pool_init(struct ctls_Pool* pool, size_t blockSize, size_t blocksPerChunk)
+{
+    bool poolOriginallyNull = !pool;
+    if (poolOriginallyNull)
+        pool = malloc(sizeof(struct ctls_Pool));
+    if (pool)
+    {
+        if (blockSize < sizeof(void*))
+            blockSize = sizeof(void*);
+        blockSize = (blockSize + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+        *pool = (struct ctls_Pool){{poolAllocate, poolReallocate, poolDeallocate, pool}, NULL, NULL, 0, NULL,
+            blockSize, blocksPerChunk};
+        pool->first = pool->current = newChunk(pool);
+        if (!pool->first)
+        {
+            if (poolOriginallyNull)
+                free(pool);
+            pool = NULL;
+        }
+    }
+    return pool;
+}
+
+void ctls_pool_reset(struct ctls_Pool* pool)
+{
+    for (struct ctls_PoolChunk* chunk = pool->first, * next; chunk; chunk = next)
+    {
+        next = chunk->next;
+        free(chunk);
+    }
+    memset(pool, 0, sizeof(struct ctls_Pool));
+}
+
+void ctls_pool_rewind(struct ctls_Pool* pool)
+{
+    pool->current = pool->first, pool->used = 0, pool->freeList = NULL;
+}
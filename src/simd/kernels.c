@@ -0,0 +1,711 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdatomic.h>
+
+#include "cutils/simd/kernels.h"
+
+#if (defined(__x86_64__) || (defined(__i386__) && defined(__SSE2__))) && (defined(__GNUC__) || defined(__clang__))
+#define HAVE_X86 1
+#include <immintrin.h>
+// Every processor with AVX2 also has POPCNT, which the AVX2 counting kernels rely on.
+#define AVX2_TARGET __attribute__((target("avx2,popcnt")))
+#else
+#define HAVE_X86 0
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Dispatch
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static atomic_int activeLevel = -1;
+
+static enum ctls_SimdLevel supportedLevel(void)
+{
+#if HAVE_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt"))
+        return CTLS_SIMD_AVX2;
+    return CTLS_SIMD_SSE2;
+#else
+    return CTLS_SIMD_SCALAR;
+#endif
+}
+
+enum ctls_SimdLevel ctls_simd_level(void)
+{
+    int level = atomic_load_explicit(&activeLevel, memory_order_relaxed);
+    if (level < 0)
+    {
+        level = supportedLevel();
+        atomic_store_explicit(&activeLevel, level, memory_order_relaxed);
+    }
+    return level;
+}
+
+enum ctls_SimdLevel ctls_simd_setLevel(enum ctls_SimdLevel level)
+{
+    enum ctls_SimdLevel supported = supportedLevel();
+    if (level > supported)
+        level = supported;
+    atomic_store_explicit(&activeLevel, level, memory_order_relaxed);
+    return level;
+}
+
+#if HAVE_X86
+#define DISPATCH(kernel, suffix, args) \
+    switch (ctls_simd_level()) \
+    { \
+    case CTLS_SIMD_AVX2: \
+        return kernel##Avx2_##suffix args; \
+    case CTLS_SIMD_SSE2: \
+        return kernel##Sse2_##suffix args; \
+    default: \
+        return kernel##Scalar_##suffix args; \
+    }
+#define DISPATCH_VOID(kernel, suffix, args) \
+    switch (ctls_simd_level()) \
+    { \
+    case CTLS_SIMD_AVX2: \
+        kernel##Avx2_##suffix args; \
+        break; \
+    case CTLS_SIMD_SSE2: \
+        kernel##Sse2_##suffix args; \
+        break; \
+    default: \
+        kernel##Scalar_##suffix args; \
+    }
+#else
+#define DISPATCH(kernel, suffix, args) return kernel##Scalar_##suffix args;
+#define DISPATCH_VOID(kernel, suffix, args) kernel##Scalar_##suffix args;
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Scalar Kernels
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// `accum` is the type sums are computed in, which for signed integers is unsigned so that overflow wraps around.
+#define DEFINE_SCALAR_KERNELS(type, suffix, sumType, accum) \
+\
+static size_t findScalar_##suffix(const type* data, size_t n, type value) \
+{ \
+    for (size_t i = 0; i < n; ++i) \
+    { \
+        if (data[i] == value) \
+            return i; \
+    } \
+    return n; \
+} \
+\
+static size_t countScalar_##suffix(const type* data, size_t n, type value) \
+{ \
+    size_t count = 0; \
+    for (size_t i = 0; i < n; ++i) \
+        count += data[i] == value; \
+    return count; \
+} \
+\
+static void fillScalar_##suffix(type* data, size_t n, type value) \
+{ \
+    for (size_t i = 0; i < n; ++i) \
+        data[i] = value; \
+} \
+\
+static sumType sumScalar_##suffix(const type* data, size_t n) \
+{ \
+    accum sum = 0; \
+    for (size_t i = 0; i < n; ++i) \
+        sum += (accum)data[i]; \
+    return (sumType)sum; \
+} \
+\
+static type minScalar_##suffix(const type* data, size_t n) \
+{ \
+    type min = data[0]; \
+    for (size_t i = 1; i < n; ++i) \
+        min = data[i] < min ? data[i] : min; \
+    return min; \
+} \
+\
+static type maxScalar_##suffix(const type* data, size_t n) \
+{ \
+    type max = data[0]; \
+    for (size_t i = 1; i < n; ++i) \
+        max = data[i] > max ? data[i] : max; \
+    return max; \
+}
+
+DEFINE_SCALAR_KERNELS(int32_t, i32, int64_t, uint64_t)
+DEFINE_SCALAR_KERNELS(int64_t, i64, int64_t, uint64_t)
+DEFINE_SCALAR_KERNELS(float, f32, float, float)
+DEFINE_SCALAR_KERNELS(double, f64, double, double)
+
+static double sumWideScalar_f32(const float* data, size_t n)
+{
+    double sum = 0;
+    for (size_t i = 0; i < n; ++i)
+        sum += data[i];
+    return sum;
+}
+
+// Counts the bits of a word by adding up ever wider fields, without relying on an instruction for it.
+static size_t popcountWord(uint64_t x)
+{
+    x -= x >> 1 & 0x5555555555555555u;
+    x = (x & 0x3333333333333333u) + (x >> 2 & 0x3333333333333333u);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0Fu;
+    return (size_t)(x * 0x0101010101010101u >> 56);
+}
+
+static size_t popcountScalar_u64(const uint64_t* data, size_t n)
+{
+    size_t count = 0;
+    for (size_t i = 0; i < n; ++i)
+        count += popcountWord(data[i]);
+    return count;
+}
+
+static size_t findNonzeroScalar_u64(const uint64_t* data, size_t n)
+{
+    size_t i = 0;
+    while (i < n && !data[i])
+        ++i;
+    return i;
+}
+
+#define AND_WORD(a, b) ((a) & (b))
+#define OR_WORD(a, b) ((a) | (b))
+#define XOR_WORD(a, b) ((a) ^ (b))
+#define AND_NOT_WORD(a, b) ((a) & ~(b))
+
+#define DEFINE_SCALAR_BITWISE(op, wordOp) \
+\
+static void op##Scalar_u64(uint64_t* dest, const uint64_t* src, size_t n) \
+{ \
+    for (size_t i = 0; i < n; ++i) \
+        dest[i] = wordOp(dest[i], src[i]); \
+}
+
+DEFINE_SCALAR_BITWISE(and, AND_WORD)
+DEFINE_SCALAR_BITWISE(or, OR_WORD)
+DEFINE_SCALAR_BITWISE(xor, XOR_WORD)
+DEFINE_SCALAR_BITWISE(andNot, AND_NOT_WORD)
+
+#if HAVE_X86
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Vector Kernels
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// The macros below are instantiated once per instruction set and element type. Each is given the vector type, the
+// number of lanes, and the intrinsics (or helper functions) that make up the kernel. `eqMask` compares two vectors and
+// returns a bit mask with one bit per lane.
+
+// Searching and counting process four vectors per iteration, so that memory rather than the loop overhead is the limit.
+#define DEFINE_FIND_COUNT(isa, target, type, suffix, vec, lanes, load, set1, eqMask) \
+\
+target static size_t find##isa##_##suffix(const type* data, size_t n, type value) \
+{ \
+    vec needle = set1(value); \
+    size_t i = 0; \
+    for (; i + 4 * (lanes) <= n; i += 4 * (lanes)) \
+    { \
+        unsigned mask = (unsigned)eqMask(load(data + i), needle) \
+            | (unsigned)eqMask(load(data + i + (lanes)), needle) << (lanes) \
+            | (unsigned)eqMask(load(data + i + 2 * (lanes)), needle) << 2 * (lanes) \
+            | (unsigned)eqMask(load(data + i + 3 * (lanes)), needle) << 3 * (lanes); \
+        if (mask) \
+            return i + __builtin_ctz(mask); \
+    } \
+    for (; i < n; ++i) \
+    { \
+        if (data[i] == value) \
+            return i; \
+    } \
+    return n; \
+} \
+\
+target static size_t count##isa##_##suffix(const type* data, size_t n, type value) \
+{ \
+    vec needle = set1(value); \
+    size_t count = 0, i = 0; \
+    for (; i + 4 * (lanes) <= n; i += 4 * (lanes)) \
+    { \
+        unsigned mask = (unsigned)eqMask(load(data + i), needle) \
+            | (unsigned)eqMask(load(data + i + (lanes)), needle) << (lanes) \
+            | (unsigned)eqMask(load(data + i + 2 * (lanes)), needle) << 2 * (lanes) \
+            | (unsigned)eqMask(load(data + i + 3 * (lanes)), needle) << 3 * (lanes); \
+        count += __builtin_popcount(mask); \
+    } \
+    for (; i < n; ++i) \
+        count += data[i] == value; \
+    return count; \
+}
+
+#define DEFINE_FILL(isa, target, type, suffix, vec, lanes, store, set1) \
+\
+target static void fill##isa##_##suffix(type* data, size_t n, type value) \
+{ \
+    vec v = set1(value); \
+    size_t i = 0; \
+    for (; i + (lanes) <= n; i += (lanes)) \
+        store(data + i, v); \
+    for (; i < n; ++i) \
+        data[i] = value; \
+}
+
+// Floating-point sums keep four independent accumulators to hide the latency of vector addition.
+#define DEFINE_FLOAT_SUM(isa, target, type, suffix, vec, lanes, load, store, zero, add) \
+\
+target static type sum##isa##_##suffix(const type* data, size_t n) \
+{ \
+    vec acc0 = zero(), acc1 = zero(), acc2 = zero(), acc3 = zero(); \
+    size_t i = 0; \
+    for (; i + 4 * (lanes) <= n; i += 4 * (lanes)) \
+    { \
+        acc0 = add(acc0, load(data + i)); \
+        acc1 = add(acc1, load(data + i + (lanes))); \
+        acc2 = add(acc2, load(data + i + 2 * (lanes))); \
+        acc3 = add(acc3, load(data + i + 3 * (lanes))); \
+    } \
+    type partial[lanes], sum = 0; \
+    store(partial, add(add(acc0, acc1), add(acc2, acc3))); \
+    for (size_t j = 0; j < (lanes); ++j) \
+        sum += partial[j]; \
+    for (; i < n; ++i) \
+        sum += data[i]; \
+    return sum; \
+}
+
+// Falls back to the scalar kernel for arrays shorter than a single vector.
+#define DEFINE_MIN_MAX(isa, target, type, suffix, vec, lanes, load, store, minOp, maxOp) \
+\
+target static type min##isa##_##suffix(const type* data, size_t n) \
+{ \
+    if (n < (lanes)) \
+        return minScalar_##suffix(data, n); \
+    vec acc = load(data); \
+    size_t i = (lanes); \
+    for (; i + (lanes) <= n; i += (lanes)) \
+        acc = minOp(acc, load(data + i)); \
+    type partial[lanes]; \
+    store(partial, acc); \
+    type result = minScalar_##suffix(partial, (lanes)); \
+    for (; i < n; ++i) \
+        result = data[i] < result ? data[i] : result; \
+    return result; \
+} \
+\
+target static type max##isa##_##suffix(const type* data, size_t n) \
+{ \
+    if (n < (lanes)) \
+        return maxScalar_##suffix(data, n); \
+    vec acc = load(data); \
+    size_t i = (lanes); \
+    for (; i + (lanes) <= n; i += (lanes)) \
+        acc = maxOp(acc, load(data + i)); \
+    type partial[lanes]; \
+    store(partial, acc); \
+    type result = maxScalar_##suffix(partial, (lanes)); \
+    for (; i < n; ++i) \
+        result = data[i] > result ? data[i] : result; \
+    return result; \
+}
+
+// Two vectors are combined per iteration, so that a load of one overlaps the store of the other.
+#define DEFINE_BITWISE(isa, target, op, vec, lanes, load, store, vecOp, wordOp) \
+\
+target static void op##isa##_u64(uint64_t* dest, const uint64_t* src, size_t n) \
+{ \
+    size_t i = 0; \
+    for (; i + 2 * (lanes) <= n; i += 2 * (lanes)) \
+    { \
+        vec a = vecOp(load(dest + i), load(src + i)); \
+        vec b = vecOp(load(dest + i + (lanes)), load(src + i + (lanes))); \
+        store(dest + i, a); \
+        store(dest + i + (lanes), b); \
+    } \
+    for (; i < n; ++i) \
+        dest[i] = wordOp(dest[i], src[i]); \
+}
+
+// SSE2
+
+#define NO_TARGET
+#define LOAD_SI128(p) _mm_loadu_si128((const __m128i*)(p))
+#define STORE_SI128(p, v) _mm_storeu_si128((__m128i*)(p), (v))
+#define EQ_MASK_EPI32(a, b) _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32((a), (b))))
+#define EQ_MASK_EPI64(a, b) _mm_movemask_pd(_mm_castsi128_pd(cmpeqEpi64Sse2((a), (b))))
+#define EQ_MASK_PS(a, b) _mm_movemask_ps(_mm_cmpeq_ps((a), (b)))
+#define EQ_MASK_PD(a, b) _mm_movemask_pd(_mm_cmpeq_pd((a), (b)))
+
+// SSE2 has no 64-bit equality comparison: two lanes are equal if both of their 32-bit halves are.
+static inline __m128i cmpeqEpi64Sse2(__m128i a, __m128i b)
+{
+    __m128i eq = _mm_cmpeq_epi32(a, b);
+    return _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+}
+
+// SSE2 has no 32-bit minimum or maximum, so they are built from a comparison and a bitwise select.
+static inline __m128i minEpi32Sse2(__m128i a, __m128i b)
+{
+    __m128i greater = _mm_cmpgt_epi32(a, b);
+    return _mm_or_si128(_mm_and_si128(greater, b), _mm_andnot_si128(greater, a));
+}
+
+static inline __m128i maxEpi32Sse2(__m128i a, __m128i b)
+{
+    __m128i greater = _mm_cmpgt_epi32(a, b);
+    return _mm_or_si128(_mm_and_si128(greater, a), _mm_andnot_si128(greater, b));
+}
+
+DEFINE_FIND_COUNT(Sse2, NO_TARGET, int32_t, i32, __m128i, 4, LOAD_SI128, _mm_set1_epi32, EQ_MASK_EPI32)
+DEFINE_FIND_COUNT(Sse2, NO_TARGET, int64_t, i64, __m128i, 2, LOAD_SI128, _mm_set1_epi64x, EQ_MASK_EPI64)
+DEFINE_FIND_COUNT(Sse2, NO_TARGET, float, f32, __m128, 4, _mm_loadu_ps, _mm_set1_ps, EQ_MASK_PS)
+DEFINE_FIND_COUNT(Sse2, NO_TARGET, double, f64, __m128d, 2, _mm_loadu_pd, _mm_set1_pd, EQ_MASK_PD)
+
+DEFINE_FILL(Sse2, NO_TARGET, int32_t, i32, __m128i, 4, STORE_SI128, _mm_set1_epi32)
+DEFINE_FILL(Sse2, NO_TARGET, int64_t, i64, __m128i, 2, STORE_SI128, _mm_set1_epi64x)
+DEFINE_FILL(Sse2, NO_TARGET, float, f32, __m128, 4, _mm_storeu_ps, _mm_set1_ps)
+DEFINE_FILL(Sse2, NO_TARGET, double, f64, __m128d, 2, _mm_storeu_pd, _mm_set1_pd)
+
+DEFINE_FLOAT_SUM(Sse2, NO_TARGET, float, f32, __m128, 4, _mm_loadu_ps, _mm_storeu_ps, _mm_setzero_ps, _mm_add_ps)
+DEFINE_FLOAT_SUM(Sse2, NO_TARGET, double, f64, __m128d, 2, _mm_loadu_pd, _mm_storeu_pd, _mm_setzero_pd, _mm_add_pd)
+
+DEFINE_MIN_MAX(Sse2, NO_TARGET, int32_t, i32, __m128i, 4, LOAD_SI128, STORE_SI128, minEpi32Sse2, maxEpi32Sse2)
+DEFINE_MIN_MAX(Sse2, NO_TARGET, float, f32, __m128, 4, _mm_loadu_ps, _mm_storeu_ps, _mm_min_ps, _mm_max_ps)
+DEFINE_MIN_MAX(Sse2, NO_TARGET, double, f64, __m128d, 2, _mm_loadu_pd, _mm_storeu_pd, _mm_min_pd, _mm_max_pd)
+
+// SSE2 has no 64-bit signed comparison, which would make a vectorized 64-bit minimum slower than the scalar one.
+#define minSse2_i64 minScalar_i64
+#define maxSse2_i64 maxScalar_i64
+
+// Sign-extends each 32-bit lane to 64 bits before adding, so that the sum does not overflow.
+static int64_t sumSse2_i32(const int32_t* data, size_t n)
+{
+    __m128i acc = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128i v = LOAD_SI128(data + i), sign = _mm_cmpgt_epi32(_mm_setzero_si128(), v);
+        acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(v, sign));
+        acc = _mm_add_epi64(acc, _mm_unpackhi_epi32(v, sign));
+    }
+    uint64_t partial[2];
+    STORE_SI128(partial, acc);
+    uint64_t sum = partial[0] + partial[1];
+    for (; i < n; ++i)
+        sum += (uint64_t)data[i];
+    return (int64_t)sum;
+}
+
+static int64_t sumSse2_i64(const int64_t* data, size_t n)
+{
+    __m128i acc0 = _mm_setzero_si128(), acc1 = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        acc0 = _mm_add_epi64(acc0, LOAD_SI128(data + i));
+        acc1 = _mm_add_epi64(acc1, LOAD_SI128(data + i + 2));
+    }
+    uint64_t partial[2];
+    STORE_SI128(partial, _mm_add_epi64(acc0, acc1));
+    uint64_t sum = partial[0] + partial[1];
+    for (; i < n; ++i)
+        sum += (uint64_t)data[i];
+    return (int64_t)sum;
+}
+
+// Converts each half of four floats to two doubles before adding, so that the sum keeps double precision.
+static double sumWideSse2_f32(const float* data, size_t n)
+{
+    __m128d acc0 = _mm_setzero_pd(), acc1 = _mm_setzero_pd(), acc2 = _mm_setzero_pd(), acc3 = _mm_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        __m128 v0 = _mm_loadu_ps(data + i), v1 = _mm_loadu_ps(data + i + 4);
+        acc0 = _mm_add_pd(acc0, _mm_cvtps_pd(v0));
+        acc1 = _mm_add_pd(acc1, _mm_cvtps_pd(_mm_movehl_ps(v0, v0)));
+        acc2 = _mm_add_pd(acc2, _mm_cvtps_pd(v1));
+        acc3 = _mm_add_pd(acc3, _mm_cvtps_pd(_mm_movehl_ps(v1, v1)));
+    }
+    double partial[2];
+    _mm_storeu_pd(partial, _mm_add_pd(_mm_add_pd(acc0, acc1), _mm_add_pd(acc2, acc3)));
+    double sum = partial[0] + partial[1];
+    for (; i < n; ++i)
+        sum += data[i];
+    return sum;
+}
+
+// The intrinsics compute `~a & b`, whereas the kernel computes `dest & ~src`.
+#define AND_NOT_SI128(a, b) _mm_andnot_si128((b), (a))
+
+DEFINE_BITWISE(Sse2, NO_TARGET, and, __m128i, 2, LOAD_SI128, STORE_SI128, _mm_and_si128, AND_WORD)
+DEFINE_BITWISE(Sse2, NO_TARGET, or, __m128i, 2, LOAD_SI128, STORE_SI128, _mm_or_si128, OR_WORD)
+DEFINE_BITWISE(Sse2, NO_TARGET, xor, __m128i, 2, LOAD_SI128, STORE_SI128, _mm_xor_si128, XOR_WORD)
+DEFINE_BITWISE(Sse2, NO_TARGET, andNot, __m128i, 2, LOAD_SI128, STORE_SI128, AND_NOT_SI128, AND_NOT_WORD)
+
+// SSE2 has no population count, so the bits of each byte are added up in parallel, as in `popcountWord`, and the
+// bytes are then summed by `_mm_sad_epu8`.
+static size_t popcountSse2_u64(const uint64_t* data, size_t n)
+{
+    const __m128i m1 = _mm_set1_epi8(0x55), m2 = _mm_set1_epi8(0x33), m4 = _mm_set1_epi8(0x0F);
+    __m128i acc = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2)
+    {
+        __m128i v = LOAD_SI128(data + i);
+        v = _mm_sub_epi8(v, _mm_and_si128(_mm_srli_epi64(v, 1), m1));
+        v = _mm_add_epi8(_mm_and_si128(v, m2), _mm_and_si128(_mm_srli_epi64(v, 2), m2));
+        v = _mm_and_si128(_mm_add_epi8(v, _mm_srli_epi64(v, 4)), m4);
+        acc = _mm_add_epi64(acc, _mm_sad_epu8(v, _mm_setzero_si128()));
+    }
+    uint64_t partial[2];
+    STORE_SI128(partial, acc);
+    size_t count = (size_t)(partial[0] + partial[1]);
+    for (; i < n; ++i)
+        count += popcountWord(data[i]);
+    return count;
+}
+
+static size_t findNonzeroSse2_u64(const uint64_t* data, size_t n)
+{
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        __m128i any = _mm_or_si128(_mm_or_si128(LOAD_SI128(data + i), LOAD_SI128(data + i + 2)),
+            _mm_or_si128(LOAD_SI128(data + i + 4), LOAD_SI128(data + i + 6)));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(any, _mm_setzero_si128())) != 0xFFFF)
+            break;
+    }
+    return i + findNonzeroScalar_u64(data + i, n - i);
+}
+
+// AVX2
+
+#define LOAD_SI256(p) _mm256_loadu_si256((const __m256i*)(p))
+#define STORE_SI256(p, v) _mm256_storeu_si256((__m256i*)(p), (v))
+#define EQ_MASK_EPI32_256(a, b) _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32((a), (b))))
+#define EQ_MASK_EPI64_256(a, b) _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64((a), (b))))
+#define EQ_MASK_PS_256(a, b) _mm256_movemask_ps(_mm256_cmp_ps((a), (b), _CMP_EQ_OQ))
+#define EQ_MASK_PD_256(a, b) _mm256_movemask_pd(_mm256_cmp_pd((a), (b), _CMP_EQ_OQ))
+
+AVX2_TARGET static inline __m256i minEpi64Avx2(__m256i a, __m256i b)
+{
+    return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b));
+}
+
+AVX2_TARGET static inline __m256i maxEpi64Avx2(__m256i a, __m256i b)
+{
+    return _mm256_blendv_epi8(b, a, _mm256_cmpgt_epi64(a, b));
+}
+
+DEFINE_FIND_COUNT(Avx2, AVX2_TARGET, int32_t, i32, __m256i, 8, LOAD_SI256, _mm256_set1_epi32, EQ_MASK_EPI32_256)
+DEFINE_FIND_COUNT(Avx2, AVX2_TARGET, int64_t, i64, __m256i, 4, LOAD_SI256, _mm256_set1_epi64x, EQ_MASK_EPI64_256)
+DEFINE_FIND_COUNT(Avx2, AVX2_TARGET, float, f32, __m256, 8, _mm256_loadu_ps, _mm256_set1_ps, EQ_MASK_PS_256)
+DEFINE_FIND_COUNT(Avx2, AVX2_TARGET, double, f64, __m256d, 4, _mm256_loadu_pd, _mm256_set1_pd, EQ_MASK_PD_256)
+
+DEFINE_FILL(Avx2, AVX2_TARGET, int32_t, i32, __m256i, 8, STORE_SI256, _mm256_set1_epi32)
+DEFINE_FILL(Avx2, AVX2_TARGET, int64_t, i64, __m256i, 4, STORE_SI256, _mm256_set1_epi64x)
+DEFINE_FILL(Avx2, AVX2_TARGET, float, f32, __m256, 8, _mm256_storeu_ps, _mm256_set1_ps)
+DEFINE_FILL(Avx2, AVX2_TARGET, double, f64, __m256d, 4, _mm256_storeu_pd, _mm256_set1_pd)
+
+DEFINE_FLOAT_SUM(Avx2, AVX2_TARGET, float, f32, __m256, 8, _mm256_loadu_ps, _mm256_storeu_ps, _mm256_setzero_ps,
+    _mm256_add_ps)
+DEFINE_FLOAT_SUM(Avx2, AVX2_TARGET, double, f64, __m256d, 4, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_setzero_pd,
+    _mm256_add_pd)
+
+DEFINE_MIN_MAX(Avx2, AVX2_TARGET, int32_t, i32, __m256i, 8, LOAD_SI256, STORE_SI256, _mm256_min_epi32,
+    _mm256_max_epi32)
+DEFINE_MIN_MAX(Avx2, AVX2_TARGET, int64_t, i64, __m256i, 4, LOAD_SI256, STORE_SI256, minEpi64Avx2, maxEpi64Avx2)
+DEFINE_MIN_MAX(Avx2, AVX2_TARGET, float, f32, __m256, 8, _mm256_loadu_ps, _mm256_storeu_ps, _mm256_min_ps,
+    _mm256_max_ps)
+DEFINE_MIN_MAX(Avx2, AVX2_TARGET, double, f64, __m256d, 4, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_min_pd,
+    _mm256_max_pd)
+
+AVX2_TARGET static int64_t sumAvx2_i32(const int32_t* data, size_t n)
+{
+    __m256i acc0 = _mm256_setzero_si256(), acc1 = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        acc0 = _mm256_add_epi64(acc0, _mm256_cvtepi32_epi64(LOAD_SI128(data + i)));
+        acc1 = _mm256_add_epi64(acc1, _mm256_cvtepi32_epi64(LOAD_SI128(data + i + 4)));
+    }
+    uint64_t partial[4];
+    STORE_SI256(partial, _mm256_add_epi64(acc0, acc1));
+    uint64_t sum = partial[0] + partial[1] + partial[2] + partial[3];
+    for (; i < n; ++i)
+        sum += (uint64_t)data[i];
+    return (int64_t)sum;
+}
+
+AVX2_TARGET static int64_t sumAvx2_i64(const int64_t* data, size_t n)
+{
+    __m256i acc0 = _mm256_setzero_si256(), acc1 = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        acc0 = _mm256_add_epi64(acc0, LOAD_SI256(data + i));
+        acc1 = _mm256_add_epi64(acc1, LOAD_SI256(data + i + 4));
+    }
+    uint64_t partial[4];
+    STORE_SI256(partial, _mm256_add_epi64(acc0, acc1));
+    uint64_t sum = partial[0] + partial[1] + partial[2] + partial[3];
+    for (; i < n; ++i)
+        sum += (uint64_t)data[i];
+    return (int64_t)sum;
+}
+
+AVX2_TARGET static double sumWideAvx2_f32(const float* data, size_t n)
+{
+    __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd(), acc2 = _mm256_setzero_pd(),
+        acc3 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        acc0 = _mm256_add_pd(acc0, _mm256_cvtps_pd(_mm_loadu_ps(data + i)));
+        acc1 = _mm256_add_pd(acc1, _mm256_cvtps_pd(_mm_loadu_ps(data + i + 4)));
+        acc2 = _mm256_add_pd(acc2, _mm256_cvtps_pd(_mm_loadu_ps(data + i + 8)));
+        acc3 = _mm256_add_pd(acc3, _mm256_cvtps_pd(_mm_loadu_ps(data + i + 12)));
+    }
+    double partial[4];
+    _mm256_storeu_pd(partial, _mm256_add_pd(_mm256_add_pd(acc0, acc1), _mm256_add_pd(acc2, acc3)));
+    double sum = partial[0] + partial[1] + partial[2] + partial[3];
+    for (; i < n; ++i)
+        sum += data[i];
+    return sum;
+}
+
+#define AND_NOT_SI256(a, b) _mm256_andnot_si256((b), (a))
+
+DEFINE_BITWISE(Avx2, AVX2_TARGET, and, __m256i, 4, LOAD_SI256, STORE_SI256, _mm256_and_si256, AND_WORD)
+DEFINE_BITWISE(Avx2, AVX2_TARGET, or, __m256i, 4, LOAD_SI256, STORE_SI256, _mm256_or_si256, OR_WORD)
+DEFINE_BITWISE(Avx2, AVX2_TARGET, xor, __m256i, 4, LOAD_SI256, STORE_SI256, _mm256_xor_si256, XOR_WORD)
+DEFINE_BITWISE(Avx2, AVX2_TARGET, andNot, __m256i, 4, LOAD_SI256, STORE_SI256, AND_NOT_SI256, AND_NOT_WORD)
+
+// Looks up the bit count of each nibble in a 16-entry table, which `_mm256_shuffle_epi8` does for 64 nibbles at once.
+AVX2_TARGET static inline __m256i popcountBytesAvx2(__m256i v)
+{
+    const __m256i table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low = _mm256_set1_epi8(0x0F);
+    __m256i lo = _mm256_and_si256(v, low), hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low);
+    return _mm256_add_epi8(_mm256_shuffle_epi8(table, lo), _mm256_shuffle_epi8(table, hi));
+}
+
+AVX2_TARGET static size_t popcountAvx2_u64(const uint64_t* data, size_t n)
+{
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        // Each byte count is at most 8, so the counts of two vectors can be added before they are widened.
+        __m256i bytes = _mm256_add_epi8(popcountBytesAvx2(LOAD_SI256(data + i)),
+            popcountBytesAvx2(LOAD_SI256(data + i + 4)));
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(bytes, _mm256_setzero_si256()));
+    }
+    uint64_t partial[4];
+    STORE_SI256(partial, acc);
+    size_t count = (size_t)(partial[0] + partial[1] + partial[2] + partial[3]);
+    for (; i < n; ++i)
+        count += (size_t)__builtin_popcountll(data[i]);
+    return count;
+}
+
+AVX2_TARGET static size_t findNonzeroAvx2_u64(const uint64_t* data, size_t n)
+{
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        __m256i any = _mm256_or_si256(_mm256_or_si256(LOAD_SI256(data + i), LOAD_SI256(data + i + 4)),
+            _mm256_or_si256(LOAD_SI256(data + i + 8), LOAD_SI256(data + i + 12)));
+        if (!_mm256_testz_si256(any, any))
+            break;
+    }
+    return i + findNonzeroScalar_u64(data + i, n - i);
+}
+
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Public Kernels
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool ctls_simd_equal(const void* a, const void* b, size_t size)
+{
+    return !memcmp(a, b, size);
+}
+
+#define DEFINE_PUBLIC_KERNELS(type, suffix, sumType) \
+\
+size_t ctls_simd_find_##suffix(const type* data, size_t n, type value) \
+{ \
+    DISPATCH(find, suffix, (data, n, value)) \
+} \
+\
+size_t ctls_simd_count_##suffix(const type* data, size_t n, type value) \
+{ \
+    DISPATCH(count, suffix, (data, n, value)) \
+} \
+\
+void ctls_simd_fill_##suffix(type* data, size_t n, type value) \
+{ \
+    DISPATCH_VOID(fill, suffix, (data, n, value)) \
+} \
+\
+sumType ctls_simd_sum_##suffix(const type* data, size_t n) \
+{ \
+    DISPATCH(sum, suffix, (data, n)) \
+} \
+\
+type ctls_simd_min_##suffix(const type* data, size_t n) \
+{ \
+    DISPATCH(min, suffix, (data, n)) \
+} \
+\
+type ctls_simd_max_##suffix(const type* data, size_t n) \
+{ \
+    DISPATCH(max, suffix, (data, n)) \
+}
+
+DEFINE_PUBLIC_KERNELS(int32_t, i32, int64_t)
+DEFINE_PUBLIC_KERNELS(int64_t, i64, int64_t)
+DEFINE_PUBLIC_KERNELS(float, f32, float)
+DEFINE_PUBLIC_KERNELS(double, f64, double)
+
+double ctls_simd_sumWide_f32(const float* data, size_t n)
+{
+    DISPATCH(sumWide, f32, (data, n))
+}
+
+size_t ctls_simd_popcount_u64(const uint64_t* data, size_t n)
+{
+    DISPATCH(popcount, u64, (data, n))
+}
+
+size_t ctls_simd_findNonzero_u64(const uint64_t* data, size_t n)
+{
+    DISPATCH(findNonzero, u64, (data, n))
+}
+
+void ctls_simd_and_u64(uint64_t* dest, const uint64_t* src, size_t n)
+{
+    DISPATCH_VOID(and, u64, (dest, src, n))
+}
+
+void ctls_simd_or_u64(uint64_t* dest, const uint64_t* src, size_t n)
+{
+    DISPATCH_VOID(or, u64, (dest, src, n))
+}
+
+void ctls_simd_xor_u64(uint64_t* dest, const uint64_t* src, size_t n)
+{
+    DISPATCH_VOID(xor, u64, (dest, src, n))
+}
+
+void ctls_simd_andNot_u64(uint64_t* dest, const uint64_t* src, size_t n)
+{
+    DISPATCH_VOID(andNot, u64, (dest, src, n))
+}